@@ -0,0 +1,460 @@
+//***********************************************************************************************************
+/** @file bench_main.cpp
+ *    This file contains a benchmark program which measures how many processor cycles the control code uses.
+ *    It's built with 'make bench' and is meant to be run in the simavr simulator with 'make bench-sim',
+ *    though it runs just as well on the real board. The RTOS scheduler is never started; instead each piece
+ *    of the control hot path is called many times while timer 1 counts processor cycles, and the smallest,
+ *    largest and mean number of cycles per call are printed as a table on serial port 0. When the table has
+ *    been printed the processor is put to sleep with interrupts off, which makes simavr exit.
+ *
+ *    The functions measured are \c pid::compute(), the \c satmath functions, \c routes::servo_power(),
+ *    \c encoder_snapshot::update(), the INT4 and INT6 encoder interrupt service routines, one- and two-byte
+ *    \c TaskShare reads and writes, \c SharedBlock writes and snapshots, the sharing of a 30 byte record by
+ *    \c TaskShare and by \c TripleBuffer, the conversion of numbers to decimal text by \c ultoa(), \c utoa()
+ *    and \c utoa_dec(), and \c task_control::step(), the body of the control task's loop. One period of the
+ *    control task is 10 ms, or 160,000 cycles at 16 MHz.
+ *
+ *  Revisions:
+ *    @li 10-17-2026 ME405 Group 3 original file
+ *    @li 10-17-2026 ME405 Group 3 The print queue is a stream buffer, as in main.cpp
+ *    @li 10-17-2026 ME405 Group 3 Added decimal conversion by division and by subtraction
+ *    @li 10-17-2026 ME405 Group 3 The serial port's transmit buffer is emptied before sleeping
+ */
+//***********************************************************************************************************
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+#include <avr/io.h>                         // Port I/O for SFR's
+#include <avr/interrupt.h>                  // Interrupt enable and disable
+#include <avr/sleep.h>                      // Sleep mode, used to stop the simulator
+#include <avr/wdt.h>                        // Watchdog timer header
+
+#include "FreeRTOS.h"                       // Primary header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS task functions
+#include "queue.h"                          // FreeRTOS inter-task communication queues
+
+#include "rs232int.h"                       // ME405/507 library for serial comm.
+#include "taskbase.h"                       // Header of wrapper for FreeRTOS tasks
+#include "streambuffer.h"                   // Text queue which moves characters in blocks
+#include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
+#include "taskshare.h"                      // Header for thread-safe shared data
+#include "shares.h"                         // Global ('extern') queue declarations
+
+#include "pid.h"                            // The PID controller being measured
+#include "pid_fixed.h"                      // PID controller with gains fixed at compile time
+#include "pid_bank.h"                       // Bank of PID controllers updated together
+#include "satmath.h"                        // Saturated math library
+#include "routes.h"                         // Route conversion functions
+#include "encoder_snapshot.h"               // Encoder position and speed snapshots
+#include "triplebuffer.h"                   // Triple buffered share for large records
+#include "task_control.h"                   // Control task, whose loop body is measured
+
+
+/// A record the size of a full frame of IMU data, used to time the sharing of large records
+struct bench_frame_t
+{
+	int16_t values[15];			///< Accelerations, rates, angles and so on
+};
+
+/// The number of times each function is called while it's being measured
+const uint16_t BENCH_CALLS = 256;
+
+/// The number of processor cycles in one 10 ms period of the control task
+const uint32_t CYCLES_PER_PERIOD = F_CPU / 100;
+
+/// This is the print queue, as in \c main.cpp
+StreamBuffer* p_print_ser_queue;
+
+// Shared variables; see main.cpp for descriptions
+EventGroupHandle_t ev_tasks;
+NotifyShare<int8_t>* sh_power_set_flag;
+NotifyShare<int8_t>* sh_braking_full_flag;
+TaskShare<int32_t>* sh_encoder_position_1;
+TaskShare<int32_t>* sh_encoder_position_2;
+TaskShare<time_stamp>* sh_encoder_edge_time_1;
+TaskShare<time_stamp>* sh_encoder_edge_time_2;
+TaskShare<uint16_t>* sh_encoder_error_count_1;
+TaskShare<uint16_t>* sh_encoder_error_count_2;
+SharedBlock<motor_block_t>* sh_motors;
+SharedBlock<route_block_t>* sh_route;
+SharedBlock<imu_block_t>* sh_imu;
+TaskShare<uint16_t>* sh_servo_setpoint;
+SharedBlock<latency_block_t>* sh_latency;
+
+// The encoder interrupt service routines are called directly, as ordinary functions
+extern "C" void INT4_vect (void);
+extern "C" void INT6_vect (void);
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** @brief   This class holds the cycle counts measured for one function.
+ *  @details Each call is timed with timer 1, which counts processor cycles when it runs with no prescaler.
+ *	     The cycles taken to read the timer twice are measured once at startup and subtracted from each
+ *	     measurement, so the counts are those of the code between the two readings.
+ */
+
+class cycle_count
+{
+protected:
+	uint16_t min;				///< The smallest number of cycles measured
+	uint16_t max;				///< The largest number of cycles measured
+	uint32_t total;				///< The sum of all the cycle counts measured
+	uint16_t calls;				///< How many calls have been measured
+
+public:
+	/// The number of cycles taken by an empty measurement
+	static uint16_t overhead;
+
+	/// The constructor makes an empty set of measurements.
+	cycle_count (void) : min (UINT16_MAX), max (0), total (0), calls (0) { }
+
+	/** This method adds one measurement, made by reading timer 1 before and after the code being timed.
+	 *  @param start The timer count read before the code ran
+	 *  @param stop The timer count read after the code ran
+	 */
+	void add (uint16_t start, uint16_t stop)
+	{
+		uint16_t cycles = stop - start - overhead;
+		if (cycles < min) min = cycles;
+		if (cycles > max) max = cycles;
+		total += cycles;
+		calls++;
+	}
+
+	/// This method returns the mean number of cycles per call.
+	uint16_t mean (void) { return (calls ? total / calls : 0); }
+
+	/** This method prints one row of the results table.
+	 *  @param p_ser The serial device on which to print
+	 *  @param p_name The name of the function measured, in program memory
+	 */
+	void print (emstream* p_ser, const char* p_name)
+	{
+		*p_ser << _p_str << p_name << '\t' << calls << '\t' << min << '\t' << max << '\t' << mean ()
+		       << '\t' << (uint16_t)(((uint32_t)mean () * 1000UL) / (CYCLES_PER_PERIOD / 10))
+		       << endl;
+	}
+};
+
+uint16_t cycle_count::overhead = 0;
+
+
+/** This macro times one run of the given code and adds the result to a @c cycle_count. The empty assembly
+ *  statements keep the compiler from moving the code being timed outside of the timer readings.
+ */
+#define BENCH_TIME(result, code)					\
+	do {								\
+		uint16_t _bench_start = TCNT1;				\
+		asm volatile ("" ::: "memory");				\
+		code;							\
+		asm volatile ("" ::: "memory");				\
+		uint16_t _bench_stop = TCNT1;				\
+		(result).add (_bench_start, _bench_stop);		\
+	} while (0)
+
+
+/// Inputs are made by a simple pseudo-random generator so that every call takes a typical path.
+static uint16_t bench_seed = 12345;
+
+/// Results are written here so that the compiler can't optimize away the calls being timed
+volatile int32_t bench_sink;
+
+/** This function returns the next number from a linear congruential pseudo-random generator.
+ *  @return A pseudo-random 16-bit number
+ */
+static int16_t bench_random (void)
+{
+	bench_seed = bench_seed * 25173U + 13849U;
+	return (int16_t)bench_seed;
+}
+
+
+//===========================================================================================================
+/** The main function creates the shares and the control task, but doesn't start the scheduler. It sets up
+ *  timer 1 to count processor cycles, times each function in turn, prints the table, and then stops.
+ *  @return This function never returns
+ */
+
+int main (void)
+{
+	// Disable the watchdog timer unless it's needed later; interrupts stay off while timing
+	MCUSR = 0;
+	wdt_disable ();
+	cli ();
+
+	// Configure a serial port which can be used by the benchmark to print its results
+	rs232* p_ser_port = new rs232 (9600, 0);
+
+	// Create the shares which the control task and encoder interrupts use, as main.cpp does
+	p_print_ser_queue = new StreamBuffer (32, "Print", p_ser_port, 10);
+	ev_tasks = xEventGroupCreate ();
+	sh_power_set_flag = new NotifyShare<int8_t> ("sh_power_set_flag", ev_tasks, EV_POWER_SET);
+	sh_braking_full_flag = new NotifyShare<int8_t> ("sh_braking_full_flag", ev_tasks, EV_BRAKING_FULL);
+	sh_encoder_position_1 = new TaskShare<int32_t> ("sh_encoder_position_1");
+	sh_encoder_position_2 = new TaskShare<int32_t> ("sh_encoder_position_2");
+	sh_encoder_edge_time_1 = new TaskShare<time_stamp> ("sh_encoder_edge_time_1");
+	sh_encoder_edge_time_2 = new TaskShare<time_stamp> ("sh_encoder_edge_time_2");
+	sh_encoder_error_count_1 = new TaskShare<uint16_t> ("sh_encoder_error_count_1");
+	sh_encoder_error_count_2 = new TaskShare<uint16_t> ("sh_encoder_error_count_2");
+	sh_motors = new SharedBlock<motor_block_t> ("sh_motors");
+	sh_route = new SharedBlock<route_block_t> ("sh_route");
+	sh_imu = new SharedBlock<imu_block_t> ("sh_imu");
+	sh_servo_setpoint = new TaskShare<uint16_t> ("sh_servo_setpoint");
+	sh_latency = new SharedBlock<latency_block_t> ("sh_latency");
+
+	// Timer 1 runs in normal mode with no prescaler, so it counts processor cycles
+	TCCR1A = 0;
+	TCCR1B = (1 << CS10);
+
+	// Find the cost of an empty measurement, which is subtracted from all the others
+	cycle_count empty;
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		BENCH_TIME (empty, );
+	}
+	cycle_count::overhead = empty.mean ();
+
+	// Saturated math functions, with pseudo-random arguments
+	cycle_count t_add, t_sub, t_abs, t_mul, t_div, t_shr;
+	cycle_count t_add_c, t_sub_c, t_abs_c;
+	cycle_count t_add32, t_sub32, t_shrv;
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t x = bench_random ();
+		int16_t y = bench_random ();
+		int32_t z = (int32_t)x * y;
+		int32_t w = (int32_t)((uint32_t)(uint16_t)bench_random () << 16 | (uint16_t)bench_random ());
+		BENCH_TIME (t_add, bench_sink = ssadd (x, y));
+		BENCH_TIME (t_sub, bench_sink = sssub (x, y));
+		BENCH_TIME (t_abs, bench_sink = ssabs (x));
+		BENCH_TIME (t_mul, bench_sink = ssmul (x, y));
+		BENCH_TIME (t_div, bench_sink = ssdiv (z, 1024));
+		BENCH_TIME (t_shr, bench_sink = ssshr (z, 10));
+		BENCH_TIME (t_add32, bench_sink = ssadd32 (z, w));
+		BENCH_TIME (t_sub32, bench_sink = sssub32 (z, w));
+		BENCH_TIME (t_shrv, bench_sink = ssshrv (w, 16));
+		BENCH_TIME (t_add_c, bench_sink = satmath::portable::signed_saturated_add (x, y));
+		BENCH_TIME (t_sub_c, bench_sink = satmath::portable::signed_saturated_sub (x, y));
+		BENCH_TIME (t_abs_c, bench_sink = satmath::portable::saturated_abs (x));
+	}
+
+	// A PI controller set up as in the control task, with speeds and setpoints in the range used there
+	cycle_count t_pid;
+	pid* p_pid = new pid (p_ser_port);
+	p_pid->set_config (pid::config_t{pid::PI, 1024, 256, 0, 256, -1600, 1600, 0});
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t speed = bench_random () % 100;
+		int16_t setpoint = bench_random () % 80;
+		BENCH_TIME (t_pid, bench_sink = p_pid->compute (speed, setpoint));
+	}
+
+	// The same controller with the 32-bit integrator and its integral gain given 6 more fraction bits
+	cycle_count t_pid32;
+	p_pid->set_config (pid::config_t{pid::PI, 1024, 256 << 6, 0, 256, -1600, 1600, 6});
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t speed = bench_random () % 100;
+		int16_t setpoint = bench_random () % 80;
+		BENCH_TIME (t_pid32, bench_sink = p_pid->compute (speed, setpoint));
+	}
+
+	// The same controller with its mode and gains fixed at compile time, as the control task uses it
+	cycle_count t_pid_fixed;
+	pid_fixed<pid::PI, 1024, 256, 0, 256> fixed_pid (-1600, 1600);
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t speed = bench_random () % 100;
+		int16_t setpoint = bench_random () % 80;
+		BENCH_TIME (t_pid_fixed, bench_sink = fixed_pid.compute (speed, setpoint));
+	}
+
+	// Both motors' controllers updated together by a bank, as the control task uses them
+	cycle_count t_pid_bank;
+	pid_bank<2, pid::PI, 1024, 256, 0, 256> bank_pids (-1600, 1600);
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t speeds[2] = { (int16_t)(bench_random () % 100), (int16_t)(bench_random () % 100) };
+		int16_t setpoints[2] = { (int16_t)(bench_random () % 80), (int16_t)(bench_random () % 80) };
+		BENCH_TIME (t_pid_bank, bank_pids.compute (speeds, setpoints));
+	}
+
+	// Encoder speed estimation, with the encoder moving 0 to 3 ticks per call; calls which see no edge read
+	// the time to limit the speed, so they're timed separately
+	cycle_count t_snap_moving, t_snap_stopped;
+	encoder_snapshot bench_encoder (sh_encoder_position_2, sh_encoder_edge_time_2);
+	time_stamp bench_edge_time;
+	sh_encoder_position_2->put (0);
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		uint8_t ticks = bench_random () & 0x03;
+		if (ticks)
+		{
+			sh_encoder_position_2->put (sh_encoder_position_2->get () + ticks);
+			bench_edge_time = time_stamp (count, bench_random () & 0x03FF);
+			sh_encoder_edge_time_2->put (bench_edge_time);
+			BENCH_TIME (t_snap_moving, bench_encoder.update ());
+		}
+		else
+		{
+			BENCH_TIME (t_snap_stopped, bench_encoder.update ());
+		}
+	}
+
+	// Conversion from steering angle to servo setpoint, including angles which saturate
+	cycle_count t_servo;
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t angle = bench_random () % 40;
+		BENCH_TIME (t_servo, bench_sink = routes::servo_power (angle));
+	}
+
+	// The encoder interrupts are fed a quadrature sequence on the encoder pins, which are made outputs so
+	// that PINE reads back what's written to PORTE
+	cycle_count t_int4, t_int6;
+	const uint8_t quadrature[] = { 0b00, 0b10, 0b11, 0b01 };
+	DDRE |= 0b11110000;
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		uint8_t phase = quadrature[count & 0x03];
+		PORTE = (PORTE & 0b00001111) | (phase << 4) | (phase << 6);
+		BENCH_TIME (t_int4, INT4_vect ());
+		cli ();
+		BENCH_TIME (t_int6, INT6_vect ());
+		cli ();
+	}
+	DDRE &= 0b00001111;
+
+	// Shares of one byte are copied without a critical section; two-byte shares still use one
+	cycle_count t_share8_put, t_share8_get, t_share16_put, t_share16_get;
+	TaskShare<uint8_t>* p_share8 = new TaskShare<uint8_t> ("bench_share8");
+	TaskShare<int16_t>* p_share16 = new TaskShare<int16_t> ("bench_share16");
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t x = bench_random ();
+		BENCH_TIME (t_share8_put, p_share8->put ((uint8_t)x));
+		BENCH_TIME (t_share8_get, bench_sink = p_share8->get ());
+		BENCH_TIME (t_share16_put, p_share16->put (x));
+		BENCH_TIME (t_share16_get, bench_sink = p_share16->get ());
+	}
+
+	// The motor block is written a few fields at a time and read whole, as the tasks use it
+	cycle_count t_block_write, t_block_get;
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t x = bench_random ();
+		BENCH_TIME (t_block_write,
+			    motor_block_t& motors = sh_motors->begin_write ();
+			    motors.speed[0] = x;
+			    motors.speed[1] = -x;
+			    sh_motors->end_write ());
+		BENCH_TIME (t_block_get, bench_sink = sh_motors->get ().speed[1]);
+	}
+
+	// A 30 byte record shared through a TaskShare is copied with interrupts off; a triple buffer only swaps
+	// indices with interrupts off, and its reader uses the record where it lies
+	cycle_count t_frame_put, t_triple_publish, t_triple_get;
+	TaskShare<bench_frame_t>* p_frame_share = new TaskShare<bench_frame_t> ("bench_frames");
+	TripleBuffer<bench_frame_t>* p_frame_buffer = new TripleBuffer<bench_frame_t> ("bench_triple");
+	bench_frame_t frame;
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		for (uint8_t index = 0; index < 15; index++)
+		{
+			frame.values[index] = bench_random ();
+		}
+		BENCH_TIME (t_frame_put, p_frame_share->put (frame));
+		p_frame_buffer->back () = frame;
+		BENCH_TIME (t_triple_publish, p_frame_buffer->publish ());
+		BENCH_TIME (t_triple_get, bench_sink = p_frame_buffer->get ().values[count % 15]);
+	}
+
+	// Decimal conversion; the C library divides by ten for each digit, utoa_dec() subtracts powers of ten.
+	// 32-bit numbers are made from two random numbers so that they have up to ten digits
+	cycle_count t_ultoa, t_utoa_dec32, t_utoa, t_utoa_dec16;
+	char bench_digits[11];
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		uint32_t big = ((uint32_t)(uint16_t)bench_random () << 16) | (uint16_t)bench_random ();
+		uint16_t small = (uint16_t)bench_random ();
+		BENCH_TIME (t_ultoa, ultoa (big, bench_digits, 10));
+		BENCH_TIME (t_utoa_dec32, bench_sink = utoa_dec (big, bench_digits));
+		BENCH_TIME (t_utoa, utoa (small, bench_digits, 10));
+		BENCH_TIME (t_utoa_dec16, bench_sink = utoa_dec (small, bench_digits));
+	}
+
+	// The body of the control task's loop, running a linear route as the user interface would start it
+	cycle_count t_step;
+	task_control* p_control = new task_control ("Control", p_ser_port);
+	p_control->setup ();
+	route_block_t& route = sh_route->begin_write ();
+	route.velocity = 40;
+	route.distance = 60;
+	route.heading_setpoint = 0;
+	route.linear_start = 1;
+	route.mode = 1;
+	sh_route->end_write ();
+	for (uint16_t count = 0; count < BENCH_CALLS; count++)
+	{
+		int16_t speed = 38 + (bench_random () & 0x03);
+		motor_block_t& motors = sh_motors->begin_write ();
+		motors.speed[0] = speed << encoder_snapshot::VELOCITY_Q;
+		motors.speed[1] = (38 + (bench_random () & 0x03)) << encoder_snapshot::VELOCITY_Q;
+		sh_motors->end_write ();
+		sh_encoder_position_1->put (sh_encoder_position_1->get () + speed);
+		sh_imu->begin_write ().heading = bench_random () % 100;
+		sh_imu->end_write ();
+		BENCH_TIME (t_step, p_control->step ());
+	}
+
+	// Print the results table
+	*p_ser_port << endl << PMS ("Cycle counts at ") << (uint32_t)(F_CPU / 1000000UL)
+		    << PMS (" MHz; overhead of ") << cycle_count::overhead << PMS (" cycles removed") << endl;
+	*p_ser_port << PMS ("Function\t\tCalls\tMin\tMax\tMean\t0.1% of 10 ms") << endl;
+	t_add.print (p_ser_port, PSTR ("ssadd\t\t"));
+	t_add_c.print (p_ser_port, PSTR ("ssadd portable\t"));
+	t_sub.print (p_ser_port, PSTR ("sssub\t\t"));
+	t_sub_c.print (p_ser_port, PSTR ("sssub portable\t"));
+	t_abs.print (p_ser_port, PSTR ("ssabs\t\t"));
+	t_abs_c.print (p_ser_port, PSTR ("ssabs portable\t"));
+	t_mul.print (p_ser_port, PSTR ("ssmul\t\t"));
+	t_div.print (p_ser_port, PSTR ("ssdiv\t\t"));
+	t_shr.print (p_ser_port, PSTR ("ssshr Q10\t"));
+	t_add32.print (p_ser_port, PSTR ("ssadd32\t\t"));
+	t_sub32.print (p_ser_port, PSTR ("sssub32\t\t"));
+	t_shrv.print (p_ser_port, PSTR ("ssshrv 16\t"));
+	t_pid.print (p_ser_port, PSTR ("pid::compute PI\t"));
+	t_pid32.print (p_ser_port, PSTR ("pid::compute PI 32"));
+	t_pid_fixed.print (p_ser_port, PSTR ("pid_fixed PI\t"));
+	t_pid_bank.print (p_ser_port, PSTR ("pid_bank<2> PI\t"));
+	t_snap_moving.print (p_ser_port, PSTR ("encoder_snapshot edge"));
+	t_snap_stopped.print (p_ser_port, PSTR ("encoder_snapshot no edge"));
+	t_servo.print (p_ser_port, PSTR ("routes::servo_power"));
+	t_int4.print (p_ser_port, PSTR ("ISR INT4\t"));
+	t_int6.print (p_ser_port, PSTR ("ISR INT6\t"));
+	t_share8_put.print (p_ser_port, PSTR ("TaskShare<uint8_t> put"));
+	t_share8_get.print (p_ser_port, PSTR ("TaskShare<uint8_t> get"));
+	t_share16_put.print (p_ser_port, PSTR ("TaskShare<int16_t> put"));
+	t_share16_get.print (p_ser_port, PSTR ("TaskShare<int16_t> get"));
+	t_block_write.print (p_ser_port, PSTR ("SharedBlock write 2"));
+	t_block_get.print (p_ser_port, PSTR ("SharedBlock get\t"));
+	t_frame_put.print (p_ser_port, PSTR ("TaskShare<30 B> put"));
+	t_triple_publish.print (p_ser_port, PSTR ("TripleBuffer publish"));
+	t_triple_get.print (p_ser_port, PSTR ("TripleBuffer get"));
+	t_ultoa.print (p_ser_port, PSTR ("ultoa 32 bits\t"));
+	t_utoa_dec32.print (p_ser_port, PSTR ("utoa_dec 32 bits"));
+	t_utoa.print (p_ser_port, PSTR ("utoa 16 bits\t"));
+	t_utoa_dec16.print (p_ser_port, PSTR ("utoa_dec 16 bits"));
+	t_step.print (p_ser_port, PSTR ("task_control::step"));
+	*p_ser_port << PMS ("Benchmark done") << endl;
+
+	// Interrupts are off, so the end of the table is still in the port's transmit buffer until it's sent
+	p_ser_port->transmit_now ();
+
+	// Sleeping with interrupts off never ends; simavr takes it as the end of the program
+	set_sleep_mode (SLEEP_MODE_PWR_DOWN);
+	cli ();
+	sleep_enable ();
+	sleep_cpu ();
+
+	for (;;);
+}
@@ -1,11 +1,15 @@
 //***********************************************************************************************************
 /** @file encoder_drv.cpp
  *    This file contains interrupt service routines appropriate to a specific motor. Also shares pertinent
- *    encoder data with task_encoder.cpp, including direction, encoder states, count, and error count.
+ *    encoder data with task_encoder.cpp, including the encoder position and error count.
  * 
  *  Revisions:
  *    @li April 13, 2016 -- BKK ME405 Group 3 original file
  *    @li April 28, 2016 -- BKK Added interrupt enable for ch 6 & 7, interrupts for ch 4 -> 7
+ *    @li 10-17-2026 ME405 Group 3 Interrupts decode the encoders with a lookup table and keep their own state
+ *    @li 10-17-2026 ME405 Group 3 Encoder counts are now 32-bit positions
+ *    @li 10-17-2026 ME405 Group 3 Each valid edge is time stamped for velocity estimation
+ *    @li 10-17-2026 ME405 Group 3 Encoder interrupts are recorded in the trace buffer as ISRs 4 and 6
  *
  */
 //***********************************************************************************************************
@@ -18,8 +22,38 @@
 #include "taskshare.h"			    // Header for thread-safe shared data
 #include "shares.h"                         // Shared inter-task communications
 
+#include "time_stamp.h"                     // Header for high resolution time stamps
 #include "encoder_drv.h"                    // Header for this task
 
+
+/** \brief This table gives the change in encoder count for each pair of old and new encoder states
+ *  \details The table is indexed by the old state (A:B) times four plus the new state. A move to the next
+ *	     state in the clockwise sequence 0b00 -> 0b10 -> 0b11 -> 0b01 -> 0b00 counts up and a move to the
+ *	     previous state counts down. Zero means no valid move: the state is the same, or both channels
+ *	     changed at once because a tick was skipped. These are counted as errors.
+ */
+static const int8_t quadrature_delta[16] =
+{
+     //  new:  00   01   10   11
+	       0,  -1,  +1,   0,			// old 00
+	      +1,   0,   0,  -1,			// old 01
+	      -1,   0,   0,  +1,			// old 10
+	       0,  +1,  -1,   0				// old 11
+};
+
+/// Motor 1's encoder states, kept by the INT4 interrupt: the old state in bits 2-3, the new one in bits 0-1
+static uint8_t encoder_state_1 = 0;
+
+/// Motor 2's encoder states, kept by the INT6 interrupt: the old state in bits 2-3, the new one in bits 0-1
+static uint8_t encoder_state_2 = 0;
+
+/// Motor 1's encoder position, kept by the INT4 interrupt and copied to @c sh_encoder_position_1
+static int32_t encoder_position_1 = 0;
+
+/// Motor 2's encoder position, kept by the INT6 interrupt and copied to @c sh_encoder_position_2
+static int32_t encoder_position_2 = 0;
+
+
 //-----------------------------------------------------------------------------------------------------------
 /** \brief This constructor enables global external interrupts on channels E4->E7 and masks them 
  * 	   appropriately to trigger an interrupt for any logical change.
@@ -30,14 +64,14 @@
 
 encoder_drv::encoder_drv(emstream* p_serial_port, uint8_t interrupt_ch)
 {
-      sh_encoder_count_1->put(0);		// Clears motor 1 encoder count
-      sh_encoder_count_2->put(0);		// Clears motor 2 encoder count
-      
-      sh_encoder_old_state_1->put(0);		// Clears motor 1 encoder old state
-      sh_encoder_new_state_1->put(0);		// Clears motor 1 encoder new state
-     
-      sh_encoder_old_state_2->put(0);		// Clears motor 2 encoder old state
-      sh_encoder_new_state_2->put(0);		// Clears motor 2 encoder old state
+      // The encoder interrupts aren't enabled yet, so their variables can be changed here
+      encoder_position_1 = 0;
+      encoder_position_2 = 0;
+      encoder_state_1 = 0;
+      encoder_state_2 = 0;
+
+      sh_encoder_position_1->put(0);		// Clears motor 1 encoder position
+      sh_encoder_position_2->put(0);		// Clears motor 2 encoder position
       
      // For external interrupt channels 4->7, trigger for "Any logical change on INTn generates
      // an interrupt request."
@@ -72,139 +106,73 @@ encoder_drv::encoder_drv(emstream* p_serial_port, uint8_t interrupt_ch)
 
 
 //-----------------------------------------------------------------------------------------------------------
-/** \brief   This method finds the difference between the encoder readings (in ticks) and returns that 
- * 	     difference.
- *  @param old_count Old encoder count reading
- *  @param new_count New encoder count reading
- */
-
-uint32_t encoder_drv::calc_motor (uint16_t old_count, uint16_t new_count)
-{
-     return (new_count - old_count); 	// ticks
-}
-
-
-//-----------------------------------------------------------------------------------------------------------
-/** \brief This interrupt service routine determines the new encoder state, direction, increments or
- *	   decrements encoder count, and flags encoder sequence errors with the error count.
- *  \details Specifically, compare the new state to the previous state and based on the physical quadrature
- *	     of the encoder disk, determines relevant encoder direction and recognizes errors: tick skipping.
- *	     This ISR will be used for channel 4 & 5.
+/** \brief This interrupt service routine reads motor 1's encoder, updates its count, and counts encoder
+ *	   sequence errors.
+ *  \details The new state of channels A and B is shifted in beside the old one, and the pair looks up the
+ *	     change in count in @c quadrature_delta. The state and position are kept in this file's own
+ *	     variables, so the only shared data written is the new position and the time of the edge,
+ *	     which @c encoder_snapshot uses to find the velocity, or the error count when a tick was
+ *	     skipped. This ISR will be used for channel 4 & 5.
  *  @param INT4_vect Interrupt vector for pin E4 (External interrupt)
  */
 
 ISR (INT4_vect)
 {
-      // Saves old state of motor 2 (channels A and B)
-      sh_encoder_old_state_1 -> put(sh_encoder_new_state_1->get());
-      
-      // Stores new state of motor 2 (channels A and B)
-      sh_encoder_new_state_1 -> put(((PINE & _BV(PINE4)) | (PINE & _BV(PINE5))) >> 4);
-   
-// Compare motor 2 encoder state and determine direction, Yellow = A, 4, White = B, 5
-// CW  direction (A:B) = -> 0b00 -> 0b10 -> 0b11 -> 0b01 ->
-// CCW direction (A:B) = -> 0b01 -> 0b11 -> 0b10 -> 0b00 ->
-      switch(sh_encoder_old_state_1->ISR_get())
+      traceISR_ENTER (4);
+
+      // Yellow = A, pin E4, White = B, pin E5
+      encoder_state_1 = ((encoder_state_1 << 2) | ((PINE >> PINE4) & 0b11)) & 0x0F;
+      int8_t delta = quadrature_delta[encoder_state_1];
+      time_stamp edge_time;
+
+      if (delta)
+      {
+	  encoder_position_1 += delta;
+	  sh_encoder_position_1->ISR_put(encoder_position_1);
+	  edge_time.set_to_now_in_ISR();
+	  sh_encoder_edge_time_1->ISR_put(edge_time);
+      }
+      else						// If no valid move, increment error count
       {
-	case(0b00):
-	  if(sh_encoder_new_state_1->ISR_get() == 0b10)		// If next state increment
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->ISR_get() + 1);
-	  else if(sh_encoder_new_state_1->ISR_get() == 0b01)	// If previous state decrement
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->get() - 1);
-	  else							// If neither, increment error count
-	      sh_encoder_error_count_1->ISR_put(sh_encoder_error_count_1->ISR_get() + 1);
-	  break;
-	  
-	case(0b10):
-	  if(sh_encoder_new_state_1->ISR_get() == 0b11)		// If next state increment
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->ISR_get() + 1);
-	  else if(sh_encoder_new_state_1->ISR_get() == 0b00)	// If previous state decrement
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->get() - 1);
-	  else							// If neither, increment error count
-	      sh_encoder_error_count_1->ISR_put(sh_encoder_error_count_1->ISR_get() + 1);
-	  break;
-
-	case(0b11):
-	  if(sh_encoder_new_state_1->ISR_get() == 0b01)		// If next state increment
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->ISR_get() + 1);
-	  else if(sh_encoder_new_state_1->ISR_get() == 0b10)	// If previous state decrement
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->ISR_get() - 1);
-	  else							// If neither, increment error count
-	      sh_encoder_error_count_1->ISR_put(sh_encoder_error_count_1->ISR_get() + 1);
-	  break;
-	  
-	case(0b01):
-	  if(sh_encoder_new_state_1->ISR_get() == 0b00)		// If next state increment
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->ISR_get() + 1);	
-	  else if(sh_encoder_new_state_1->ISR_get() == 0b11)	// If previous state decrement
-	      sh_encoder_count_1->ISR_put(sh_encoder_count_1->ISR_get() - 1);	
-	  else							// If neither, increment error count
-	      sh_encoder_error_count_1->ISR_put(sh_encoder_error_count_1->ISR_get() + 1);
-	  break;
+	  sh_encoder_error_count_1->ISR_put(sh_encoder_error_count_1->ISR_get() + 1);
       }
+
+      traceISR_EXIT (4);
 }
 
 // Aliases the pin E5 interrupt to run the pin E4 interrupt service routine
 ISR_ALIAS(INT5_vect, INT4_vect);
 
 //-----------------------------------------------------------------------------------------------------------
-/** \brief This interrupt service routine determines the new encoder state, direction, increments or
- *	   decrements encoder count, and flags encoder sequence errors with the error count.
- *  \details Specifically, compare the new state to the previous state and based on the physical quadrature
- *	     of the encoder disk, determines relevant encoder direction and recognizes errors: tick skipping.
- *	     This ISR will be used for channel 6 & 7.
+/** \brief This interrupt service routine reads motor 2's encoder, updates its count, and counts encoder
+ *	   sequence errors.
+ *  \details It works just as the INT4 interrupt does. This ISR will be used for channel 6 & 7.
  *  @param INT6_vect Interrupt vector for pin E6 (External interrupt)
  */
 
 ISR (INT6_vect)
 {
-      // Saves old state of motor 1 (channels A and B)
-      sh_encoder_old_state_2->ISR_put(sh_encoder_new_state_2->ISR_get());
-      
-      // Stores new state of motor 1 (channels A and B)
-      sh_encoder_new_state_2->ISR_put(((PINE & _BV(PINE6)) | (PINE & _BV(PINE7))) >> 6);
-      
-// Compare motor 1 encoder state and determine direction, Yellow = A, 6, White = B, 7
-// CW  direction (A:B) = -> 0b00 -> 0b10 -> 0b11 -> 0b01 ->
-// CCW direction (A:B) = -> 0b01 -> 0b11 -> 0b10 -> 0b00 ->
-      switch(sh_encoder_old_state_2->ISR_get())
+      traceISR_ENTER (6);
+
+      // Yellow = A, pin E6, White = B, pin E7
+      encoder_state_2 = ((encoder_state_2 << 2) | (PINE >> PINE6)) & 0x0F;
+      int8_t delta = quadrature_delta[encoder_state_2];
+      time_stamp edge_time;
+
+      if (delta)
       {
-	case(0b00):
-	  if(sh_encoder_new_state_2->ISR_get() == 0b10)		// If next state increment
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() + 1);
-	  else if(sh_encoder_new_state_2->ISR_get() == 0b01)	// If previous state decrement
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() - 1);
-	  else							// If neither, increment error count
-	       sh_encoder_error_count_2->ISR_put(sh_encoder_error_count_2->ISR_get() + 1);	
-	  break;
-	  
-	case(0b10):
-	  if(sh_encoder_new_state_2->ISR_get() == 0b11)		// If next state increment
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() + 1);
-	  else if(sh_encoder_new_state_2->ISR_get() == 0b00)	// If previous state decrement
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() - 1);
-	  else							// If neither, increment error count
-	      sh_encoder_error_count_2->ISR_put(sh_encoder_error_count_2->ISR_get() + 1);
-	  break;
-
-	case(0b11):
-	  if(sh_encoder_new_state_2->ISR_get() == 0b01)		// If next state increment
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() + 1);
-	  else if(sh_encoder_new_state_2->ISR_get() == 0b10)	// If previous state decrement
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() - 1);
-	  else							// If neither, increment error count
-	       sh_encoder_error_count_2->ISR_put(sh_encoder_error_count_2->ISR_get() + 1);
-	  break;
-	  
-	case(0b01):
-	  if(sh_encoder_new_state_2->ISR_get() == 0b00)		// If next state increment
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() + 1);
-	  else if(sh_encoder_new_state_2->ISR_get() == 0b11)	// If previous state decrement
-	       sh_encoder_count_2->ISR_put(sh_encoder_count_2->ISR_get() - 1);
-	  else							// If neither, increment error count
-	       sh_encoder_error_count_2->ISR_put(sh_encoder_error_count_2->ISR_get() + 1);	
+	  encoder_position_2 += delta;
+	  sh_encoder_position_2->ISR_put(encoder_position_2);
+	  edge_time.set_to_now_in_ISR();
+	  sh_encoder_edge_time_2->ISR_put(edge_time);
       }
+      else						// If no valid move, increment error count
+      {
+	  sh_encoder_error_count_2->ISR_put(sh_encoder_error_count_2->ISR_get() + 1);
+      }
+
+      traceISR_EXIT (6);
 }
 
 // Aliases the pin E7 interrupt to run the pin E6 interrupt service routine
-ISR_ALIAS(INT7_vect, INT6_vect);
\ No newline at end of file
+ISR_ALIAS(INT7_vect, INT6_vect);
@@ -1,11 +1,13 @@
 //===========================================================================================================
 /** @file encoder_drv.h
   *   This file contains interrupt service routines appropriate to a specific encoder. Also shares pertinent
- *    encoder data with task_encoder.cpp, including direction, encoder states, count, and error count.
+ *    encoder data with task_encoder.cpp, including the encoder position and error count.
  *
  *  Revisions:
  *    @li 04-13-2016 ME405 Group 3 original file
  *    @li April 28, 2016 -- BKK Cleaned up comments
+ *    @li 10-17-2026 ME405 Group 3 Added encoder_snapshot for reading 32-bit encoder positions
+ *    @li 10-17-2026 ME405 Group 3 Moved encoder_snapshot to its own file
  *
  */
 //===========================================================================================================
@@ -46,8 +48,6 @@ class encoder_drv
 
 	encoder_drv (emstream* = NULL, uint8_t = 0);
 	
-	uint32_t calc_motor (uint16_t old_count, uint16_t new_count);
-	
 	private:
 	  
 
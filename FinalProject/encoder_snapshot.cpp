@@ -0,0 +1,106 @@
+//***********************************************************************************************************
+/** @file encoder_snapshot.cpp
+ *    This file contains a class which reads an encoder's position and the time of its most recent edge, and
+ *    from them finds how far and how fast the encoder has moved.
+ *
+ *  Revisions:
+ *    @li 10-17-2026 ME405 Group 3 original file
+ *
+ */
+//***********************************************************************************************************
+#include "encoder_snapshot.h"               // Header for this class
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This constructor makes a snapshot of an encoder whose position hasn't yet been read.
+ *  @param p_position A pointer to the share holding the encoder's position
+ *  @param p_edge_time A pointer to the share holding the time of the encoder's most recent edge, or NULL
+ *		       if the velocity isn't needed (default: NULL)
+ */
+
+encoder_snapshot::encoder_snapshot (TaskShare<int32_t>* p_position, TaskShare<time_stamp>* p_edge_time)
+	: p_position_share (p_position), p_edge_time_share (p_edge_time), position (0), delta (0),
+	  edge_time (0), velocity (0)
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This method converts a time stamp into a count of hardware timer ticks.
+ *  \details The count wraps around every 2^32 hardware ticks, but as that's a multiple of the number of
+ *	     hardware ticks per RTOS tick, the difference between two counts is right as long as they're
+ *	     less than about 35 minutes apart.
+ *  @param a_time The time stamp to be converted
+ *  @return The time in hardware timer counts
+ */
+
+uint32_t encoder_snapshot::to_counts (time_stamp& a_time)
+{
+	return (uint32_t)a_time.get_RTOS_ticks () * TMR_MAX_CT + a_time.get_hardware_count ();
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This method reads the encoder's position and edge time, finding the change in position since
+ *	   the previous reading and, if the edge time is available, the velocity.
+ *  \details This is meant to be called once each 10 ms control period. It uses one 32-bit division when
+ *	     the encoder has moved; when it hasn't, it reads the time and uses one division to limit the
+ *	     velocity.
+ */
+
+void encoder_snapshot::update (void)
+{
+	int32_t new_position;
+	time_stamp new_edge_time;
+
+	// The position and the time of the edge at which it was reached are read together
+	portENTER_CRITICAL ();
+	new_position = p_position_share->ISR_get ();
+	if (p_edge_time_share != NULL)
+	{
+		new_edge_time = p_edge_time_share->ISR_get ();
+	}
+	portEXIT_CRITICAL ();
+
+	delta = (int32_t)((uint32_t)new_position - (uint32_t)position);
+	position = new_position;
+
+	if (p_edge_time_share == NULL)
+	{
+		return;
+	}
+
+	uint32_t new_edge_counts = to_counts (new_edge_time);
+	uint32_t speed;
+	if (delta != 0)
+	{
+		// M/T: the ticks counted over the time between the last edges seen by this and the last update
+		uint32_t interval = new_edge_counts - edge_time;
+		edge_time = new_edge_counts;
+		if (interval == 0 || (uint32_t)labs (delta) > UINT32_MAX / VELOCITY_SCALE)
+		{
+			speed = INT16_MAX;
+		}
+		else
+		{
+			speed = (uint32_t)labs (delta) * VELOCITY_SCALE / interval;
+		}
+		if (speed > INT16_MAX)
+		{
+			speed = INT16_MAX;
+		}
+		velocity = (delta < 0) ? -(int16_t)speed : (int16_t)speed;
+	}
+	else if (velocity != 0)
+	{
+		// No edge this period, so the encoder has moved less than a tick since its last edge
+		time_stamp now;
+		now.set_to_now ();
+		uint32_t since = to_counts (now) - edge_time;
+		speed = (since == 0) ? INT16_MAX : VELOCITY_SCALE / since;
+		if (speed < (uint32_t)abs (velocity))
+		{
+			velocity = (velocity < 0) ? -(int16_t)speed : (int16_t)speed;
+		}
+	}
+}
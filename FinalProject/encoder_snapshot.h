@@ -0,0 +1,94 @@
+//===========================================================================================================
+/** @file encoder_snapshot.h
+ *    This file contains a class which reads an encoder's position and the time of its most recent edge, and
+ *    from them finds how far and how fast the encoder has moved.
+ *
+ *  Revisions:
+ *    @li 10-17-2026 ME405 Group 3 original file, split from encoder_drv.h
+ *    @li 10-17-2026 ME405 Group 3 to_counts() made public for the pipeline latency measurement
+ *
+ */
+//===========================================================================================================
+
+/// This define prevents this .H file from being included multiple times in a .CPP file
+#ifndef _ENCODER_SNAPSHOT_H_
+#define _ENCODER_SNAPSHOT_H_
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+
+#include "FreeRTOS.h"                       // Header for the FreeRTOS RTOS
+#include "taskshare.h"			    // Header for thread-safe shared data
+#include "time_stamp.h"			    // Header for high resolution time stamps
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** @brief   This class reads an encoder's position and finds how far and how fast the encoder has moved
+ *	     since the previous reading.
+ *  @details Each task which needs to know how an encoder has moved keeps its own snapshot of the encoder's
+ *	     shares and calls @c update() once each period; the position, the change in position and the
+ *	     velocity are then available until the next update. The shares are read in one critical section
+ *	     which only copies them. The change is found with unsigned subtraction, so it's correct even when
+ *	     the 32-bit position wraps around.
+ *
+ *	     When the snapshot is given the share holding the time of the encoder's most recent edge, it
+ *	     also estimates the velocity by the M/T method: the number of ticks counted is divided by the
+ *	     time between the last edge seen by the previous update and the last edge seen by this one. As
+ *	     the position only changes at edges, this is exact no matter where in the period the edges fall,
+ *	     so a wheel turning at a fraction of a tick per period doesn't read as alternating 0 and 1. When
+ *	     no edge has come in a period, the speed can be no more than one tick in the time since the
+ *	     last edge, so the estimate decays toward zero as a stopping wheel's edges get further apart.
+ *	     The velocity is in ticks per 10 ms, the control period, with @c VELOCITY_Q fraction bits. \n
+ *	     @c encoder_snapshot @c motor_1 (sh_encoder_position_1, @c sh_encoder_edge_time_1); \n
+ *	     @c motor_1.update(); \n
+ *	     @c sh_motor_1_speed->put(motor_1.get_velocity()); \n
+ */
+
+class encoder_snapshot
+{
+	public:
+	/// The number of fraction bits in the velocity, which is in ticks per 10 ms
+	static const uint8_t VELOCITY_Q = 2;
+
+	protected:
+	/// The velocity of one tick per hardware timer count, in ticks per 10 ms with @c VELOCITY_Q bits
+	static const uint32_t VELOCITY_SCALE = ((uint32_t)1 << VELOCITY_Q) * 10 * TMR_MAX_CT;
+
+	/// The share in which the encoder interrupt keeps the encoder's position
+	TaskShare<int32_t>* p_position_share;
+
+	/// The share in which the encoder interrupt keeps the time of its most recent edge, or NULL
+	TaskShare<time_stamp>* p_edge_time_share;
+
+	/// The position read by the most recent call to @c update()
+	int32_t position;
+
+	/// The change in position between the two most recent calls to @c update()
+	int32_t delta;
+
+	/// The time of the last edge seen by @c update(), in hardware timer counts
+	uint32_t edge_time;
+
+	/// The estimated velocity, in ticks per 10 ms with @c VELOCITY_Q fraction bits
+	int16_t velocity;
+
+	public:
+	// Converts a time stamp into hardware timer counts
+	static uint32_t to_counts (time_stamp& a_time);
+
+	// The constructor makes a snapshot of an encoder whose position hasn't yet been read
+	encoder_snapshot (TaskShare<int32_t>* p_position, TaskShare<time_stamp>* p_edge_time = NULL);
+
+	// Reads the encoder's shares, finding the change in position and the velocity
+	void update (void);
+
+	/// Gets the position, in ticks, which was read by the most recent call to @c update()
+	int32_t get_position (void) const { return position; }
+
+	/// Gets the change in position, in ticks, between the two most recent calls to @c update()
+	int32_t get_delta (void) const { return delta; }
+
+	/// Gets the velocity, in ticks per 10 ms with @c VELOCITY_Q fraction bits, found by @c update()
+	int16_t get_velocity (void) const { return velocity; }
+}; /// end of class encoder_snapshot
+
+#endif /// _ENCODER_SNAPSHOT_H_
@@ -0,0 +1,69 @@
+//===========================================================================================================
+/** \file fixed.h
+ *    This file contains a small template class for signed 16-bit fixed point numbers with Q fractional
+ *    bits, such as the Q10 gains used by the PID controller.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//===========================================================================================================
+
+// This define prevents this .H file from being included multiple times in a .CPP file
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+#include "satmath.h"			    // Header for saturated math library
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This class holds a signed 16-bit fixed point number with @c Q fractional bits
+ *  \details The value stored is the real number times 2^Q; for example, a gain of 1.5 is stored in a
+ *	     @c fixed<10> as 1536. Multiplying by an integer gives a saturated 16-bit integer; the product is
+ *	     found with a 32-bit saturated multiplication and scaled back with an arithmetic shift, so there
+ *	     is no division. The shift rounds toward zero, so the results are exactly those of the older
+ *	     @c ssdiv(ssmul(K,x),1024) code.\n
+ *	     Code which keeps its gains as plain @c int16_t numbers can use the static method
+ *	     @c fixed<Q>::mul() instead of making objects:\n
+ *	     @c output @c = @c fixed<10>::mul(Kp, error);\n
+ */
+template <uint8_t Q> class fixed
+{
+protected:
+	int16_t		raw;			//!< The number times 2^Q
+
+public:
+	/// The value one, as it's stored in this fixed point format
+	static const int16_t ONE = (int16_t)(1 << Q);
+
+	/** \brief The constructor makes a fixed point number from its stored (2^Q times) value
+	 *  @param a_raw The number times 2^Q
+	 */
+	explicit fixed (int16_t a_raw = 0) : raw (a_raw) { }
+
+	/** \brief Gets the stored value of the number, which is the number times 2^Q
+	 *  @return The stored value
+	 */
+	int16_t get_raw (void) const { return raw; }
+
+	/** \brief Multiplies a stored fixed point value by an integer, saturating the result
+	 *  @param a_raw A fixed point number's stored (2^Q times) value
+	 *  @param x The integer by which it's multiplied
+	 *  @return The product, rounded toward zero and saturated to 16 bits
+	 */
+	static int16_t mul (int16_t a_raw, int16_t x)
+	{
+		return ssshr(ssmul(a_raw, x), Q);
+	}
+
+	/** \brief Multiplies this number by an integer, saturating the result
+	 *  @param x The integer by which this number is multiplied
+	 *  @return The product, rounded toward zero and saturated to 16 bits
+	 */
+	int16_t operator * (int16_t x) const { return mul (raw, x); }
+};
+
+/// The Q10 format, in which the PID gains are kept
+typedef fixed<10> q10_t;
+
+#endif // FIXED_H
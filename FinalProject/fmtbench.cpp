@@ -0,0 +1,328 @@
+//***********************************************************************************************************
+/** \file fmtbench.cpp
+ *    This file contains a program for the PC which checks and times the conversion of numbers to decimal
+ *    text by \c utoa_dec(), which \c emstream uses in place of the C library's \c ltoa() and \c ultoa().
+ *    It first checks that \c utoa_dec() gives the same digits as \c snprintf() for every 16-bit number,
+ *    for the numbers on each side of every power of ten and for a few million numbers spread over the
+ *    whole 32-bit range, and that numbers printed with \c << to the widths set by \c setw() and padded
+ *    with the characters set by \c setfill() come out as they do from \c printf(). Given the argument
+ *    \c all, it also checks every 32-bit number, against a decimal counter which is counted up alongside;
+ *    that takes about two minutes. It then times \c ultoa() and \c utoa_dec() on the same numbers.
+ *
+ *    The PC divides in a few cycles where the AVR takes hundreds, so the times only show that nothing
+ *    has got worse on the PC; the cycle counts which matter are those printed by the AVR benchmark in
+ *    \c bench_main.cpp. The program is built with 'make -f Makefile.host fmtbench' and run as:
+ *    \code
+ *    build_host/fmtbench [all]
+ *    \endcode
+ *    It returns zero if every check passed and one if any failed.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//***********************************************************************************************************
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+#include <stdio.h>                          // The C library's snprintf(), to check against
+#include <string.h>                         // String comparisons
+#include <time.h>                           // The PC's clock, for timing
+
+#include "emstream.h"                       // Base class for text streams, with utoa_dec()
+
+
+/// The number of numbers converted by each function while it's being timed
+const uint32_t BENCH_COUNT = 20000000UL;
+
+/// The number of checks which have failed
+static uint32_t failures = 0;
+
+/// The first digit of each number timed is added here so that the compiler can't optimize away the calls
+volatile uint32_t bench_sink;
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This class is a text stream which keeps what's printed to it in a string, so the string can be
+ *  compared with what \c snprintf() makes.
+ */
+
+class string_stream : public emstream
+{
+	protected:
+		char text[64];                      ///< The characters printed since the stream was cleared
+		size_t length;                      ///< The number of characters in the string
+
+	public:
+		/// The constructor makes an empty string.
+		string_stream (void) : emstream (), length (0)
+		{
+			text[0] = '\0';
+		}
+
+		/** This method adds a character to the string, if there's room.
+		 *  @param a_char The character to be added
+		 */
+		void putchar (char a_char)
+		{
+			if (length < sizeof (text) - 1)
+			{
+				text[length++] = a_char;
+				text[length] = '\0';
+			}
+		}
+
+		/// This method empties the string.
+		void clear (void)
+		{
+			length = 0;
+			text[0] = '\0';
+		}
+
+		/** This method returns the characters which have been printed.
+		 *  @return A pointer to the string
+		 */
+		const char* get (void)
+		{
+			return (text);
+		}
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks the digits which \c utoa_dec() makes for one number against the expected ones,
+ *  and prints both if they differ.
+ *  @param num The number to be converted
+ *  @param p_expected The digits which the number should be converted to
+ */
+
+static void check_digits (uint32_t num, const char* p_expected)
+{
+	char digits[11];
+	uint8_t length = utoa_dec (num, digits);
+
+	if (strcmp (digits, p_expected) != 0 || length != strlen (p_expected))
+	{
+		if (failures++ < 10)
+		{
+			printf ("utoa_dec (%lu) gave \"%s\", length %u\n", (unsigned long)num, digits, length);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks a number against \c snprintf().
+ *  @param num The number to be converted
+ */
+
+static void check_number (uint32_t num)
+{
+	char expected[12];
+	snprintf (expected, sizeof (expected), "%lu", (unsigned long)num);
+	check_digits (num, expected);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks every 32-bit number. The expected digits are kept in a string which is counted
+ *  up by one each time, as \c snprintf() would take many minutes to make them all.
+ */
+
+static void check_all_numbers (void)
+{
+	char counter[12] = "0";
+	uint8_t length = 1;
+	uint32_t num = 0;
+
+	do
+	{
+		check_digits (num, counter);
+
+		// Add one to the string, carrying into a new digit at the front when all of them are nines
+		int8_t index = length - 1;
+		while (index >= 0 && counter[index] == '9')
+		{
+			counter[index--] = '0';
+		}
+		if (index >= 0)
+		{
+			counter[index]++;
+		}
+		else
+		{
+			memmove (counter + 1, counter, ++length);
+			counter[0] = '1';
+		}
+	}
+	while (++num != 0);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks one signed number printed with \c << to a given width and fill character,
+ *  against the same number printed by \c snprintf().
+ *  @param p_stream The stream to which the number is printed
+ *  @param num The number to be printed
+ *  @param width The width to which the number is padded
+ *  @param fill The character with which the number is padded
+ */
+
+static void check_padded (string_stream* p_stream, int32_t num, uint8_t width, char fill)
+{
+	char expected[EMSTREAM_MAX_WIDTH + 2];
+
+	// printf() only pads with spaces or zeros, so other fill characters are put in place of spaces
+	snprintf (expected, sizeof (expected), (fill == '0') ? "%0*ld" : "%*ld", width, (long)num);
+	for (char* p_char = expected; *p_char == ' '; p_char++)
+	{
+		*p_char = fill;
+	}
+
+	// The width must only apply to the first number, so a second one is printed after it
+	p_stream->clear ();
+	*p_stream << setfill (fill) << setw (width) << num << '|' << num;
+	char unpadded[24];
+	snprintf (unpadded, sizeof (unpadded), "|%ld", (long)num);
+	strcat (expected, unpadded);
+
+	if (strcmp (p_stream->get (), expected) != 0)
+	{
+		if (failures++ < 10)
+		{
+			printf ("setw (%u), setfill ('%c') << %ld gave \"%s\", not \"%s\"\n", width, fill, (long)num,
+					p_stream->get (), expected);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks that each size of integer, signed and unsigned, prints through \c << as
+ *  \c snprintf() prints it, with and without padding.
+ */
+
+static void check_streams (void)
+{
+	string_stream stream;
+	const int32_t values[] = { 0, 1, -1, 9, -10, 127, -128, 255, 32767, -32768, 65535, 100000, -987654,
+							   2147483647L, (int32_t)(-2147483647L - 1) };
+	const char fills[] = { ' ', '0', '*' };
+
+	for (uint8_t index = 0; index < sizeof (values) / sizeof (values[0]); index++)
+	{
+		for (uint8_t width = 0; width <= EMSTREAM_MAX_WIDTH; width++)
+		{
+			for (uint8_t fill = 0; fill < sizeof (fills); fill++)
+			{
+				check_padded (&stream, values[index], width, fills[fill]);
+			}
+		}
+	}
+	stream << setfill (' ');
+
+	// Every 8-bit and 16-bit number is printed through its own operator
+	char expected[24];
+	for (int32_t num = -32768; num <= 65535; num++)
+	{
+		stream.clear ();
+		snprintf (expected, sizeof (expected), "%d", (int)(int16_t)num);
+		stream << (int16_t)num;
+		if (num >= 0)
+		{
+			snprintf (expected + strlen (expected), 8, "%u", (unsigned)(uint16_t)num);
+			stream << (uint16_t)num;
+		}
+		if (num >= -128 && num < 256)
+		{
+			snprintf (expected + strlen (expected), 8, "%d%u", (int)(int8_t)num, (unsigned)(uint8_t)num);
+			stream << (int8_t)num << (uint8_t)num;
+		}
+		if (strcmp (stream.get (), expected) != 0 && failures++ < 10)
+		{
+			printf ("<< %ld gave \"%s\", not \"%s\"\n", (long)num, stream.get (), expected);
+		}
+	}
+
+	// Other bases don't go through utoa_dec() and aren't padded
+	stream.clear ();
+	stream << setw (8) << hex << (uint16_t)0xBEEF << dec << setw (4) << (uint32_t)7;
+	if (strcmp (stream.get (), "BEEF   7") != 0 && strcmp (stream.get (), "beef   7") != 0
+		&& failures++ < 10)
+	{
+		printf ("hex then decimal gave \"%s\"\n", stream.get ());
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function returns the time from the PC's monotonic clock.
+ *  @return The time in seconds
+ */
+
+static double seconds (void)
+{
+	struct timespec now;
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return (now.tv_sec + now.tv_nsec * 1e-9);
+}
+
+
+//===========================================================================================================
+/** The main function runs the checks, then the timing.
+ *  @param argc The number of command line arguments
+ *  @param argv The command line arguments; if the first is \c all, every 32-bit number is checked
+ *  @return Zero if every check passed, one if any failed
+ */
+
+int main (int argc, char** argv)
+{
+	// Every 16-bit number, the numbers around each power of ten, and numbers spread over 32 bits
+	for (uint32_t num = 0; num <= 65535UL; num++)
+	{
+		check_number (num);
+	}
+	for (uint32_t power = 10; power <= 1000000000UL; power *= 10)
+	{
+		check_number (power - 1);
+		check_number (power);
+		check_number (power + 1);
+	}
+	check_number (4294967295UL);
+	for (uint32_t num = 65536UL; num >= 65536UL; num += 1021UL)
+	{
+		check_number (num);
+	}
+	if (argc > 1 && strcmp (argv[1], "all") == 0)
+	{
+		printf ("Checking every 32-bit number...\n");
+		check_all_numbers ();
+	}
+	check_streams ();
+	printf ("Checks %s, %lu failures\n", failures ? "FAILED" : "passed", (unsigned long)failures);
+
+	// Time each function on the same pseudo-random numbers of up to ten digits
+	char digits[12];
+	uint32_t seed = 12345;
+	double start = seconds ();
+	for (uint32_t count = 0; count < BENCH_COUNT; count++)
+	{
+		seed = seed * 1664525UL + 1013904223UL;
+		ultoa (seed, digits, 10);
+		bench_sink += digits[0];
+	}
+	double ultoa_time = seconds () - start;
+
+	seed = 12345;
+	start = seconds ();
+	for (uint32_t count = 0; count < BENCH_COUNT; count++)
+	{
+		seed = seed * 1664525UL + 1013904223UL;
+		utoa_dec (seed, digits);
+		bench_sink += digits[0];
+	}
+	double utoa_dec_time = seconds () - start;
+
+	printf ("ultoa:    %.1f ns per number\n", ultoa_time * 1e9 / BENCH_COUNT);
+	printf ("utoa_dec: %.1f ns per number\n", utoa_dec_time * 1e9 / BENCH_COUNT);
+
+	return (failures ? 1 : 0);
+}
@@ -0,0 +1,137 @@
+//***********************************************************************************************************
+/** \file host_main.cpp
+ *    This file contains the main() code for the host (PC) build of the final project, made with
+ *    \c Makefile.host. It creates the same shares as \c main.cpp, then runs the real control task together
+ *    with a task that simulates the car's hardware, under FreeRTOS on its POSIX port. A linear route is
+ *    started just as the user interface would start one, so that the whole control loop is exercised.
+ *    The program runs for the number of seconds given on the command line (default 10), then prints the
+ *    shares and the task list and exits.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ *    \li 10-17-2026 ME405 Group 3 Shares and tasks are built in static holders, as in main.cpp
+ *    \li 10-17-2026 ME405 Group 3 The print queue is a stream buffer, as in main.cpp
+ */
+//***********************************************************************************************************
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+
+#include "FreeRTOS.h"                       // Primary header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS task functions
+#include "queue.h"                          // FreeRTOS inter-task communication queues
+
+#include "host_serial.h"                    // Serial device on the PC's terminal
+#include "taskbase.h"                       // Header of wrapper for FreeRTOS tasks
+#include "cyclicexec.h"                     // Periodic steps and the cyclic executive
+#include "streambuffer.h"                   // Text queue which moves characters in blocks
+#include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
+#include "taskshare.h"                      // Header for thread-safe shared data
+#include "staticstore.h"                    // Holders for objects which aren't on the heap
+#include "shares.h"                         // Global ('extern') queue declarations
+
+#include "task_control.h"		    // Include header for pid task
+#include "task_sim.h"			    // Include header for hardware simulation task
+
+/// This is the print queue, as in \c main.cpp
+StreamBuffer* p_print_ser_queue;
+
+// Shared variables; see main.cpp for descriptions
+EventGroupHandle_t ev_tasks;
+NotifyShare<int8_t>* sh_power_set_flag;
+NotifyShare<int8_t>* sh_braking_full_flag;
+TaskShare<int32_t>* sh_encoder_position_1;
+TaskShare<int32_t>* sh_encoder_position_2;
+TaskShare<time_stamp>* sh_encoder_edge_time_1;
+TaskShare<time_stamp>* sh_encoder_edge_time_2;
+TaskShare<uint16_t>* sh_encoder_error_count_1;
+TaskShare<uint16_t>* sh_encoder_error_count_2;
+SharedBlock<motor_block_t>* sh_motors;
+SharedBlock<route_block_t>* sh_route;
+SharedBlock<imu_block_t>* sh_imu;
+TaskShare<uint16_t>* sh_servo_setpoint;
+SharedBlock<latency_block_t>* sh_latency;
+
+// The memory in which the queue, shares and tasks are built, and the tasks' stacks, as in main.cpp
+static StaticStore<StreamBuffer> store_print_ser_queue;
+static StaticStore<NotifyShare<int8_t> > store_power_set_flag;
+static StaticStore<NotifyShare<int8_t> > store_braking_full_flag;
+static StaticStore<TaskShare<int32_t> > store_encoder_position_1;
+static StaticStore<TaskShare<int32_t> > store_encoder_position_2;
+static StaticStore<TaskShare<time_stamp> > store_encoder_edge_time_1;
+static StaticStore<TaskShare<time_stamp> > store_encoder_edge_time_2;
+static StaticStore<TaskShare<uint16_t> > store_encoder_error_count_1;
+static StaticStore<TaskShare<uint16_t> > store_encoder_error_count_2;
+static StaticStore<SharedBlock<motor_block_t> > store_motors;
+static StaticStore<SharedBlock<route_block_t> > store_route;
+static StaticStore<SharedBlock<imu_block_t> > store_imu;
+static StaticStore<TaskShare<uint16_t> > store_servo_setpoint;
+static StaticStore<SharedBlock<latency_block_t> > store_latency;
+
+static StaticStore<task_control> store_control;
+static StaticStore<CyclicTask> store_control_task;
+static TaskStack<350> stack_control;
+static StaticStore<task_sim> store_sim;
+static TaskStack<280> stack_sim;
+
+
+//===========================================================================================================
+/** The main function creates the shares and tasks, starts a linear route and runs the scheduler until the
+ *  simulation task stops it.
+ *  @param argc The number of command line arguments
+ *  @param argv The command line arguments; the first, if given, is the run time in seconds
+ *  @return Zero, once the simulation has finished
+ */
+
+int main (int argc, char** argv)
+{
+     uint32_t run_time_ms = 10000;
+     if (argc > 1)
+     {
+	  run_time_ms = 1000UL * atol (argv[1]);
+     }
+
+     // The PC's terminal stands in for the serial port
+     host_serial* p_ser_port = new host_serial ();
+     *p_ser_port << PMS ("-------- ME405 Final Project, host build --------") << endl;
+
+     // Create the queues and other shared data items, as main.cpp does
+     p_print_ser_queue = store_print_ser_queue.create (32, "Print", p_ser_port, 30);
+
+     ev_tasks = xEventGroupCreate ();
+     sh_power_set_flag = store_power_set_flag.create ("sh_power_set_flag", ev_tasks, EV_POWER_SET);
+     sh_braking_full_flag = store_braking_full_flag.create ("sh_braking_full_flag", ev_tasks, EV_BRAKING_FULL);
+     sh_encoder_position_1 = store_encoder_position_1.create ("sh_encoder_position_1");
+     sh_encoder_position_2 = store_encoder_position_2.create ("sh_encoder_position_2");
+     sh_encoder_edge_time_1 = store_encoder_edge_time_1.create ("sh_encoder_edge_time_1");
+     sh_encoder_edge_time_2 = store_encoder_edge_time_2.create ("sh_encoder_edge_time_2");
+     sh_encoder_error_count_1 = store_encoder_error_count_1.create ("sh_encoder_error_count_1");
+     sh_encoder_error_count_2 = store_encoder_error_count_2.create ("sh_encoder_error_count_2");
+     sh_motors = store_motors.create ("sh_motors");
+     sh_route = store_route.create ("sh_route");
+     sh_imu = store_imu.create ("sh_imu");
+     sh_servo_setpoint = store_servo_setpoint.create ("sh_servo_setpoint");
+     sh_latency = store_latency.create ("sh_latency");
+
+     // Start a 60 inch linear route at 40 ticks per 10 ms, as the user interface would
+     route_block_t& route = sh_route->begin_write();
+     route.velocity = 40;
+     route.distance = 60;
+     route.heading_setpoint = 0;
+     route.linear_start = 1;
+     route.mode = 1;
+     sh_route->end_write();
+
+     // The real control task, with the same priority and stack size as on the car
+     store_control_task.create (store_control.create ("Control      ", p_ser_port), 10, task_priority(3),
+				stack_control.size (), p_ser_port, stack_control.buffer ());
+
+     // The simulation takes the place of the power, sensor and steering tasks
+     store_sim.create ("Simulator    ", task_priority(4), stack_sim.size (), p_ser_port, run_time_ms,
+		       stack_sim.buffer ());
+
+     // The RTOS scheduler runs until the simulation task stops it
+     vTaskStartScheduler ();
+
+     *p_ser_port << PMS ("Scheduler stopped") << endl;
+     return (0);
+}
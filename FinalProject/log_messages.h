@@ -0,0 +1,35 @@
+//***********************************************************************************************************
+/** \file log_messages.h
+ *    This file contains the table of log messages which tasks send with \c log_id(). Each line of the table
+ *    gives the name of a message, which becomes its number, and the text into which its values are put.
+ *    The car is only compiled with the numbers; the text is compiled into the PC program \c telem2csv,
+ *    which puts the values into it when the log entry comes in through the telemetry port. A message is
+ *    added by adding a line to the end of \c LOG_MESSAGES, then rebuilding both the car's program and
+ *    \c telem2csv. The text is given as for \c printf(), with one conversion such as \c %d, \c %u, \c %x,
+ *    \c %c or \c %f for each value; the size of each value comes from its type when it's logged, so
+ *    length modifiers such as the \c l in \c %ld aren't needed, though they do no harm.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//***********************************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _LOG_MESSAGES_H_
+#define _LOG_MESSAGES_H_
+
+/// The log messages, each with its name and the text into which its values are put
+#define LOG_MESSAGES \
+	LOG_MESSAGE (LOG_ROUTE_START, "Linear route started: %ld ticks at %d ticks per 10 ms") \
+	LOG_MESSAGE (LOG_ROUTE_DONE,  "Linear route done: %ld ticks past the end")
+
+/// The number of each log message, which is all that's compiled into the car's program
+enum log_message_t
+{
+	#define LOG_MESSAGE(name, format) name,
+	LOG_MESSAGES
+	#undef LOG_MESSAGE
+	LOG_NUM_MESSAGES					///< The number of messages in the table
+};
+
+#endif // _LOG_MESSAGES_H_
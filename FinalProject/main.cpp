@@ -14,6 +14,18 @@
  *    @li 01-04-2015 JRR Names of share & queue classes changed; allocated with new now
  *    @li April 28, 2016 -- BKK Added shared variables (encoder: count, state, error count), commented
  * 			    out task_brightness: was interfering with channel 4 interrupts.
+ *    @li 10-17-2026 ME405 Group 3 Removed the encoder state shares; the encoder interrupts keep the states
+ *    @li 10-17-2026 ME405 Group 3 Encoder counts are now 32-bit positions; speeds are 16-bit
+ *    @li 10-17-2026 ME405 Group 3 Added encoder edge time shares
+ *    @li 10-17-2026 ME405 Group 3 Motor, route and IMU shares grouped into shared blocks
+ *    @li 10-17-2026 ME405 Group 3 Power and braking flags wake the power task through an event group
+ *    @li 10-17-2026 ME405 Group 3 Sensor, power, control and steering tasks run as one chain each period
+ *    @li 10-17-2026 ME405 Group 3 Periodic tasks are steps which can all run from one cyclic executive
+ *    @li 10-17-2026 ME405 Group 3 Tasks, stacks, shares and queues are laid out by the linker, not the heap
+ *    @li 10-17-2026 ME405 Group 3 Binary telemetry of the encoder and servo shares on serial port 1
+ *    @li 10-17-2026 ME405 Group 3 Log messages go out through the telemetry port as numbers and values
+ *    @li 10-17-2026 ME405 Group 3 The print queue is a stream buffer which moves text in blocks
+ *    @li 10-17-2026 ME405 Group 3 The heap is checked to be made smaller by what the static holders take
  *
  *  License:
  *	This file is copyright 2015 by JR Ridgely and released under the Lesser GNU Public License, 
@@ -42,9 +54,12 @@
 #include "rs232int.h"                       // ME405/507 library for serial comm.
 #include "time_stamp.h"                     // Class to implement a microsecond timer
 #include "taskbase.h"                       // Header of wrapper for FreeRTOS tasks
-#include "textqueue.h"                      // Wrapper for FreeRTOS character queues
+#include "cyclicexec.h"                     // Periodic steps and the cyclic executive
+#include "streambuffer.h"                   // Text queue which moves characters in blocks
 #include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
 #include "taskshare.h"                      // Header for thread-safe shared data
+#include "staticstore.h"                    // Holders for objects which aren't on the heap
+#include "telemetry.h"                      // Binary records of shares sent through a serial port
 #include "shares.h"                         // Global ('extern') queue declarations
 
 #include "task_user.h"                      // Header for user interface task
@@ -53,6 +68,22 @@
 #include "task_sensor.h"		    // Include header for imu task
 #include "task_steer.h"			    // Include header for servo task
 
+/** Set to 1 to run the sensor, power, control and steering steps in this order every 10 ms from one
+ *  cyclic executive task with one stack, or to 0 to run each of them in a task of its own.
+ */
+#ifndef CYCLIC_EXECUTIVE
+	#define CYCLIC_EXECUTIVE	0
+#endif
+
+/** Set to 1 to send the encoder positions and error counts and the servo setpoint every 10 ms as binary
+ *  records through serial port 1 at 57600 baud, to be logged on a PC with telem2csv, or to 0 to leave the
+ *  port alone. The log messages made with \c log_id() are sent the same way; with this set to 0 they're
+ *  dropped.
+ */
+#ifndef TELEMETRY
+	#define TELEMETRY		1
+#endif
+
 // Declare the queues which are used by tasks to communicate with each other here. Each queue must also be
 // declared 'extern' in a header file which will be read by every task that needs to use that queue. The
 // format for all queues except the serial text printing queue is 'frt_queue<type> name (size)', where 'type'
@@ -61,56 +92,121 @@
 
 /** This is a print queue, descended from \c emstream so that things can be printed into the queue using the
  *  "<<" operator and they'll come out the other end as a stream of characters. It's used by tasks that send
- *  things to the user interface task to be printed. 
+ *  things to the user interface task to be printed. Each string printed into it goes in as one block.
  */
 
-TextQueue* p_print_ser_queue;
+StreamBuffer* p_print_ser_queue;
 
 // Shared variables
-TaskShare<int8_t>* sh_power_set_flag;			// Flag share indicating power value has changed
-
-TaskShare<int8_t>* sh_braking_full_flag;		// Flag share indicating full braking requested
+EventGroupHandle_t ev_tasks;			// Wakes the power task and the stages of the pipeline
 
-TaskShare<volatile uint16_t>* sh_encoder_count_1;	// Motor 1 encoder count
-TaskShare<volatile uint16_t>* sh_encoder_count_2;	// Motor 1 encoder count
+NotifyShare<int8_t>* sh_power_set_flag;			// Flag share indicating power value has changed
 
-TaskShare<volatile uint8_t>* sh_encoder_old_state_1;	// Motor 1 encoder previous state
-TaskShare<volatile uint8_t>* sh_encoder_new_state_1;	// Motor 1 encoder next state
+NotifyShare<int8_t>* sh_braking_full_flag;		// Flag share indicating full braking requested
 
-TaskShare<volatile uint8_t>* sh_encoder_old_state_2;	// Motor 2 encoder previous state
-TaskShare<volatile uint8_t>* sh_encoder_new_state_2;	// Motor 2 encoder next state
-
-TaskShare<volatile uint32_t>* sh_motor_1_speed;		// Motor 1 speed
-TaskShare<volatile uint32_t>* sh_motor_2_speed;		// Motor 2 speed
+TaskShare<int32_t>* sh_encoder_position_1;		// Motor 1 encoder position
+TaskShare<int32_t>* sh_encoder_position_2;		// Motor 2 encoder position
+TaskShare<time_stamp>* sh_encoder_edge_time_1;		// Motor 1 encoder most recent edge time
+TaskShare<time_stamp>* sh_encoder_edge_time_2;		// Motor 2 encoder most recent edge time
 
 TaskShare<uint16_t>* sh_encoder_error_count_1;		// Motor 1 tick jump error count
 TaskShare<uint16_t>* sh_encoder_error_count_2;		// Motor 2 tick jump error count
 
-TaskShare<int32_t>* sh_setpoint_1;			// Motor 1
-TaskShare<int32_t>* sh_setpoint_2;			// Motor 2
+SharedBlock<motor_block_t>* sh_motors;			// Motor setpoints, speeds and PID powers
 
-TaskShare<int16_t>* sh_PID_1_power;			// Motor 1 Power values from PID control
-TaskShare<int16_t>* sh_PID_2_power;			// Motor 2 Power values from PID control
+SharedBlock<route_block_t>* sh_route;			// Route being followed and its parameters
 
-TaskShare<uint8_t>* sh_PID_control;			// Flag to indicate PID control enabled
+SharedBlock<imu_block_t>* sh_imu;			// Euler heading and IMU status request
 
 TaskShare<uint16_t>* sh_servo_setpoint;			// Servo motor position setpoint
 
-TaskShare <uint8_t>* sh_path_radius;			// Circular path radius
-
-TaskShare <uint8_t>* sh_circular_start;			// Circular route initialization flag
-
-TaskShare <uint8_t>* sh_path_velocity;			// Route path velocity
-
-TaskShare <uint8_t>* sh_linear_start;			// Linear route initialization flag
-
-TaskShare <uint16_t>* sh_linear_distance;		// Linear route distance
-
-TaskShare <int32_t>* sh_heading_setpoint;		// Heading setpoint for linear path control
-
-TaskShare <int32_t>* sh_euler_heading;			// Euler heading
-
-TaskShare <uint8_t>* sh_imu_status;			// IMU status check flag
+SharedBlock<latency_block_t>* sh_latency;		// Sample time and delays to the outputs
+
+
+// The memory in which the serial port, queue, shares and tasks are built, and the tasks' stacks. When
+// STATIC_ALLOCATION is 1 the linker lays all of this out, and 'make ramreport' lists it by name; when it's 0
+// everything is made with new, as it used to be. FreeRTOS still puts each task's control block, the print
+// queue's buffer and the event group on the heap
+static StaticStore<rs232> store_ser_port;
+static StaticStore<StreamBuffer> store_print_ser_queue;
+static StaticStore<NotifyShare<int8_t> > store_power_set_flag;
+static StaticStore<NotifyShare<int8_t> > store_braking_full_flag;
+static StaticStore<TaskShare<int32_t> > store_encoder_position_1;
+static StaticStore<TaskShare<int32_t> > store_encoder_position_2;
+static StaticStore<TaskShare<time_stamp> > store_encoder_edge_time_1;
+static StaticStore<TaskShare<time_stamp> > store_encoder_edge_time_2;
+static StaticStore<TaskShare<uint16_t> > store_encoder_error_count_1;
+static StaticStore<TaskShare<uint16_t> > store_encoder_error_count_2;
+static StaticStore<SharedBlock<motor_block_t> > store_motors;
+static StaticStore<SharedBlock<route_block_t> > store_route;
+static StaticStore<SharedBlock<imu_block_t> > store_imu;
+static StaticStore<TaskShare<uint16_t> > store_servo_setpoint;
+static StaticStore<SharedBlock<latency_block_t> > store_latency;
+
+static StaticStore<task_user> store_user;
+static TaskStack<280> stack_user;
+static StaticStore<task_power> store_power;
+static StaticStore<task_control> store_control;
+static StaticStore<task_sensor> store_sensor;
+static StaticStore<task_steer> store_steer;
+
+#if CYCLIC_EXECUTIVE
+static StaticStore<CyclicExecutive> store_cyclic;
+static TaskStack<380> stack_cyclic;
+#else
+static StaticStore<CyclicTask> store_power_task;
+static StaticStore<CyclicTask> store_control_task;
+static StaticStore<CyclicTask> store_sensor_task;
+static StaticStore<CyclicTask> store_steer_task;
+static TaskStack<280> stack_power;
+static TaskStack<350> stack_control;
+static TaskStack<280> stack_sensor;
+static TaskStack<280> stack_steer;
+#endif
+
+#if TELEMETRY
+static StaticStore<rs232> store_telem_port;
+static StaticStore<Telemetry> store_telemetry;
+static StaticStore<TaskQueue<log_entry_t> > store_log_queue;
+static TaskStack<240> stack_telemetry;
+#endif
+
+#if STATIC_ALLOCATION
+/// The RAM taken by the holders above, which the FreeRTOS heap is made smaller by to make up for it
+const size_t STATIC_RAM_USED = sizeof (store_ser_port) + sizeof (store_print_ser_queue)
+	+ sizeof (store_power_set_flag) + sizeof (store_braking_full_flag)
+	+ sizeof (store_encoder_position_1) + sizeof (store_encoder_position_2)
+	+ sizeof (store_encoder_edge_time_1) + sizeof (store_encoder_edge_time_2)
+	+ sizeof (store_encoder_error_count_1) + sizeof (store_encoder_error_count_2)
+	+ sizeof (store_motors) + sizeof (store_route) + sizeof (store_imu) + sizeof (store_servo_setpoint)
+	+ sizeof (store_latency)
+	+ sizeof (store_user) + sizeof (stack_user) + sizeof (store_power) + sizeof (store_control)
+	+ sizeof (store_sensor) + sizeof (store_steer)
+#if CYCLIC_EXECUTIVE
+	+ sizeof (store_cyclic) + sizeof (stack_cyclic)
+#else
+	+ sizeof (store_power_task) + sizeof (store_control_task) + sizeof (store_sensor_task)
+	+ sizeof (store_steer_task) + sizeof (stack_power) + sizeof (stack_control) + sizeof (stack_sensor)
+	+ sizeof (stack_steer)
+#endif
+#if TELEMETRY
+	+ sizeof (store_telem_port) + sizeof (store_telemetry) + sizeof (store_log_queue)
+	+ sizeof (stack_telemetry)
+#endif
+	;
+
+/** This template checks that the heap is made smaller by what the holders take, give or take a little for
+ *  alignment; if the heap were made smaller by less, the program would use more RAM than it did with new,
+ *  and if by more, the heap would be short. When the check fails, the compiler's error message shows both
+ *  numbers as the template's parameters, and configSTATIC_RAM_SIZE should be set to the first.
+ */
+template <size_t USED, size_t RESERVED> struct static_ram_check
+{
+	static_assert (RESERVED >= USED && RESERVED - USED < 32,
+		       "configSTATIC_RAM_SIZE in FreeRTOSConfig.h doesn't match the RAM the static holders use");
+};
+template struct static_ram_check<STATIC_RAM_USED, configSTATIC_RAM_SIZE>;
+#endif
 
 
 //===========================================================================================================
@@ -126,89 +222,95 @@ int main (void)
      wdt_disable ();
 
      // Configure a serial port.
-     rs232* p_ser_port = new rs232 (9600, 0);
+     rs232* p_ser_port = store_ser_port.create (9600, 0);
      
      // Print a starting line to display program information
      *p_ser_port << clrscr << PMS ("-------- ME405 Lab 5 Starting Program --------") << endl;
 
      // Create the queues and other shared data items here
-     p_print_ser_queue = new TextQueue (32, "Print", p_ser_port, 30);
+     p_print_ser_queue = store_print_ser_queue.create (32, "Print", p_ser_port, 30);
      
-     // Create a motor power variable share and flag to indicate a power value change
-     sh_power_set_flag = new TaskShare<int8_t> ("sh_power_set_flag");
+     // Create a motor power flag to indicate a power value change, and the event group through which it
+     // and the braking flag wake the power task
+     ev_tasks = xEventGroupCreate ();
+     sh_power_set_flag = store_power_set_flag.create ("sh_power_set_flag", ev_tasks, EV_POWER_SET);
      
      // Create a flag to indicate a full braking requested
-     sh_braking_full_flag = new TaskShare<int8_t> ("sh_braking_full_flag");
+     sh_braking_full_flag = store_braking_full_flag.create ("sh_braking_full_flag", ev_tasks, EV_BRAKING_FULL);
      
-     // Create encoder counters for motor 1 and motor 2
-     sh_encoder_count_1 = new TaskShare<volatile uint16_t> ("sh_encoder_count_1");
-     sh_encoder_count_2 = new TaskShare<volatile uint16_t> ("sh_encoder_count_2");
-     
-     // Create motor 1 shares for previous and new states to determine direction and tick skips
-     sh_encoder_old_state_1 = new TaskShare<volatile uint8_t> ("sh_encoder_old_state_1") ;
-     sh_encoder_new_state_1 = new TaskShare<volatile uint8_t> ("sh_encoder_new_state_1");
-
-     // Create motor 2 shares for previous and new states to determine direction and tick skips
-     sh_encoder_old_state_2 = new TaskShare<volatile uint8_t> ("sh_encoder_old_state_2");
-     sh_encoder_new_state_2 = new TaskShare<volatile uint8_t> ("sh_encoder_new_state_2");
-     
-     // Create motor 1 and 2 speed variables
-     sh_motor_1_speed = new TaskShare<volatile uint32_t> ("sh_motor_1_speed"); // Motor 1
-     sh_motor_2_speed = new TaskShare<volatile uint32_t> ("sh_motor_2_speed"); // Motor 2
+     // Create encoder positions for motor 1 and motor 2
+     sh_encoder_position_1 = store_encoder_position_1.create ("sh_encoder_position_1");
+     sh_encoder_position_2 = store_encoder_position_2.create ("sh_encoder_position_2");
+     sh_encoder_edge_time_1 = store_encoder_edge_time_1.create ("sh_encoder_edge_time_1");
+     sh_encoder_edge_time_2 = store_encoder_edge_time_2.create ("sh_encoder_edge_time_2");
      
      // Create encoder tick jump error counts for motor 1 and motor 2
-     sh_encoder_error_count_1 = new TaskShare<uint16_t> ("sh_encoder_error_count_1");
-     sh_encoder_error_count_2 = new TaskShare<uint16_t> ("sh_encoder_error_count_2");
+     sh_encoder_error_count_1 = store_encoder_error_count_1.create ("sh_encoder_error_count_1");
+     sh_encoder_error_count_2 = store_encoder_error_count_2.create ("sh_encoder_error_count_2");
      
-     // Motor PID setpoints
-     sh_setpoint_1 = new TaskShare<int32_t> ("sh_setpoint_1");			// Motor 1
-     sh_setpoint_2 = new TaskShare<int32_t> ("sh_setpoint_2");			// Motor 2
+     // Motor setpoints, speeds and power values from PID control
+     sh_motors = store_motors.create ("sh_motors");
 
-     // Motor Power values from PID control
-     sh_PID_1_power = new TaskShare<int16_t> ("sh_PID_1_power");		// Motor 1
-     sh_PID_2_power = new TaskShare<int16_t> ("sh_PID_2_power");		// Motor 2
+     // Route control mode, initialization flags, path velocity, radius and distance, and heading setpoint
+     sh_route = store_route.create ("sh_route");
 
-     // Flag to indicate PID control enabled
-     sh_PID_control = new TaskShare<uint8_t> ("sh_PID_control");
+     // Current IMU heading (Euler coordinates) and IMU status check flag
+     sh_imu = store_imu.create ("sh_imu");
 
      // Servo motor position setpoint
-     sh_servo_setpoint = new TaskShare<uint16_t> ("sh_servo_setpoint");		
-     
-     // Circular path radius value
-     sh_path_radius = new TaskShare<uint8_t> ("sh_path_radius");
-     
-     // Circular route initialization flag
-     sh_circular_start = new TaskShare<uint8_t> ("sh_circular_start");
-     
-     // Linear route initialization flag
-     sh_linear_start = new TaskShare<uint8_t> ("sh_linear_start");
-     
-     // Linear route distance
-     sh_linear_distance = new TaskShare<uint16_t> ("sh_linear_distance");
-     
-     // Current IMU heading (Euler coordinates)
-     sh_euler_heading = new TaskShare<int32_t> ("sh_euler_heading");
-     
-     // Route feature initial IMU heading (Euler coordinates)
-     sh_heading_setpoint = new TaskShare <int32_t> ("sh_heading_setpoint");
-     
-     // IMU status check flag
-     sh_imu_status = new TaskShare<uint8_t> ("sh_imu_status");
+     sh_servo_setpoint = store_servo_setpoint.create ("sh_servo_setpoint");		
+
+     // Time of the newest sensor sample and the delays from it to the motor and servo outputs
+     sh_latency = store_latency.create ("sh_latency");
 
      // Creating a task that operates the serial user interface and accepts feature inputs
-     new task_user    ("UserInterface", task_priority(1), 280, p_ser_port);
-     
-     // Creating a task that operates the motors and encoders 
-     new task_power   ("Power        ", task_priority(4), 280, p_ser_port);
-     
-     // Creating a task that operates motor PID and feature computation/execution
-     new task_control ("Control      ", task_priority(3), 350, p_ser_port);
-     
-     // Creating a task that configures and operates the IMU and both IR sensors 
-     new task_sensor  ("Sensor       ", task_priority(2), 280, p_ser_port);
+     store_user.create ("UserInterface", task_priority(1), stack_user.size (), p_ser_port, stack_user.buffer ());
      
-     // Creating a task that configures and operate  the servo-powered motor
-     new task_steer   ("Steering     ", task_priority(4), 280, p_ser_port);
+     // The periodic steps: the motors and encoders, the motor PID and feature computation/execution, the IMU
+     // and both IR sensors, and the servo-powered steering
+     task_power*   p_power   = store_power.create   ("Power        ", p_ser_port);
+     task_control* p_control = store_control.create ("Control      ", p_ser_port);
+     task_sensor*  p_sensor  = store_sensor.create  ("Sensor       ", p_ser_port);
+     task_steer*   p_steer   = store_steer.create   ("Steering     ", p_ser_port);
+
+#if CYCLIC_EXECUTIVE
+     // One task runs all the steps every 10 ms, in an order which passes each sample straight through to the
+     // motor and servo outputs. Its stack needs only be big enough for the hungriest step, the control step
+     CyclicExecutive* p_cyclic = store_cyclic.create ("Cyclic       ", task_priority(4), stack_cyclic.size (),
+							p_ser_port, 10, stack_cyclic.buffer ());
+     p_cyclic->add (p_sensor);
+     p_cyclic->add (p_power);
+     p_cyclic->add (p_control);
+     p_cyclic->add (p_steer);
+#else
+     // Each step runs in a task of its own. With PIPELINE_TASKS set the sensor task starts each period, and
+     // the power, control and steering tasks follow it in turn
+     store_power_task.create   (p_power,   10, task_priority(4), stack_power.size (), p_ser_port,
+				stack_power.buffer ());
+     store_control_task.create (p_control, 10, task_priority(3), stack_control.size (), p_ser_port,
+				stack_control.buffer ());
+     store_sensor_task.create  (p_sensor,  10, task_priority(2), stack_sensor.size (), p_ser_port,
+				stack_sensor.buffer ());
+     store_steer_task.create   (p_steer,   10, task_priority(4), stack_steer.size (), p_ser_port,
+				stack_steer.buffer ());
+#endif
+
+#if TELEMETRY
+     // The telemetry port drops characters rather than waiting when it's full, so the telemetry task can
+     // never be held up; a record which loses a character fails its CRC and is skipped by the decoder
+     rs232* p_telem_port = store_telem_port.create (57600, 1);
+     p_telem_port->set_tx_full_policy (RSINT_TX_DROP);
+     Telemetry* p_telemetry = store_telemetry.create ("Telemetry    ", task_priority(1), stack_telemetry.size (),
+							p_ser_port, p_telem_port, 10, stack_telemetry.buffer ());
+     p_telemetry->add (sh_encoder_position_1, "position_1");
+     p_telemetry->add (sh_encoder_position_2, "position_2");
+     p_telemetry->add (sh_servo_setpoint, "servo_setpoint");
+     p_telemetry->add (sh_encoder_error_count_1, "errors_1");
+     p_telemetry->add (sh_encoder_error_count_2, "errors_2");
+
+     // Log entries are never waited for; when the queue is full, log_id() drops them
+     p_log_queue = store_log_queue.create (8, "Log", p_ser_port, 0);
+#endif
 
      // The RTOS scheduler, ran indefinetly:
      vTaskStartScheduler ();
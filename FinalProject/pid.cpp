@@ -8,6 +8,10 @@
  * 			 Changed names of everything to be a bit more intuitive
  * 			 Moved enum and struct definitions inside class
  *    \li May 4, 2016 -- BKK Added original file
+ *    \li 10-17-2026 ME405 Group 3 Gains are applied with Q10 shifts instead of division by 1024
+ *    \li 10-17-2026 ME405 Group 3 Constructor clears dinput and saturation
+ *    \li 10-17-2026 ME405 Group 3 Added the 32-bit integrator option
+ *    \li 10-17-2026 ME405 Group 3 Integral gain shift is limited to MAX_ISHIFT
  *
  *  License:
  *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
@@ -30,13 +34,16 @@
  */
 pid::pid (emstream* p_serial_port):
 	p_serial(p_serial_port),
-	config{OFF,0,0,0,0,INT16_MIN,INT16_MAX},
+	config{OFF,0,0,0,0,INT16_MIN,INT16_MAX,0},
 	input(0),
 	output(0),
 	setpoint(0),
 	error(0),
 	linput(0),
-	esum(0)
+	dinput(0),
+	esum(0),
+	esum32(0),
+	saturation(0)
 {
 }
 
@@ -50,6 +57,7 @@ void pid::set_mode(mode_t my_mode)
 {
 	config.mode=my_mode;
 	esum=0;
+	esum32=0;
 }
 
 //-----------------------------------------------------------------------------------------------------------
@@ -87,12 +95,18 @@ void pid::set_setpoint(int16_t my_setpoint)
 
 //-----------------------------------------------------------------------------------------------------------
 /** \brief Updates the PID configuration and clears esum, resetting the PID controller
+ *  \details An @c ishift above @c MAX_ISHIFT is limited to @c MAX_ISHIFT.
  *  @param my_config New controller configuration
  */
 void pid::set_config(config_t my_config)
 {
 	config=my_config;
+	if (config.ishift > MAX_ISHIFT)
+	{
+		config.ishift=MAX_ISHIFT;
+	}
 	esum=0;
+	esum32=0;
 }
 
 //-----------------------------------------------------------------------------------------------------------
@@ -148,6 +162,19 @@ void pid::set_saturator(int16_t min, int16_t max)
 	config.max=max;
 }
 
+//-----------------------------------------------------------------------------------------------------------
+/** \brief Selects the integrator and clears the error sums, resetting the integral action
+ *  @param ishift The number of extra fraction bits in the integral gain, from 1 to @c MAX_ISHIFT, which
+ *		  selects the 32-bit integrator; or 0 for the 16-bit integrator. Larger values are limited to
+ *		  @c MAX_ISHIFT, as the integrator's shift by 10 + @c ishift must stay below 31 bits
+ */
+void pid::set_ishift(uint8_t ishift)
+{
+	config.ishift=(ishift > MAX_ISHIFT) ? MAX_ISHIFT : ishift;
+	esum=0;
+	esum32=0;
+}
+
 //-----------------------------------------------------------------------------------------------------------
 /** \brief Gets the current mode of the PID
  *  @return The current PID mode
@@ -247,6 +274,30 @@ int16_t pid::get_saturator_max()
 	return config.max;
 }
 
+//-----------------------------------------------------------------------------------------------------------
+/** \brief Gets the number of extra fraction bits in the integral gain
+ *  @return The integral gain's extra fraction bits, or 0 if the 16-bit integrator is used
+ */
+uint8_t pid::get_ishift()
+{
+	return config.ishift;
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief Finds the output of the integral action
+ *  \details With the 16-bit integrator this is Ki times the error sum. The 32-bit integrator already
+ *	     holds Ki times the error sum, with 10 + @c ishift fraction bits, so it only has to be shifted.
+ *  @return The integral action's part of the output
+ */
+int16_t pid::integral()
+{
+	if (config.ishift)
+	{
+		return ssshrv(esum32, 10 + config.ishift);
+	}
+	return q10_t::mul(config.Ki,esum);
+}
+
 //-----------------------------------------------------------------------------------------------------------
 /** \brief Computes the new PID output value
  *  \details This method uses new actual and reference values to compute the controller output value. 
@@ -275,7 +326,16 @@ int16_t pid::compute()
 	error = setpoint - input;
 	
 	// Integrate the error and subtract the current saturation value multiplied by the anti-windup gain.
-	esum  = sssub(ssadd(esum,error), ssdiv(ssmul(config.Kw,saturation),1024));
+	// The 32-bit integrator sums Ki times these, so its anti-windup subtracts Ki*Kw*saturation
+	if (config.ishift)
+	{
+		esum32 = sssub32(ssadd32(esum32, ssmul(config.Ki,error)),
+				 ssmul(config.Ki, q10_t::mul(config.Kw,saturation)));
+	}
+	else
+	{
+		esum  = sssub(ssadd(esum,error), q10_t::mul(config.Kw,saturation));
+	}
 	
 	// Compute output based on current PID mode
 	switch(config.mode)
@@ -287,24 +347,24 @@ int16_t pid::compute()
 		
 		// Proportional only	
 		case P:
-			temp = ssdiv(ssmul(config.Kp,error),1024);
+			temp = q10_t::mul(config.Kp,error);
 			break;
 		
 		// Proportional and integral	
 		case PI:
-			temp = ssadd(ssdiv(ssmul(config.Ki,esum),1024), ssdiv(ssmul(config.Kp,error),1024));
+			temp = ssadd(integral(), q10_t::mul(config.Kp,error));
 			break;
 		
 		// Proportional and Derivative
 		case PD:
-			temp = ssadd(ssdiv(ssmul(config.Kd,dinput),1024),ssdiv(ssmul(config.Kp,error),1024));
+			temp = ssadd(q10_t::mul(config.Kd,dinput),q10_t::mul(config.Kp,error));
 			break;
 		
 		// Full PID	
 		case PID:
-			temp = ssadd(ssdiv(ssmul(config.Ki,esum),1024),
-				   ssadd(ssdiv(ssmul(config.Kd,dinput),1024),
-					ssdiv(ssmul(config.Kp,error),1024)));
+			temp = ssadd(integral(),
+				   ssadd(q10_t::mul(config.Kd,dinput),
+					q10_t::mul(config.Kp,error)));
 			break;
 		
 		// Manual mode (keep the current control value)	
@@ -352,7 +412,9 @@ emstream& operator << (emstream& serpt, pid& pid)
 		<< "\t1024*Ki = " << dec << pid.get_Ki() << endl
 		<< "\t1024*Kp = " << dec << pid.get_Kp() << endl
 		<< "\t1024*Kd = " << dec << pid.get_Kd() << endl
-		<< "\t1024*Kw = " << dec << pid.get_Kw() << endl;
+		<< "\t1024*Kw = " << dec << pid.get_Kw() << endl
+	      << "Integrator: " << (pid.get_ishift() ? "32-bit" : "16-bit")
+		<< ", Ki shift " << dec << pid.get_ishift() << endl;
 
 	return (serpt);
 }
\ No newline at end of file
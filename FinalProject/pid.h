@@ -8,6 +8,8 @@
  * 			 Changed names of everything to be a bit more intuitive
  * 			 Moved enum and struct definitions inside class
  *    \li May 4, 2016 -- BKK Added original file
+ *    \li 10-17-2026 ME405 Group 3 Added the 32-bit integrator option
+ *    \li 10-17-2026 ME405 Group 3 Added MAX_ISHIFT, the limit of the integral gain shift
  *
  *  License:
  *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
@@ -26,6 +28,7 @@
 
 #include "emstream.h"                       // Header for serial ports and devices
 #include "satmath.h"			    // Header for saturated math library
+#include "fixed.h"			    // Header for fixed point gains
 
 
 //-----------------------------------------------------------------------------------------------------------
@@ -71,7 +74,16 @@
  *           controller to PI mode with gains Ki=5, Kp=2, and Kw=1. Remember that the gains are entered as
  *           1024 times the desired gain to increase resolution. Additionally, we will set the output
  *           saturator values to +/- 1600. \n
- *           @c motor_pid->set_config(pid::config_t{PI,5120,2048,0,1024,-1600,1600});\n
+ *           @c motor_pid->set_config(pid::config_t{PI,5120,2048,0,1024,-1600,1600,0});\n
+ *           The last item in the configuration, @c ishift, selects the integrator. When it's zero the error
+ *           sum is a 16-bit number, which saturates after the error has been summed for a short time.
+ *           When it's from 1 to 20 a 32-bit integrator is used instead, and the integral gain is Ki
+ *           divided by 1024 * 2^ishift rather than by 1024, so much smaller integral gains can be used.
+ *           This integrator sums Ki times the error rather than the error, so Ki may be changed without
+ *           a bump in the output, and its output is found with shifts, not division. The anti-windup
+ *           gain Kw has the same meaning in both integrators. For example, an integral gain of 0.01 is
+ *           1024 * 0.01 = 10.24 with the 16-bit integrator, but with @c ishift set to 6 it's entered as
+ *           655 and is then 655 / 65536 = 0.009995.\n
  *           Now, to run the PID, we must call compute() inside a loop (probably a task) running at a fixed interval.
  *           Changing the delay of the task will change the effect of the Ki and Kd gains.
  *           Suppose we have three @c int16_t shares @c motor_speed, @c motor_setpoint, and @c motor_power.
@@ -106,8 +118,12 @@ typedef struct config {
 	int16_t		Kw;			//!< (1024x) Anti-windup Gain
 	int16_t		min;			//!< Minimum control value for saturator
 	int16_t		max;			//!< Maximum control value for saturator
+	uint8_t		ishift;			//!< Extra integral gain fraction bits, or 0 for 16-bit integrator
 } config_t;	
 
+/// The largest @c ishift; the 32-bit integrator is shifted right by 10 + @c ishift, which must be under 31
+static const uint8_t MAX_ISHIFT = 20;
+
 	
 protected:
 	emstream*	p_serial;		//!< Serial port pointer, used to say hello
@@ -119,8 +135,12 @@ protected:
 	int16_t		linput;			//!< Last input to use for derivative computation
 	int16_t		dinput;			//!< Difference in input value for derivative gain
 	int16_t		esum;			//!< Error Sum
+	int32_t		esum32;			//!< Sum of Ki * error for the 32-bit integrator
 	int16_t		saturation;		//!< Saturator value
 
+	// Finds the output of the integral action from whichever integrator is in use
+	int16_t integral();
+
 public:
 	// The constructor sets up the pid for use
 	pid (emstream*);
@@ -136,6 +156,7 @@ public:
 	void set_Kd(int16_t Kd);
 	void set_Kw(int16_t Kw);
 	void set_saturator(int16_t min, int16_t max);
+	void set_ishift(uint8_t ishift);
 
 	// Get methods
 	mode_t get_mode();
@@ -149,6 +170,7 @@ public:
 	int16_t get_Kw();
 	int16_t get_saturator_min();
 	int16_t get_saturator_max();
+	uint8_t get_ishift();
 
 	// Compute method calculates pid controller output value
 	int16_t compute();
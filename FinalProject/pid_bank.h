@@ -0,0 +1,132 @@
+//===========================================================================================================
+/** \file pid_bank.h
+ *    This file contains a bank of PID controllers which share one mode, one set of gains and one pair of
+ *    saturator limits, and which are all updated by one call.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//===========================================================================================================
+
+// This define prevents this .H file from being included multiple times in a .CPP file
+#ifndef _PID_BANK_H_
+#define _PID_BANK_H_
+
+#include <stdint.h>
+#include "pid_fixed.h"			    // PID arithmetic with gains fixed at compile time
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This class runs @c N 16-bit fixed point PID loops which have the same mode and gains
+ *  \details Each channel gives exactly the same outputs as a @c pid_fixed with the same template
+ *	     parameters, but the state of the channels is kept in arrays (input, last input, error sum,
+ *	     saturation, output), one array per quantity, and all channels are updated in one call to
+ *	     @c compute(). The gains are compile time constants, so they cost no memory loads at all, and
+ *	     the outputs of all the channels are saturated together in one pass after the PID terms have
+ *	     been found. Adding a loop to a bank costs only its own arithmetic rather than another object,
+ *	     another call and another copy of the saturation code.\n
+ *	     The two drive motors' PI loops with an output range of +/- 1600 are run by: \n
+ *	     @c pid_bank<2, @c pid::PI, @c 1024, @c 256, @c 0, @c 256> @c motor_pids(-1600, @c 1600);\n
+ *	     @c motor_pids.compute(speeds, @c setpoints);\n
+ *	     after which @c motor_pids.get_output(0) and @c motor_pids.get_output(1) are the motor powers.
+ */
+template <uint8_t N, pid::mode_t MODE, int16_t KP, int16_t KI = 0, int16_t KD = 0, int16_t KW = 0>
+class pid_bank
+{
+protected:
+	int16_t		min;			//!< Minimum control value for saturator, shared by all channels
+	int16_t		max;			//!< Maximum control value for saturator, shared by all channels
+	int16_t		input[N];		//!< The values being controlled
+	int16_t		linput[N];		//!< Last inputs to use for derivative computation
+	int16_t		esum[N];		//!< Error sums
+	int16_t		saturation[N];		//!< Saturator values
+	int16_t		output[N];		//!< The controller outputs
+
+	/// True if this bank's mode has integral action
+	static const bool HAS_I = (MODE == pid::PI || MODE == pid::PID);
+
+public:
+	/** \brief This constructor sets up a bank of PID controllers with the given saturator limits
+	 *  @param a_min Minimum control value for the saturator (default: INT16_MIN)
+	 *  @param a_max Maximum control value for the saturator (default: INT16_MAX)
+	 */
+	pid_bank (int16_t a_min = INT16_MIN, int16_t a_max = INT16_MAX)
+		: min (a_min), max (a_max)
+	{
+		for (uint8_t ch = 0; ch < N; ch++)
+		{
+			input[ch] = 0;
+			linput[ch] = 0;
+			esum[ch] = 0;
+			saturation[ch] = 0;
+			output[ch] = 0;
+		}
+	}
+
+	/** \brief Updates the upper and lower saturator values and clears the error sums
+	 *  @param a_min New minimum value
+	 *  @param a_max New maximum value
+	 */
+	void set_saturator (int16_t a_min, int16_t a_max)
+	{
+		min = a_min;
+		max = a_max;
+		for (uint8_t ch = 0; ch < N; ch++)
+		{
+			esum[ch] = 0;
+		}
+	}
+
+	/** \brief Manually updates one channel's output value, which is kept in @c pid::MANUAL mode
+	 *  @param ch The channel number, from 0 to N - 1
+	 *  @param a_output New controller output value
+	 */
+	void set_output (uint8_t ch, int16_t a_output) { output[ch] = a_output; }
+
+	/** \brief Gets one channel's output value
+	 *  @param ch The channel number, from 0 to N - 1
+	 *  @return The channel's output
+	 */
+	int16_t get_output (uint8_t ch) const { return output[ch]; }
+
+	/// Gets the number of channels in this bank
+	uint8_t channels (void) const { return N; }
+
+	/** \brief Computes the new output values of all the channels
+	 *  @param new_input An array of @c N new inputs, the values being controlled
+	 *  @param new_setpoint An array of @c N new setpoints, the desired values for the inputs
+	 */
+	void compute (const int16_t* new_input, const int16_t* new_setpoint)
+	{
+		// Find each channel's PID terms
+		for (uint8_t ch = 0; ch < N; ch++)
+		{
+			linput[ch] = input[ch];
+			input[ch] = new_input[ch];
+			output[ch] = pid_fixed_terms<MODE, KP, KI, KD, KW> (input[ch], linput[ch], new_setpoint[ch],
+									  output[ch], esum[ch], saturation[ch]);
+		}
+
+		// Then saturate all the outputs, storing the amounts saturated for anti-windup feedback
+		for (uint8_t ch = 0; ch < N; ch++)
+		{
+			int16_t temp = output[ch];
+			if (temp > max)
+			{
+				saturation[ch] = HAS_I ? sssub(temp, max) : 0;
+				output[ch] = max;
+			}
+			else if (temp < min)
+			{
+				saturation[ch] = HAS_I ? sssub(temp, min) : 0;
+				output[ch] = min;
+			}
+			else
+			{
+				saturation[ch] = 0;
+			}
+		}
+	}
+};
+
+#endif // _PID_BANK_H_
@@ -0,0 +1,203 @@
+//===========================================================================================================
+/** \file pid_fixed.h
+ *    This file contains a PID controller template whose mode and gains are fixed when the program is
+ *    compiled, so that only the arithmetic its mode needs is generated.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//===========================================================================================================
+
+// This define prevents this .H file from being included multiple times in a .CPP file
+#ifndef _PID_FIXED_H_
+#define _PID_FIXED_H_
+
+#include <stdint.h>
+#include "satmath.h"			    // Header for saturated math library
+#include "fixed.h"			    // Header for fixed point gains
+#include "pid.h"			    // The run-time PID, whose modes are used here
+
+
+/** \brief This function finds the base two logarithm of a power of two, for use at compile time
+ *  @param k A power of two
+ *  @return The number n for which 2^n is k
+ */
+constexpr uint8_t pid_log2 (int16_t k)
+{
+	return (k <= 1) ? 0 : 1 + pid_log2 (k >> 1);
+}
+
+/** \brief This function multiplies an integer by a Q10 gain which is known when the program is compiled
+ *  \details The result is always the same as @c q10_t::mul(K,x). Gains of zero and one cost nothing, and
+ *	     gains which are powers of two no larger than one become a 16-bit shift which rounds toward zero
+ *	     just as the division in the run-time @c pid does. Other gains use a 16 by 16 bit multiplication
+ *	     and a shift by a constant.
+ *  @param x The integer to be multiplied by the gain
+ *  @return The product, rounded toward zero and saturated to 16 bits
+ */
+template <int16_t K> inline int16_t pid_gain (int16_t x)
+{
+	if (K == 0)
+	{
+		return 0;
+	}
+	else if (K == q10_t::ONE)
+	{
+		return x;
+	}
+	else if (K > 0 && K < q10_t::ONE && (K & (K - 1)) == 0)
+	{
+		// Shifting by 10 - log2(K) divides by the reciprocal of the gain
+		const uint8_t shift = 10 - pid_log2 (K);
+		if (x < 0) x += (1 << shift) - 1;
+		return x >> shift;
+	}
+	else if (K == INT16_MIN)
+	{
+		// Only this gain can overflow the 32-bit product, so let ssmul() saturate it
+		return q10_t::mul (K, x);
+	}
+	return ssshr((int32_t)K * x, 10);
+}
+
+
+/** \brief This function finds the unsaturated output of a PID whose mode and gains are fixed at compile time
+ *  \details It holds the arithmetic shared by @c pid_fixed and @c pid_bank. The terms are added in the same
+ *	     order as in @c pid::compute(), as saturated addition isn't associative, and the error sum is only
+ *	     updated in modes with integral action.
+ *  @param input The new input, which is the value being controlled
+ *  @param linput The previous input, used for the derivative
+ *  @param setpoint The desired value for the input
+ *  @param output The previous output, which is kept in @c pid::MANUAL mode
+ *  @param esum A reference to the error sum, which is updated
+ *  @param saturation The amount by which the previous output was saturated
+ *  @return The new output before it's saturated
+ */
+template <pid::mode_t MODE, int16_t KP, int16_t KI, int16_t KD, int16_t KW>
+inline int16_t pid_fixed_terms (int16_t input, int16_t linput, int16_t setpoint, int16_t output,
+				int16_t& esum, int16_t saturation)
+{
+	if (MODE == pid::OFF)
+	{
+		return 0;
+	}
+	else if (MODE == pid::MANUAL)
+	{
+		return output;
+	}
+
+	int16_t error = setpoint - input;
+	int16_t temp = pid_gain<KP> (error);
+	if (MODE == pid::PD || MODE == pid::PID)
+	{
+		temp = ssadd(pid_gain<KD> (sssub(input, linput)), temp);
+	}
+	if (MODE == pid::PI || MODE == pid::PID)
+	{
+		esum = sssub(ssadd(esum, error), pid_gain<KW> (saturation));
+		temp = ssadd(pid_gain<KI> (esum), temp);
+	}
+	return temp;
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This class runs a 16-bit fixed point PID whose mode and gains are template parameters
+ *  \details It works just like class @c pid, and for the same inputs it gives exactly the same outputs,
+ *	     but the mode and the (1024x) gains are fixed when the program is compiled. The compiler then
+ *	     leaves out the @c switch on the mode, skips the integral and anti-windup arithmetic in modes
+ *	     which have no integral action, skips the derivative in modes without one, and turns gains of
+ *	     0, 1024 and powers of two into nothing or simple shifts. Only the saturator limits are set at
+ *	     run time. Use class @c pid instead when the gains must be tuned while the program runs.\n
+ *	     A PI controller with Kp = 1, Ki = Kw = 0.25 and an output range of +/- 1600 is made by: \n
+ *	     @c pid_fixed<pid::PI, @c 1024, @c 256, @c 0, @c 256> @c motor_pid(-1600, @c 1600);\n
+ *	     and is run every period by: \n
+ *	     @c motor_power->put(motor_pid.compute(motor_speed->get(), motor_setpoint->get()));\n
+ */
+template <pid::mode_t MODE, int16_t KP, int16_t KI = 0, int16_t KD = 0, int16_t KW = 0>
+class pid_fixed
+{
+protected:
+	int16_t		min;			//!< Minimum control value for saturator
+	int16_t		max;			//!< Maximum control value for saturator
+	int16_t		input;			//!< The value being controlled
+	int16_t		output;			//!< The controller output
+	int16_t		setpoint;		//!< Desired reference value for input
+	int16_t		linput;			//!< Last input to use for derivative computation
+	int16_t		esum;			//!< Error Sum
+	int16_t		saturation;		//!< Saturator value
+
+	/// True if this controller's mode has integral action
+	static const bool HAS_I = (MODE == pid::PI || MODE == pid::PID);
+
+public:
+	/** \brief This constructor sets up a PID controller with the given saturator limits
+	 *  @param a_min Minimum control value for the saturator (default: INT16_MIN)
+	 *  @param a_max Maximum control value for the saturator (default: INT16_MAX)
+	 */
+	pid_fixed (int16_t a_min = INT16_MIN, int16_t a_max = INT16_MAX)
+		: min (a_min), max (a_max), input (0), output (0), setpoint (0), linput (0), esum (0),
+		  saturation (0)
+	{
+	}
+
+	/** \brief Updates the upper and lower saturator values and clears the error sum
+	 *  @param a_min New minimum value
+	 *  @param a_max New maximum value
+	 */
+	void set_saturator (int16_t a_min, int16_t a_max)
+	{
+		min = a_min;
+		max = a_max;
+		esum = 0;
+	}
+
+	/** \brief Manually updates the control output value, which is kept in @c pid::MANUAL mode
+	 *  @param a_output New controller output value
+	 */
+	void set_output (int16_t a_output) { output = a_output; }
+
+	/// Gets the controller output value
+	int16_t get_output (void) const { return output; }
+
+	/// Gets the current value of the parameter being controlled by the PID
+	int16_t get_input (void) const { return input; }
+
+	/// Gets the current PID setpoint value
+	int16_t get_setpoint (void) const { return setpoint; }
+
+	/** \brief Computes the new PID output value
+	 *  @param new_input The new input for the controller. This is the value being controlled
+	 *  @param new_setpoint The new setpoint for the controlller. This is the desired value for the input.
+	 *  @return The new output of the PID
+	 */
+	int16_t compute (int16_t new_input, int16_t new_setpoint)
+	{
+		linput = input;
+		input = new_input;
+		setpoint = new_setpoint;
+
+		int16_t temp = pid_fixed_terms<MODE, KP, KI, KD, KW> (input, linput, setpoint, output, esum,
+								     saturation);
+
+		// Saturation, storing the amount saturated for anti-windup feedback
+		if (temp > max)
+		{
+			saturation = HAS_I ? sssub(temp, max) : 0;
+			output = max;
+		}
+		else if (temp < min)
+		{
+			saturation = HAS_I ? sssub(temp, min) : 0;
+			output = min;
+		}
+		else
+		{
+			saturation = 0;
+			output = temp;
+		}
+		return output;
+	}
+};
+
+#endif // _PID_FIXED_H_
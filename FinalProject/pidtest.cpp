@@ -0,0 +1,267 @@
+//***********************************************************************************************************
+/** \file pidtest.cpp
+ *    This file contains a program for the PC which checks that the PID controller gives the same outputs
+ *    now that its gains are applied with \c fixed<10>::mul(), a multiplication and a shift, as it did when
+ *    they were applied with \c ssdiv(ssmul(K,x),1024), a multiplication and a division.
+ *
+ *    First \c q10_t::mul() is compared with the old expression for every pair of a 16-bit gain and a
+ *    16-bit number. Then a copy of the controller as it was before the change, kept in this file, is run
+ *    beside a \c pid object with the same pseudo-random gains, saturator limits and modes, and the two
+ *    are given the same pseudo-random inputs and setpoints; every output of one is compared with that of
+ *    the other. Only the 16-bit integrator is compared, as the 32-bit one (\c ishift from 1 to 20) came
+ *    after the change and has no older version. The program is built with 'make -f Makefile.host pidtest'
+ *    and run with no arguments; it prints the number of mismatches and returns zero if there were none.
+ *    It also checks that an integral gain shift above \c pid::MAX_ISHIFT is limited to that value.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ *    \li 10-17-2026 ME405 Group 3 Checks the limit on the integral gain shift
+ */
+//***********************************************************************************************************
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+#include <stdio.h>                          // The C library's printf()
+#include <stdint.h>                         // Integer types of given sizes
+
+#include "satmath.h"                        // Saturated math library
+#include "fixed.h"                          // Fixed point gains, the new way of applying them
+#include "pid.h"                            // The PID controller being checked
+
+
+/// The number of controllers, each with its own gains and limits, which are compared
+const uint16_t TEST_CONTROLLERS = 20000;
+
+/// The number of times each controller is run
+const uint16_t TEST_STEPS = 500;
+
+/// The state of the pseudo-random number generator
+static uint32_t test_seed = 12345;
+
+/// The number of outputs which differed
+static uint32_t mismatches = 0;
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function returns the next number from a linear congruential pseudo-random generator.
+ *  @return A pseudo-random 16-bit number
+ */
+
+static int16_t test_random (void)
+{
+	test_seed = test_seed * 1664525UL + 1013904223UL;
+	return ((int16_t)(test_seed >> 16));
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function applies a Q10 gain as the PID controller did before the change, by dividing by 1024.
+ *  @param K The gain, times 1024
+ *  @param x The number to which the gain is applied
+ *  @return The product, saturated to 16 bits
+ */
+
+static int16_t old_mul (int16_t K, int16_t x)
+{
+	return (ssdiv (ssmul (K, x), 1024));
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This class is the PID controller's 16-bit integrator and output computation as they were before
+ *  the gains were applied with shifts, kept here as the reference against which \c pid is checked.
+ */
+
+class old_pid
+{
+	protected:
+		pid::config_t config;               ///< The same configuration as the new controller's
+		int16_t input;                      ///< The value being controlled
+		int16_t output;                     ///< The controller output
+		int16_t linput;                     ///< The last input, for the derivative
+		int16_t dinput;                     ///< The change in the input
+		int16_t esum;                       ///< The error sum
+		int16_t saturation;                 ///< How far the last output was saturated
+
+	public:
+		/** The constructor makes a controller with the given configuration, with its sums cleared.
+		 *  @param a_config The configuration
+		 */
+		old_pid (pid::config_t a_config)
+			: config (a_config), input (0), output (0), linput (0), dinput (0), esum (0), saturation (0)
+		{
+		}
+
+		/** This method computes the output as \c pid::compute() did before the change.
+		 *  @param new_input The value being controlled
+		 *  @param setpoint The value it should have
+		 *  @return The controller output
+		 */
+		int16_t compute (int16_t new_input, int16_t setpoint)
+		{
+			linput = input;
+			input = new_input;
+			dinput = sssub (input, linput);
+
+			int16_t error = setpoint - input;
+			esum = sssub (ssadd (esum, error), old_mul (config.Kw, saturation));
+
+			int16_t temp = 0;
+			switch (config.mode)
+			{
+				case pid::P:
+					temp = old_mul (config.Kp, error);
+					break;
+				case pid::PI:
+					temp = ssadd (old_mul (config.Ki, esum), old_mul (config.Kp, error));
+					break;
+				case pid::PD:
+					temp = ssadd (old_mul (config.Kd, dinput), old_mul (config.Kp, error));
+					break;
+				case pid::PID:
+					temp = ssadd (old_mul (config.Ki, esum),
+								  ssadd (old_mul (config.Kd, dinput), old_mul (config.Kp, error)));
+					break;
+				case pid::MANUAL:
+					temp = output;
+					break;
+				default:
+					temp = 0;
+					break;
+			}
+
+			if (temp > config.max)
+			{
+				saturation = sssub (temp, config.max);
+				output = config.max;
+			}
+			else if (temp < config.min)
+			{
+				saturation = sssub (temp, config.min);
+				output = config.min;
+			}
+			else
+			{
+				saturation = 0;
+				output = temp;
+			}
+			return (output);
+		}
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function compares \c q10_t::mul() with the old expression for every gain and every number.
+ */
+
+static void check_every_product (void)
+{
+	for (int32_t K = INT16_MIN; K <= INT16_MAX; K++)
+	{
+		for (int32_t x = INT16_MIN; x <= INT16_MAX; x++)
+		{
+			int16_t now = q10_t::mul (K, x);
+			int16_t before = old_mul (K, x);
+			if (now != before && mismatches++ < 10)
+			{
+				printf ("q10_t::mul (%d, %d) gave %d, not %d\n", (int)K, (int)x, now, before);
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function runs one new and one old controller with the same pseudo-random configuration and
+ *  inputs, and compares their outputs. Gains are mostly of the size the car uses, but one in four is
+ *  anywhere in the 16-bit range so that the products saturate; the inputs wander and sometimes jump.
+ */
+
+static void check_controller (void)
+{
+	static const pid::mode_t modes[] = { pid::OFF, pid::P, pid::PI, pid::PD, pid::PID };
+
+	pid::config_t config;
+	config.mode = modes[(uint16_t)test_random () % 5];
+	config.Kp = (test_random () & 3) ? test_random () % 8192 : test_random ();
+	config.Ki = (test_random () & 3) ? test_random () % 4096 : test_random ();
+	config.Kd = (test_random () & 3) ? test_random () % 4096 : test_random ();
+	config.Kw = (test_random () & 3) ? test_random () % 2048 : test_random ();
+	int16_t limit = (test_random () & 3) ? (test_random () & 0x0FFF) + 1 : INT16_MAX;
+	config.min = -limit;
+	config.max = limit;
+	config.ishift = 0;
+
+	pid now (NULL);
+	now.set_config (config);
+	old_pid before (config);
+
+	int16_t input = 0;
+	int16_t setpoint = test_random () % 2000;
+	for (uint16_t step = 0; step < TEST_STEPS; step++)
+	{
+		input = ssadd (input, test_random () % 64);
+		if ((test_random () & 0x3F) == 0)
+		{
+			setpoint = test_random ();
+		}
+		int16_t new_output = now.compute (input, setpoint);
+		int16_t old_output = before.compute (input, setpoint);
+		if (new_output != old_output && mismatches++ < 10)
+		{
+			printf ("Mode %d, Kp %d, Ki %d, Kd %d, Kw %d, limit %d, step %u: output %d, not %d\n",
+					(int)config.mode, config.Kp, config.Ki, config.Kd, config.Kw, limit, step, new_output,
+					old_output);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks that an integral gain shift above \c pid::MAX_ISHIFT, which would make the 32-bit
+ *  integrator shift by 31 bits or more, is limited to \c pid::MAX_ISHIFT by both ways of setting it.
+ */
+
+static void check_ishift_limit (void)
+{
+	pid controller (NULL);
+	pid::config_t config = { pid::PI, 1024, 1024, 0, 0, INT16_MIN, INT16_MAX, 255 };
+
+	for (uint16_t ishift = 0; ishift <= UINT8_MAX; ishift++)
+	{
+		uint8_t expected = (ishift > pid::MAX_ISHIFT) ? pid::MAX_ISHIFT : ishift;
+		controller.set_ishift (ishift);
+		uint8_t from_setter = controller.get_ishift ();
+		config.ishift = ishift;
+		controller.set_config (config);
+		if ((from_setter != expected || controller.get_ishift () != expected) && mismatches++ < 10)
+		{
+			printf ("ishift %u was set to %u and %u, not %u\n", ishift, from_setter,
+					controller.get_ishift (), expected);
+		}
+	}
+}
+
+
+//===========================================================================================================
+/** The main function checks every product, the limit on the integral gain shift, then the controllers, and
+ *  prints the number of mismatches.
+ *  @return Zero if every output matched, one if any didn't
+ */
+
+int main (void)
+{
+	check_every_product ();
+	printf ("Every Q10 product checked, %lu mismatches\n", (unsigned long)mismatches);
+
+	check_ishift_limit ();
+	printf ("Integral gain shift limit checked, %lu mismatches\n", (unsigned long)mismatches);
+
+	for (uint16_t count = 0; count < TEST_CONTROLLERS; count++)
+	{
+		check_controller ();
+	}
+	printf ("%u controllers run for %u steps each, %lu mismatches in all\n", TEST_CONTROLLERS, TEST_STEPS,
+			(unsigned long)mismatches);
+
+	return (mismatches ? 1 : 0);
+}
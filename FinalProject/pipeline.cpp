@@ -0,0 +1,156 @@
+//***********************************************************************************************************
+/** @file pipeline.cpp
+ *    This file contains the functions through which the sensor, power, control and steering tasks run one
+ *    after another each period, and through which the delay from sensing to new motor and servo outputs is
+ *    measured.
+ *
+ *  Revisions:
+ *    @li 10-17-2026 ME405 Group 3 original file
+ *    @li 10-17-2026 ME405 Group 3 wait() tells whether the task woke on time or on the stage
+ *
+ */
+//***********************************************************************************************************
+#include "textqueue.h"                      // Header for text queue class
+#include "taskshare.h"			    // Header for thread-safe shared data
+#include "shares.h"                         // Shared inter-task communications
+#include "encoder_snapshot.h"               // For converting time stamps into timer counts
+
+#include "pipeline.h"                       // Header for these functions
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function finds the time since the most recent sample, in microseconds.
+ *  \details The hardware timer counts are turned into microseconds with a division by a constant, which the
+ *	     compiler turns into a shift. Delays too long to fit are given as the largest value which fits.
+ *  @param sample_counts The time of the sample, in hardware timer counts
+ *  @return The time since the sample, in microseconds
+ */
+
+static uint16_t microsec_since (uint32_t sample_counts)
+{
+	time_stamp now;
+	now.set_to_now ();
+	uint32_t since = (encoder_snapshot::to_counts (now) - sample_counts) / (TMR_MAX_CT / 1000);
+
+	return (since > UINT16_MAX) ? UINT16_MAX : (uint16_t)since;
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function tells the next task in the chain that this task's part of the period is done.
+ *  \details When @c PIPELINE_TASKS is 0 no task waits for the stages, so nothing is done.
+ *  @param stage The bit in @c ev_tasks for the stage which has finished
+ */
+
+void pipeline::release (EventBits_t stage)
+{
+#if PIPELINE_TASKS
+	xEventGroupSetBits (ev_tasks, stage);
+#else
+	(void)stage;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function waits until it's time for a task in the chain to run again.
+ *  \details When @c PIPELINE_TASKS is 1 it waits for the task before this one in the chain to release the
+ *	     given stage, or for @c PIPELINE_STALL_MS after the previous run if that task has stalled. When
+ *	     it's 0 it simply waits until @c PIPELINE_PERIOD_MS after the previous run.
+ *  @param previous_ticks The time at which the task last ran, which is updated here
+ *  @param stage The bit in @c ev_tasks for the stage which the task waits for
+ *  @return True if the task woke at the time put in @c previous_ticks, or false if it was woken by the stage
+ */
+
+bool pipeline::wait (TickType_t& previous_ticks, EventBits_t stage)
+{
+#if PIPELINE_TASKS
+	TickType_t ticks_left = previous_ticks + configMS_TO_TICKS (PIPELINE_STALL_MS) - xTaskGetTickCount ();
+	if (ticks_left > configMS_TO_TICKS (PIPELINE_STALL_MS))
+	{
+		ticks_left = 0;					// Already late, so only check the stage
+	}
+
+	if (xEventGroupWaitBits (ev_tasks, stage, pdTRUE, pdFALSE, ticks_left) & stage)
+	{
+		previous_ticks = xTaskGetTickCount ();
+		return (false);
+	}
+	previous_ticks += configMS_TO_TICKS (PIPELINE_STALL_MS);
+#else
+	(void)stage;
+	vTaskDelayUntil (&previous_ticks, configMS_TO_TICKS (PIPELINE_PERIOD_MS));
+#endif
+	return (true);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function notes the time at which the sensors are read, from which the delays to the outputs
+ *	   are measured.
+ */
+
+void pipeline::mark_sample (void)
+{
+	time_stamp now;
+	now.set_to_now ();
+	uint32_t counts = encoder_snapshot::to_counts (now);
+
+	sh_latency->begin_write ().sample_counts = counts;
+	sh_latency->end_write ();
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function records the delay from the most recent sample to the setting of new motor powers.
+ */
+
+void pipeline::record_motor_output (void)
+{
+	latency_block_t latency = sh_latency->get ();
+	uint16_t delay = microsec_since (latency.sample_counts);
+
+	latency_block_t& block = sh_latency->begin_write ();
+	block.motor_us = delay;
+	if (delay > block.motor_max_us)
+	{
+		block.motor_max_us = delay;
+	}
+	sh_latency->end_write ();
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function records the delay from the most recent sample to the setting of a new servo
+ *	   position.
+ */
+
+void pipeline::record_servo_output (void)
+{
+	latency_block_t latency = sh_latency->get ();
+	uint16_t delay = microsec_since (latency.sample_counts);
+
+	latency_block_t& block = sh_latency->begin_write ();
+	block.servo_us = delay;
+	if (delay > block.servo_max_us)
+	{
+		block.servo_max_us = delay;
+	}
+	sh_latency->end_write ();
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function prints the newest and longest delays from sample to motor and servo outputs.
+ *  @param p_ser_dev Pointer to a serial device on which to print the delays
+ */
+
+void pipeline::print_latency (emstream* p_ser_dev)
+{
+	latency_block_t latency = sh_latency->get ();
+
+	*p_ser_dev << PMS ("Sample to motor PWM: ") << latency.motor_us << PMS (" us (max ")
+		   << latency.motor_max_us << PMS (" us)") << endl;
+	*p_ser_dev << PMS ("Sample to servo PWM: ") << latency.servo_us << PMS (" us (max ")
+		   << latency.servo_max_us << PMS (" us)") << endl;
+}
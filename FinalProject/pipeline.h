@@ -0,0 +1,77 @@
+//===========================================================================================================
+/** @file pipeline.h
+ *    This file contains the functions through which the sensor, power, control and steering tasks run one
+ *    after another each period, and through which the delay from sensing to new motor and servo outputs is
+ *    measured.
+ *
+ *  Revisions:
+ *    @li 10-17-2026 ME405 Group 3 original file
+ *    @li 10-17-2026 ME405 Group 3 wait() tells whether the task woke on time or on the stage
+ *
+ */
+//===========================================================================================================
+
+/// This define prevents this .H file from being included multiple times in a .CPP file
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+#include "FreeRTOS.h"                       // Header for the FreeRTOS RTOS
+#include "event_groups.h"                   // Header for FreeRTOS event groups
+#include "emstream.h"                       // Header for serial ports and devices
+
+
+/** @brief   Set to 1 to have the sensor task start each period and the other control tasks follow it.
+ *  @details When this is 1, the sensor task is the only task which keeps time: the power, control and
+ *	     steering tasks each wait for the task before them to finish its part of the period, so each new
+ *	     sample goes through to the motor and servo outputs in one chain. When it's 0, each task wakes
+ *	     on its own every 10 ms as it used to, and a sample may wait most of a period at each step.
+ */
+#ifndef PIPELINE_TASKS
+	#define PIPELINE_TASKS		1
+#endif
+
+/// The period at which the sensor task starts the chain, in milliseconds
+const uint8_t PIPELINE_PERIOD_MS = 10;
+
+/** @brief   How long a task in the chain waits for the task before it before running anyway, in ms.
+ *  @details If the task before it stalls, each task still runs at this slower rate, so the motors keep
+ *	     being controlled.
+ */
+const uint8_t PIPELINE_STALL_MS = 20;
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** @brief   The sample time and the delays from it to the newest motor and servo outputs, which are kept in
+ *	     the shared block @c sh_latency.
+ *  @details The sample time is a count of hardware timer ticks, as made by @c encoder_snapshot, so that the
+ *	     delays can be found with one subtraction. Each delay is written only by the task which sets that
+ *	     output.
+ */
+struct latency_block_t
+{
+	uint32_t sample_counts;			///< Time at which the sensors were last read, in timer counts
+	uint16_t motor_us;			///< Delay from the sample to the newest motor powers, in us
+	uint16_t motor_max_us;			///< The longest delay to the motor powers seen, in us
+	uint16_t servo_us;			///< Delay from the sample to the newest servo position, in us
+	uint16_t servo_max_us;			///< The longest delay to the servo position seen, in us
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** @brief   This namespace includes the functions which pass each period's work down the chain of control
+ *	     tasks and time it.
+ *  @details The stages are bits in the event group @c ev_tasks: @c EV_SENSED is set by the sensor task,
+ *	     @c EV_MEASURED by the power task once it has found the speeds, and @c EV_CONTROLLED by the
+ *	     control task once it has set the new powers and servo setpoint.
+ */
+namespace pipeline
+{
+	void                           release (EventBits_t stage);
+	bool                           wait (TickType_t& previous_ticks, EventBits_t stage);
+	void                           mark_sample (void);
+	void                           record_motor_output (void);
+	void                           record_servo_output (void);
+	void                           print_latency (emstream* p_ser_dev);
+} // end namespace pipeline
+
+#endif // _PIPELINE_H_
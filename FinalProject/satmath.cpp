@@ -7,6 +7,9 @@
  *    \li 01-19-2016 CTR Modified for C++
  *    \li 01-27-2016 Added doxygen comments
  *    \li May 4, 2016 -- BKK Added original file
+ *    \li 10-17-2026 ME405 Group 3 Add, subtract and absolute value are now the portable versions
+ *    \li 10-17-2026 ME405 Group 3 Added 32-bit add and subtract and a shift by a variable amount
+ *    \li 10-17-2026 ME405 Group 3 Fixed the product of INT16_MIN and itself and INT32_MIN / -1
  *
  *  License:
  *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
@@ -31,7 +34,7 @@
  *  @param y Addend
  *  @return Sum
  */
-int16_t satmath::signed_saturated_add(int16_t x, int16_t y)
+int16_t satmath::portable::signed_saturated_add(int16_t x, int16_t y)
 {
 	// Determine the lower or upper bound of the result
 	int16_t ret =  (x < 0) ? INT16_MIN : INT16_MAX;
@@ -53,7 +56,7 @@ int16_t satmath::signed_saturated_add(int16_t x, int16_t y)
  *  @param y Subtrahend 
  *  @return Difference
  */
-int16_t satmath::signed_saturated_sub(int16_t x, int16_t y)
+int16_t satmath::portable::signed_saturated_sub(int16_t x, int16_t y)
 {
 	// if they are equal return 0
 	if(x == y) return 0;
@@ -70,36 +73,94 @@ int16_t satmath::signed_saturated_sub(int16_t x, int16_t y)
  *  @param x Signed value
  *  @return Absolute value
  */
-int16_t satmath::saturated_abs(int16_t x)
+int16_t satmath::portable::saturated_abs(int16_t x)
 {
 	return (x == INT16_MIN) ? INT16_MAX:abs(x);
 }
 
 //-----------------------------------------------------------------------------------------------------------
 /** \brief This function performs saturated multiplication
- *  \details The function performs multiplication of two 16-bit signed integers ensuring a 32-bit result
+ *  \details The function performs multiplication of two 16-bit signed integers ensuring a 32-bit result.
+ *	     Every product fits in 32 bits, even INT16_MIN times itself, so nothing needs to be saturated
  *  @param x Multiplicand
  *  @param y Multiplier
  *  @return Product
  */
 int32_t satmath::signed_saturated_mul(int16_t x, int16_t y)
 {
-	if (x==INT16_MIN && y==INT16_MIN) return INT32_MAX;
 	return (int32_t)(int16_t)x * (int32_t)(int16_t)y;
 }
 
 //-----------------------------------------------------------------------------------------------------------
 /** \brief This function performs saturated division
  *  \details The function performs division of a 32-bit integer by a 16-bit signed integer. The result is
- *	     saturated to the minimal or maximal 16-bit value
+ *	     saturated to the minimal or maximal 16-bit value. INT32_MIN divided by -1 doesn't fit in 32 bits
+ *	     either, so it's saturated before dividing. The divisor must not be zero
  *  @param x Dividend
  *  @param y Divisor 
  *  @return Quotient
  */
 int16_t satmath::signed_saturated_div(int32_t x, int16_t y)
 {
+	if (x == INT32_MIN && y == -1) return INT16_MAX;
 	int32_t ret = (x / y);
 	ret = (ret > INT16_MAX) ? INT16_MAX:ret;
 	ret = (ret < INT16_MIN) ? INT16_MIN:ret;
 	return (int16_t) ret;
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function performs saturated 32-bit addition
+ *  \details The function adds two 32-bit signed integers, saturating at either the maximal or minimal
+ *	     32-bit values. The sum is found with unsigned arithmetic, which can't overflow; the addition
+ *	     overflowed if the sum's sign differs from the signs of both numbers added.
+ *  @param x Augend
+ *  @param y Addend
+ *  @return Sum
+ */
+int32_t satmath::signed_saturated_add32(int32_t x, int32_t y)
+{
+	int32_t ret = (int32_t)((uint32_t)x + (uint32_t)y);
+	if (((x ^ ret) & (y ^ ret)) < 0) ret = (x < 0) ? INT32_MIN : INT32_MAX;
+	return ret;
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function performs saturated 32-bit subtraction
+ *  \details The function subtracts two 32-bit signed integers, saturating at either the maximal or
+ *	     minimal 32-bit values. The subtraction overflowed if the numbers' signs differ and the
+ *	     difference's sign isn't that of the minuend.
+ *  @param x Minuend
+ *  @param y Subtrahend 
+ *  @return Difference
+ */
+int32_t satmath::signed_saturated_sub32(int32_t x, int32_t y)
+{
+	int32_t ret = (int32_t)((uint32_t)x - (uint32_t)y);
+	if (((x ^ y) & (x ^ ret)) < 0) ret = (x < 0) ? INT32_MIN : INT32_MAX;
+	return ret;
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function performs saturated division by a power of two which is only known at run time
+ *  \details The function divides a 32-bit integer by 2^q with an arithmetic shift, rounding toward zero
+ *	     as @c signed_saturated_shr<Q>() does, and saturates the result to the minimal or maximal 16-bit
+ *	     value. Whole bytes are shifted first, so no more than seven single bit shifts are needed.
+ *  @param x Dividend
+ *  @param q The number of bits to shift, from 0 to 30
+ *  @return Quotient
+ */
+int16_t satmath::signed_saturated_shr(int32_t x, uint8_t q)
+{
+	// Adding 2^q - 1 to a negative dividend makes the shift round toward zero instead of down
+	if (x < 0) x += ((int32_t)1 << q) - 1;
+	while (q >= 8)
+	{
+		x >>= 8;
+		q -= 8;
+	}
+	x >>= q;
+	if (x > INT16_MAX) return INT16_MAX;
+	if (x < INT16_MIN) return INT16_MIN;
+	return (int16_t)x;
+}
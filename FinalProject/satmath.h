@@ -8,6 +8,9 @@
  *    \li 01-19-2016 CTR Modified for C++
  *    \li 01-27-2016 Added doxygen comments
  *    \li May 4, 2016 -- BKK Added original file
+ *    \li 10-17-2026 ME405 Group 3 Added signed_saturated_shr() for division by powers of two
+ *    \li 10-17-2026 ME405 Group 3 Added AVR assembly add, subtract and absolute value
+ *    \li 10-17-2026 ME405 Group 3 Added 32-bit add and subtract and a shift by a variable amount
  *
  *  License:
  *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
@@ -30,6 +33,16 @@
 //#define INT32_MIN (int32_t) 0x80000000
 //#define INT32_MAX (int32_t) 0x7FFFFFFF
 
+/** \brief This is true if the AVR assembly versions of the saturated add, subtract and absolute value
+ *	   functions are used. Defining @c SATMATH_PORTABLE (for example with -DSATMATH_PORTABLE in the
+ *	   Makefile's OTHERS) selects the portable C versions on the AVR as well.
+ */
+#if defined (__AVR) && !defined (SATMATH_PORTABLE)
+	#define SATMATH_AVR_ASM		1
+#else
+	#define SATMATH_AVR_ASM		0
+#endif
+
 // Some handy macros to shorten the function names
 /** \brief Shorthand to make accessing namespace easier
  */
@@ -51,16 +64,164 @@
  */
 #define ssdiv(x,y)	satmath::signed_saturated_div(x,y)
 
+/** \brief Shorthand to make accessing namespace easier; the shift @c q must be a constant
+ */
+#define ssshr(x,q)	satmath::signed_saturated_shr<q>(x)
+
+/** \brief Shorthand to make accessing namespace easier
+ */
+#define ssadd32(x,y)	satmath::signed_saturated_add32(x,y)
+
+/** \brief Shorthand to make accessing namespace easier
+ */
+#define sssub32(x,y)	satmath::signed_saturated_sub32(x,y)
+
+/** \brief Shorthand to make accessing namespace easier; the shift @c q may be a variable
+ */
+#define ssshrv(x,q)	satmath::signed_saturated_shr(x,q)
+
 //-----------------------------------------------------------------------------------------------------------
 /** \brief This namespace includes several functions to do saturated 16-bit signed math
  */
 namespace satmath 
 {
-	int16_t				signed_saturated_add(int16_t x, int16_t y);
-	int16_t				signed_saturated_sub(int16_t x, int16_t y);
-	int16_t				saturated_abs(int16_t x);
+	/** \brief The portable C versions of the functions which also have AVR assembly versions
+	 *  \details These are used on processors other than the AVR, or on the AVR when @c SATMATH_PORTABLE is
+	 *	      defined, and they are the reference against which the assembly versions are checked.
+	 */
+	namespace portable
+	{
+		int16_t			signed_saturated_add(int16_t x, int16_t y);
+		int16_t			signed_saturated_sub(int16_t x, int16_t y);
+		int16_t			saturated_abs(int16_t x);
+	} // end namespace portable
+
 	int32_t				signed_saturated_mul(int16_t x, int16_t y);
 	int16_t				signed_saturated_div(int32_t x, int16_t y);	
+	int32_t				signed_saturated_add32(int32_t x, int32_t y);
+	int32_t				signed_saturated_sub32(int32_t x, int32_t y);
+	int16_t				signed_saturated_shr(int32_t x, uint8_t q);
+
+#if SATMATH_AVR_ASM
+	//-------------------------------------------------------------------------------------------------------
+	/** \brief This function performs saturated addition in AVR assembly
+	 *  \details The sum is found with @c add and @c adc. If the V flag shows that it overflowed, the sign
+	 *	     of the wrong result tells which way: a negative result came from two positive numbers, so
+	 *	     the sum is saturated to INT16_MAX, and otherwise to INT16_MIN. This takes 4 or 7 cycles.
+	 *  @param x Augend
+	 *  @param y Addend
+	 *  @return Sum
+	 */
+	inline int16_t signed_saturated_add(int16_t x, int16_t y)
+	{
+		asm ("add  %A0, %A1"	"\n\t"
+		     "adc  %B0, %B1"	"\n\t"
+		     "brvc 1f"		"\n\t"
+		     "ldi  %A0, 0xFF"	"\n\t"		// ldi doesn't change the flags, so the N
+		     "ldi  %B0, 0x7F"	"\n\t"		// flag is still that of the sum
+		     "brmi 1f"		"\n\t"
+		     "ldi  %A0, 0x00"	"\n\t"
+		     "ldi  %B0, 0x80"	"\n"
+		     "1:"
+		     : "+d" (x)
+		     : "r" (y));
+		return x;
+	}
+
+	//-------------------------------------------------------------------------------------------------------
+	/** \brief This function performs saturated subtraction in AVR assembly
+	 *  \details It works the same way as @c signed_saturated_add(), with @c sub and @c sbc.
+	 *  @param x Minuend
+	 *  @param y Subtrahend 
+	 *  @return Difference
+	 */
+	inline int16_t signed_saturated_sub(int16_t x, int16_t y)
+	{
+		asm ("sub  %A0, %A1"	"\n\t"
+		     "sbc  %B0, %B1"	"\n\t"
+		     "brvc 1f"		"\n\t"
+		     "ldi  %A0, 0xFF"	"\n\t"
+		     "ldi  %B0, 0x7F"	"\n\t"
+		     "brmi 1f"		"\n\t"
+		     "ldi  %A0, 0x00"	"\n\t"
+		     "ldi  %B0, 0x80"	"\n"
+		     "1:"
+		     : "+d" (x)
+		     : "r" (y));
+		return x;
+	}
+
+	//-------------------------------------------------------------------------------------------------------
+	/** \brief This function performs a saturated absolute value in AVR assembly
+	 *  \details A negative number is negated; only INT16_MIN is still negative afterwards, and it's
+	 *	     replaced by INT16_MAX.
+	 *  @param x Signed value
+	 *  @return Absolute value
+	 */
+	inline int16_t saturated_abs(int16_t x)
+	{
+		asm ("sbrs %B0, 7"	"\n\t"
+		     "rjmp 1f"		"\n\t"
+		     "neg  %B0"		"\n\t"
+		     "neg  %A0"		"\n\t"
+		     "sbc  %B0, __zero_reg__"	"\n\t"
+		     "sbrs %B0, 7"	"\n\t"
+		     "rjmp 1f"		"\n\t"
+		     "ldi  %A0, 0xFF"	"\n\t"
+		     "ldi  %B0, 0x7F"	"\n"
+		     "1:"
+		     : "+d" (x));
+		return x;
+	}
+#else
+	/** \brief Saturated addition; see @c portable::signed_saturated_add()
+	 *  @param x Augend
+	 *  @param y Addend
+	 *  @return Sum
+	 */
+	inline int16_t signed_saturated_add(int16_t x, int16_t y)
+	{
+		return portable::signed_saturated_add(x, y);
+	}
+
+	/** \brief Saturated subtraction; see @c portable::signed_saturated_sub()
+	 *  @param x Minuend
+	 *  @param y Subtrahend 
+	 *  @return Difference
+	 */
+	inline int16_t signed_saturated_sub(int16_t x, int16_t y)
+	{
+		return portable::signed_saturated_sub(x, y);
+	}
+
+	/** \brief Saturated absolute value; see @c portable::saturated_abs()
+	 *  @param x Signed value
+	 *  @return Absolute value
+	 */
+	inline int16_t saturated_abs(int16_t x)
+	{
+		return portable::saturated_abs(x);
+	}
+#endif
+
+	//-------------------------------------------------------------------------------------------------------
+	/** \brief This function performs saturated division by a power of two
+	 *  \details The function divides a 32-bit integer by 2^Q with an arithmetic shift, rounding toward zero
+	 *	     just as @c signed_saturated_div(x, 1 << Q) does, and saturates the result to the minimal or
+	 *	     maximal 16-bit value. Because Q is a constant, the shift compiles to a few byte moves and
+	 *	     shifts rather than a call to the 32-bit division routine.
+	 *  @param x Dividend
+	 *  @return Quotient
+	 */
+	template <uint8_t Q> inline int16_t signed_saturated_shr(int32_t x)
+	{
+		// Adding 2^Q - 1 to a negative dividend makes the shift round toward zero instead of down
+		if (x < 0) x += ((int32_t)1 << Q) - 1;
+		x >>= Q;
+		if (x > INT16_MAX) return INT16_MAX;
+		if (x < INT16_MIN) return INT16_MIN;
+		return (int16_t)x;
+	}
 } // end namespace satmath
 
 #endif // SATMATH_H
\ No newline at end of file
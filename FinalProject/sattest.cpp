@@ -0,0 +1,278 @@
+//***********************************************************************************************************
+/** \file sattest.cpp
+ *    This file contains a program which checks the saturated math functions in \c satmath.cpp and
+ *    \c satmath.h against reference versions which do the same arithmetic in a wider type and then clamp
+ *    the result. The reference versions can't overflow, so they show what each function should give.
+ *
+ *    On the PC, built with 'make -f Makefile.host sattest', the 16-bit add and subtract are checked for
+ *    every pair of 16-bit numbers and the absolute value for every number, while the multiply, divide,
+ *    32-bit add and subtract and the shifts are checked for several million pseudo-random arguments and
+ *    for the numbers at the ends of their ranges. The functions checked there are the portable ones.
+ *
+ *    On the AVR, built with 'make sattest' and run in the simavr simulator with 'make sattest-sim', the
+ *    functions checked are the assembly versions of add, subtract and absolute value, which are the ones
+ *    the car uses. Checking every pair would take the simulator hours, so each 16-bit number is paired
+ *    with the numbers near the ends of the range and zero, and with 64 pseudo-random numbers. The other
+ *    functions are checked as on the PC with fewer arguments. The results are printed on serial port 0,
+ *    and the processor is put to sleep with interrupts off when they've been printed, which makes simavr
+ *    exit.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//***********************************************************************************************************
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+#include <stdint.h>                         // Integer types of given sizes
+
+#ifdef __AVR
+	#include <avr/io.h>                     // Port I/O for SFR's
+	#include <avr/interrupt.h>              // Interrupt enable and disable
+	#include <avr/sleep.h>                  // Sleep mode, used to stop the simulator
+	#include <avr/wdt.h>                    // Watchdog timer header
+	#include "rs232int.h"                   // ME405/507 library for serial comm.
+#else
+	#include "host_serial.h"                // Serial device on the PC's terminal
+#endif
+
+#include "satmath.h"                        // The saturated math functions being checked
+
+
+#ifdef __AVR
+	/// The number of pseudo-random arguments for each function other than add and subtract
+	const uint32_t TEST_SAMPLES = 20000UL;
+
+	/// The number of pseudo-random second arguments paired with every first one for add and subtract
+	const uint16_t TEST_PARTNERS = 64;
+#else
+	/// The number of pseudo-random arguments for each function other than add and subtract
+	const uint32_t TEST_SAMPLES = 4000000UL;
+#endif
+
+/// Numbers at and near the ends of the 16-bit range, which are checked with every other number
+static const int16_t edges16[] = { INT16_MIN, INT16_MIN + 1, -2, -1, 0, 1, 2, INT16_MAX - 1, INT16_MAX };
+
+/// Numbers at and near the ends of the 32-bit range
+static const int32_t edges32[] = { INT32_MIN, INT32_MIN + 1, (int32_t)INT16_MIN - 1, INT16_MIN, -2, -1, 0,
+								   1, 2, INT16_MAX, (int32_t)INT16_MAX + 1, INT32_MAX - 1, INT32_MAX };
+
+/// The number of wrong results found for each function
+static uint32_t failures = 0;
+
+/// The serial device on which the results are printed
+static emstream* p_ser;
+
+/// The state of the pseudo-random number generator
+static uint32_t test_seed = 12345;
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function returns the next number from a linear congruential pseudo-random generator.
+ *  @return A pseudo-random 32-bit number
+ */
+
+static uint32_t test_random (void)
+{
+	test_seed = test_seed * 1664525UL + 1013904223UL;
+	return (test_seed);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function clamps a number to the 16-bit range, as each 16-bit saturated function should.
+ *  @param x The number, which may be outside the range
+ *  @return The number, or the end of the range nearest to it
+ */
+
+static int16_t clamp16 (int64_t x)
+{
+	if (x > INT16_MAX) return INT16_MAX;
+	if (x < INT16_MIN) return INT16_MIN;
+	return ((int16_t)x);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function clamps a number to the 32-bit range, as each 32-bit saturated function should.
+ *  @param x The number, which may be outside the range
+ *  @return The number, or the end of the range nearest to it
+ */
+
+static int32_t clamp32 (int64_t x)
+{
+	if (x > INT32_MAX) return INT32_MAX;
+	if (x < INT32_MIN) return INT32_MIN;
+	return ((int32_t)x);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function divides by a power of two, rounding toward zero, in 64-bit arithmetic.
+ *  @param x The dividend
+ *  @param q The power of two by which it's divided
+ *  @return The quotient, rounded toward zero
+ */
+
+static int64_t shr_reference (int32_t x, uint8_t q)
+{
+	return ((int64_t)x / ((int64_t)1 << q));
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function compares a result with the one expected, and prints the function's name and arguments if
+ *  they differ. Only the first few failures are printed.
+ *  @param p_name The name of the function, in program memory on the AVR
+ *  @param x The first argument
+ *  @param y The second argument
+ *  @param result The result which the function gave
+ *  @param expected The result which the reference gave
+ */
+
+static void check (const char* p_name, int32_t x, int32_t y, int32_t result, int32_t expected)
+{
+	if (result != expected)
+	{
+		if (failures++ < 10)
+		{
+			*p_ser << _p_str << p_name << PMS (" (") << x << PMS (", ") << y << PMS (") gave ") << result
+				   << PMS (", not ") << expected << endl;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks the 16-bit add and subtract of one number with another.
+ *  @param x The first number
+ *  @param y The second number
+ */
+
+static void check_add_sub (int16_t x, int16_t y)
+{
+	check (PSTR ("ssadd"), x, y, ssadd (x, y), clamp16 ((int32_t)x + y));
+	check (PSTR ("sssub"), x, y, sssub (x, y), clamp16 ((int32_t)x - y));
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks the functions which are given two 32-bit numbers, or a 32-bit and a 16-bit one.
+ *  @param x The first number
+ *  @param y The second number
+ */
+
+static void check_32 (int32_t x, int32_t y)
+{
+	check (PSTR ("ssadd32"), x, y, ssadd32 (x, y), clamp32 ((int64_t)x + y));
+	check (PSTR ("sssub32"), x, y, sssub32 (x, y), clamp32 ((int64_t)x - y));
+
+	int16_t divisor = (int16_t)y;
+	if (divisor != 0)
+	{
+		check (PSTR ("ssdiv"), x, divisor, ssdiv (x, divisor), clamp16 ((int64_t)x / divisor));
+	}
+
+	uint8_t q = (uint32_t)y % 31;
+	check (PSTR ("ssshrv"), x, q, ssshrv (x, q), clamp16 (shr_reference (x, q)));
+	check (PSTR ("ssshr<10>"), x, 10, ssshr (x, 10), clamp16 (shr_reference (x, 10)));
+	check (PSTR ("ssshr<16>"), x, 16, ssshr (x, 16), clamp16 (shr_reference (x, 16)));
+}
+
+
+//===========================================================================================================
+/** The main function checks each function in turn and prints how many wrong results were found.
+ *  @return On the PC, zero if every result was right and one if any was wrong; on the AVR it never returns
+ */
+
+int main (void)
+{
+#ifdef __AVR
+	MCUSR = 0;
+	wdt_disable ();
+	cli ();
+	rs232* p_ser_port = new rs232 (9600, 0);
+	p_ser = p_ser_port;
+	*p_ser << PMS ("Checking the AVR assembly add, subtract and absolute value") << endl;
+#else
+	p_ser = new host_serial ();
+	*p_ser << PMS ("Checking the portable add, subtract and absolute value") << endl;
+#endif
+
+	// Add and subtract, and the absolute value, for every 16-bit number
+	for (int32_t x = INT16_MIN; x <= INT16_MAX; x++)
+	{
+		check (PSTR ("ssabs"), x, 0, ssabs ((int16_t)x), clamp16 ((x < 0) ? -x : x));
+#ifdef __AVR
+		for (uint8_t index = 0; index < sizeof (edges16) / sizeof (edges16[0]); index++)
+		{
+			check_add_sub (x, edges16[index]);
+		}
+		for (uint16_t count = 0; count < TEST_PARTNERS; count++)
+		{
+			check_add_sub (x, (int16_t)test_random ());
+		}
+#else
+		for (int32_t y = INT16_MIN; y <= INT16_MAX; y++)
+		{
+			check_add_sub (x, y);
+		}
+#endif
+	}
+
+	// Multiplication of every pair of numbers near the ends, then of pseudo-random pairs
+	for (uint8_t index = 0; index < sizeof (edges16) / sizeof (edges16[0]); index++)
+	{
+		for (uint8_t other = 0; other < sizeof (edges16) / sizeof (edges16[0]); other++)
+		{
+			int16_t x = edges16[index];
+			int16_t y = edges16[other];
+			check (PSTR ("ssmul"), x, y, ssmul (x, y), clamp32 ((int64_t)x * y));
+		}
+	}
+	for (uint32_t count = 0; count < TEST_SAMPLES; count++)
+	{
+		int16_t x = (int16_t)test_random ();
+		int16_t y = (int16_t)test_random ();
+		check (PSTR ("ssmul"), x, y, ssmul (x, y), clamp32 ((int64_t)x * y));
+	}
+
+	// The 32-bit functions, with numbers near the ends and with pseudo-random numbers. Half of the random
+	// numbers are made small, as the PID controllers' sums usually are, so the shifts don't always saturate
+	for (uint8_t index = 0; index < sizeof (edges32) / sizeof (edges32[0]); index++)
+	{
+		for (uint8_t other = 0; other < sizeof (edges32) / sizeof (edges32[0]); other++)
+		{
+			check_32 (edges32[index], edges32[other]);
+		}
+	}
+	for (uint32_t count = 0; count < TEST_SAMPLES; count++)
+	{
+		int32_t x = (int32_t)test_random ();
+		int32_t y = (int32_t)test_random ();
+		if (count & 1)
+		{
+			x >>= (uint8_t)y & 0x1F;
+		}
+		check_32 (x, y);
+	}
+
+	if (failures)
+	{
+		*p_ser << PMS ("Saturated math checks FAILED, ") << failures << PMS (" wrong results") << endl;
+	}
+	else
+	{
+		*p_ser << PMS ("Saturated math checks passed") << endl;
+	}
+
+#ifdef __AVR
+	// Interrupts are off, so the results are sent from the port's buffer here, then the processor sleeps
+	p_ser_port->transmit_now ();
+	set_sleep_mode (SLEEP_MODE_PWR_DOWN);
+	sleep_enable ();
+	sleep_cpu ();
+	for (;;);
+#else
+	return (failures ? 1 : 0);
+#endif
+}
@@ -9,6 +9,11 @@
  *    @li 10-29-2012 JRR Reorganized with global queue and shared data references
  *    @li 01-04-2014 JRR Re-reorganized, allocating shares with new now
  *    @li April 28, 2016 -- BKK Added shared variables for encoder count, old and new state, error count
+ *    @li 10-17-2026 ME405 Group 3 Added encoder edge times; motor speeds are in quarter ticks
+ *    @li 10-17-2026 ME405 Group 3 Motor, route and IMU shares grouped into shared blocks
+ *    @li 10-17-2026 ME405 Group 3 Power and braking flags wake task_power through an event group
+ *    @li 10-17-2026 ME405 Group 3 Pipeline stage bits and sample to output latencies added
+ *    @li 10-17-2026 ME405 Group 3 The print queue is a stream buffer which moves text in blocks
  *
  *  License:
  *	This file is copyright 2015 by JR Ridgely and released under the Lesser GNU Public License, 
@@ -27,75 +32,108 @@
 #ifndef _SHARES_H_
 #define _SHARES_H_
 
+#include "time_stamp.h"                     // Header for high resolution time stamps
+#include "sharedblock.h"                    // Header for shared blocks of related data
+#include "notifyshare.h"                    // Header for shares which wake tasks when written
+#include "pipeline.h"                       // Header for the chain of control tasks
+#include "streambuffer.h"                   // Header for the print queue's class
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** @brief   The state of the two drive motors, which is kept in the shared block @c sh_motors.
+ *  @details The user interface and control tasks write the setpoints, the power (or simulation) task writes
+ *	     the speeds, and the control task writes the powers. Each task changes only its own fields, and the
+ *	     control task reads the setpoints and speeds of both motors as one consistent set.
+ */
+struct motor_block_t
+{
+	int16_t setpoint[2];			///< Speed setpoints in ticks per 10 ms, positive for forward
+	int16_t speed[2];			///< Measured speeds in quarter ticks per 10 ms
+	int16_t power[2];			///< Powers found by the motor PI controllers
+};
+
+/** @brief   The route which the car is following, which is kept in the shared block @c sh_route.
+ *  @details The user interface task fills in a route's parameters and then starts it by setting @c mode;
+ *	     the control task follows the route and clears @c linear_start and @c mode as it goes.
+ */
+struct route_block_t
+{
+	uint8_t mode;				///< 0 when no route runs, 1 for a linear route, 2 for a circle
+	uint8_t linear_start;			///< Linear route initialization flag
+	uint8_t circular_start;			///< Circular route initialization flag
+	uint8_t velocity;			///< Route path velocity, in ticks per 10 ms
+	uint8_t radius;				///< Circular path radius, in inches
+	uint16_t distance;			///< Linear route distance, in inches
+	int32_t heading_setpoint;		///< Heading setpoint for linear path control
+};
+
+/** @brief   The state of the IMU, which is kept in the shared block @c sh_imu.
+ */
+struct imu_block_t
+{
+	int32_t heading;			///< Euler heading
+	uint8_t status_request;			///< Set to have the sensor task print the IMU's status
+};
+
+
 //-----------------------------------------------------------------------------------------------------------
 /// Externs: In this section, we declare variables and functions that are used in all (or at least two) of
 /// the files in the data acquisition project. Each of these items will also be declared exactly once,
 /// without the keyword 'extern', in one .cpp file as well as being declared extern here. 
 
 /// This queue allows tasks to send characters to the user interface task for display.
-extern TextQueue* p_print_ser_queue;
+extern StreamBuffer* p_print_ser_queue;
+
+/// Event group through which the power and braking flags wake the power task and each stage of the pipeline
+/// wakes the next
+extern EventGroupHandle_t ev_tasks;
+
+/// The bit set in @c ev_tasks when @c sh_power_set_flag is written
+const EventBits_t EV_POWER_SET = 0x01;
+
+/// The bit set in @c ev_tasks when @c sh_braking_full_flag is written
+const EventBits_t EV_BRAKING_FULL = 0x02;
+
+/// The bit set in @c ev_tasks when the sensor task has read the sensors, starting a period
+const EventBits_t EV_SENSED = 0x04;
+
+/// The bit set in @c ev_tasks when the power task has found the motor speeds
+const EventBits_t EV_MEASURED = 0x08;
+
+/// The bit set in @c ev_tasks when the control task has set new powers and a new servo setpoint
+const EventBits_t EV_CONTROLLED = 0x10;
 
 /// Flag share indicating power value has changed
-extern TaskShare<int8_t>* sh_power_set_flag;
+extern NotifyShare<int8_t>* sh_power_set_flag;
 
 /// Flag share indicating full braking requested
-extern TaskShare<int8_t>* sh_braking_full_flag;
-
-/// Encoder counts:Motor 1 encoder count
-extern TaskShare<volatile uint16_t>* sh_encoder_count_1;	/// Motor 1
-extern TaskShare<volatile uint16_t>* sh_encoder_count_2;	/// Motor 2
+extern NotifyShare<int8_t>* sh_braking_full_flag;
 
-/// Motor 1 encoder states
-extern TaskShare<volatile uint8_t>* sh_encoder_old_state_1;	/// Previous state
-extern TaskShare<volatile uint8_t>* sh_encoder_new_state_1;	/// Next state
+/// Encoder positions, in ticks counted since the encoders were set up; read them with @c encoder_snapshot
+extern TaskShare<int32_t>* sh_encoder_position_1;		/// Motor 1
+extern TaskShare<int32_t>* sh_encoder_position_2;		/// Motor 2
 
-/// Motor 2 encoder states
-extern TaskShare<volatile uint8_t>* sh_encoder_old_state_2;	/// Previous state
-extern TaskShare<volatile uint8_t>* sh_encoder_new_state_2;	/// Next state
+/// Times of the most recent encoder edges, from which @c encoder_snapshot finds the velocities
+extern TaskShare<time_stamp>* sh_encoder_edge_time_1;		/// Motor 1
+extern TaskShare<time_stamp>* sh_encoder_edge_time_2;		/// Motor 2
 
-// Motor speeds
-extern TaskShare<volatile uint32_t>* sh_motor_1_speed;		/// Motor 1
-extern TaskShare<volatile uint32_t>* sh_motor_2_speed;		/// Motor 2
 /// Tick jump error count
 extern TaskShare<uint16_t>* sh_encoder_error_count_1;		// Motor 1
 extern TaskShare<uint16_t>* sh_encoder_error_count_2;		// Motor 2
 
-// Motor PID setpoints
-extern TaskShare<int32_t>* sh_setpoint_1;			// Motor 1
-extern TaskShare<int32_t>* sh_setpoint_2;			// Motor 2
+/// Motor setpoints, speeds and powers
+extern SharedBlock<motor_block_t>* sh_motors;
 
-// Power values from PID control
-extern TaskShare<int16_t>* sh_PID_1_power;			// Motor 1
-extern TaskShare<int16_t>* sh_PID_2_power;			// Motor 2
+/// The route being followed and its parameters
+extern SharedBlock<route_block_t>* sh_route;
 
-// Flag to indicate PID control enabled
-extern TaskShare<uint8_t>* sh_PID_control;
+/// Euler heading and IMU status request
+extern SharedBlock<imu_block_t>* sh_imu;
 
 // Servo motor position setpoint
 extern TaskShare<uint16_t>* sh_servo_setpoint;
 
-// Circular path radius
-extern TaskShare<uint8_t>* sh_path_radius;
-
-// Circular route initialization flag
-extern TaskShare<uint8_t>* sh_circular_start;
-
-// Route path velocity
-extern TaskShare<uint8_t>* sh_path_velocity;
-
-// Linear Route Initialization Flag
-extern TaskShare <uint8_t>* sh_linear_start;
-
-// Linear Route Distance
-extern TaskShare <uint16_t>* sh_linear_distance;
-
-// Euler heading
-extern TaskShare<int32_t>* sh_euler_heading;
-
-// Euler heading setpoint
-extern TaskShare<int32_t>* sh_heading_setpoint;
-
-// IMU status check flag
-extern TaskShare<uint8_t>* sh_imu_status;
+/// Time of the newest sample and the delays from it to the motor and servo outputs
+extern SharedBlock<latency_block_t>* sh_latency;
 
 #endif /// _SHARES_H_
\ No newline at end of file
@@ -7,165 +7,136 @@
 #include "textqueue.h"				// Header for text queue class
 #include "taskshare.h"				// Header for thread-safe shared data 
 #include "shares.h"				// Shared inter-task communications
+#include "logid.h"				// Log messages sent as numbers
+#include "log_messages.h"			// Numbers of the log messages
 
 #include "task_control.h"			// Header for this task
 
 //-----------------------------------------------------------------------------------------------------------
 /** 
- *  This constructor creates a task which controls the output of two pid loops and operates major route 
- *  features. The main job of this constructor is to call the constructor of parent class (\c frt_task );
- *  the parent's constructor the work.
- *  @param a_name A character string which will be the name of this task
- *  @param a_priority The priority at which this task will initially run (default: 0)
- *  @param a_stack_size The size of this task's stack in bytes (default: configMINIMAL_STACK_SIZE)
- *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this task
- *		     to communicate (default: NULL)
+ *  This constructor creates a step which controls the output of two pid loops and operates major route 
+ *  features. The main job of this constructor is to call the constructor of parent class (\c CyclicStep );
+ *  the PID objects are configured in \c setup().
+ *  @param a_name A character string which will be the name of this step
+ *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this step
+ *		     to communicate
  */
 
-task_control::task_control (const char* a_name, unsigned portBASE_TYPE a_priority, size_t a_stack_size, 
-			    emstream* p_ser_dev): TaskBase (a_name, a_priority, a_stack_size, p_ser_dev)
+task_control::task_control (const char* a_name, emstream* p_ser_dev): CyclicStep (a_name, p_ser_dev),
+			    odometer (sh_encoder_position_1)
 {
 	// Nothing is done in the body of this constructor. 
 }
 
 //-----------------------------------------------------------------------------------------------------------
-/** This method is called once by the RTOS scheduler. Each time around the for (;;) loop, it instantiates the
- *  PID objects for the motors and sets the velocities of the motors based on the shared setpoint variable.
- *  The circular and linear routing calculations are called and used here to set the proper setpoints for the
- *  motor and servo.
+/** This method sets up the PI controllers for the motors and clears the shares which the control loop
+ *  uses. It's called once before the first step.
  */
 
-void task_control::run (void)
-{	  
-     // Make a variable which will hold times to use for precise task scheduling
-     TickType_t previousTicks = xTaskGetTickCount ();
-	  
-     // Creating the PID objects for Motor 1 and Motor 2
-     pid* pid_1 = new pid(p_serial);
-     pid* pid_2 = new pid(p_serial);
-     
-     // Motor 1 PID Constants
-     int16_t Kp_1 = 1 * 1024;					// K_p Proportional gain
-     int16_t Ki_1 = 1 * 256;					// K_i Integral gain
-     int16_t Kw_1 = 1 * 256;					// K_w Anti-windup gain
-     int16_t min_1 = -1600;					// Minimum saturation limit
-     int16_t max_1 = 1600;					// Maximum saturation limit
-     sh_motor_1_speed->put(0);					// Clear motor speed
-     sh_setpoint_1->put(0);					// Clear motor setpoint
-     
-     // pid::config{mode, Ki, Kp, Kd, Kw, min_satur, max_satur};
-     pid_1->set_config(pid::config_t{pid::PI, Kp_1, Ki_1, 0, Kw_1, min_1, max_1});
-     
-     // Motor 2 PID Constants
-     int16_t Kp_2 = 1 * 1024;					// K_p Proportional gain
-     int16_t Ki_2 = 1 * 256;					// K_i Integral gain
-     int16_t Kw_2 = 1 * 256;					// K_w Anti-windup gain
-     int16_t min_2 = -1600;					// Minimum saturation limit
-     int16_t max_2 = 1600;					// Maximum saturation limit
-     sh_motor_2_speed->put(0);					// Clear motor speed
-     sh_setpoint_2->put(0);					// Clear motor setpoint
-     
-     //pid::config{mode, Kp, Ki, Kd, Kw, min_satur, max_satur};
-     pid_2->set_config(pid::config_t{pid::PI, Kp_2, Ki_2, 0, Kw_2, min_2, max_2});
-     
-     int16_t setpoint_1 = 0;					// Velocity set point Motor 1
-     int16_t setpoint_2 = 0;					// Velocity set point Motor 2
-     int32_t distance = 0;					// Linear route distance input
-     uint16_t encoder_count = 0;				// Distance change from encoders
-     uint16_t inch_to_ticks = 356;				// Distance unit conversion
-     int16_t new_servo_error = 0;				// Heading error
-     int16_t new_servo_angle = 0;				// New calculated servo angle
-     
-     for(;;)
+void task_control::setup (void)
+{
+     // The gains of the motor PI controllers are fixed in motor_pid_bank_t; only the limits are set here
+     motor_pids.set_saturator(-1600, 1600);			// Motor saturation limits
+     motor_block_t& motors = sh_motors->begin_write();
+     for (uint8_t motor = 0; motor < 2; motor++)
      {
-	      // Set power for motor 1
-	      setpoint_1 = sh_setpoint_1->get();
-	      
-	      // Saturates maximum and minimum new power setting to +- 80 for Motor 1
-	      if(setpoint_1 >= -80 && setpoint_1 <= 80)
-	      {
-		  sh_PID_1_power->put(pid_1->compute(sh_motor_1_speed->get(), setpoint_1));
-		  sh_power_set_flag->put(1);
-	      }
-	      else if(setpoint_1 < -80) 
-	      {
-		  setpoint_1 = -80;
-		  sh_PID_1_power->put(pid_1->compute(sh_motor_1_speed->get(), setpoint_1));
-		  sh_power_set_flag->put(1);
-	      }
-	      else if(setpoint_1 > 80)
-	      {
-		  setpoint_1 = 80;
-		  sh_PID_1_power->put(pid_1->compute(sh_motor_1_speed->get(), setpoint_1));
-		  sh_power_set_flag->put(1);
-	      }
-	      else
-		  *p_serial << PMS ("PID 1 error") << endl;
+	  motors.speed[motor] = 0;					// Clear motor speed
+	  motors.setpoint[motor] = 0;					// Clear motor setpoint
+     }
+     sh_motors->end_write();
+     
+     distance = 0;
+     inch_to_ticks = 356;
+     new_servo_error = 0;
+     new_servo_angle = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** This method runs one pass of the control loop. It sets the velocities of the motors based on the shared
+ *  setpoint variables, then uses the circular and linear routing calculations to set the proper setpoints
+ *  for the motor and servo, and releases the steering step to set the new servo position. Being a step, it
+ *  can be called directly by the cycle count benchmark in \c bench_main.cpp, which times exactly the work
+ *  done each period.
+ */
+
+void task_control::step (void)
+{
+	  int16_t speeds[2];						// Motor speeds, the PIDs' inputs
+	  int16_t setpoints[2];						// Motor velocity setpoints
+
+	  // The setpoints and speeds of both motors are read together as one consistent snapshot
+	  motor_block_t motors = sh_motors->get();
+	  setpoints[0] = motors.setpoint[0];
+	  setpoints[1] = -motors.setpoint[1];
+	  speeds[0] = motors.speed[0];
+	  speeds[1] = motors.speed[1];
 
-	      // Set power for motor 2
-	      setpoint_2 = -sh_setpoint_2->get();
-	      
-	      // Saturates maximum and minimum new power setting to +- 80 for Motor 2
-	      if(setpoint_2 >= -80 && setpoint_2 <= 80)
-	      {
-		  sh_PID_2_power->put(pid_2->compute(sh_motor_2_speed->get(), setpoint_2));
-	          sh_power_set_flag->put(1);
-	      }
-	      else if(setpoint_2 < -80) 
-	      {
-		  setpoint_2 = -80;
-		  sh_PID_2_power->put(pid_2->compute(sh_motor_2_speed->get(), setpoint_2));
-		  sh_power_set_flag->put(1);
-	      }
-	      else if(setpoint_2 > 80)
-	      {
-		  setpoint_2 = 80;
-		  sh_PID_2_power->put(pid_2->compute(sh_motor_2_speed->get(), setpoint_2));
-		  sh_power_set_flag->put(1);
-	      }
-	      else
-		  *p_serial << PMS ("PID 2 error") << endl; // Debugs error message
+	  // Saturates maximum and minimum new power settings to +- 80 for both motors, then puts them in the
+	  // same quarter ticks per 10 ms as the speeds
+	  for (uint8_t motor = 0; motor < 2; motor++)
+	  {
+	       if (setpoints[motor] < -80)
+		    setpoints[motor] = -80;
+	       else if (setpoints[motor] > 80)
+		    setpoints[motor] = 80;
+	       setpoints[motor] <<= encoder_snapshot::VELOCITY_Q;
+	  }
+
+	  // Both PI loops run, then both powers are published together
+	  motor_pids.compute(speeds, setpoints);
+	  motor_block_t& outputs = sh_motors->begin_write();
+	  outputs.power[0] = motor_pids.get_output(0);
+	  outputs.power[1] = motor_pids.get_output(1);
+	  sh_motors->end_write();
+	  sh_power_set_flag->put(1);
+
+	  // Change in motor 1 position this period indicates distance travelled
+	  odometer.update();
 		
-	  // This logic handles the linear and circular path calculations and setpoint manipulation
-	  if (sh_PID_control->get() == 1)					// Linear Path Adherance
+	  // This logic handles the linear and circular path calculations and setpoint manipulation, working
+	  // from one snapshot of the route
+	  route_block_t route = sh_route->get();
+	  if (route.mode == 1)						// Linear Path Adherance
 	  {
 	       // Sets velocity setpoints for constant travel
-	       sh_setpoint_1->put(sh_path_velocity->get());			// Motor 1
-	       sh_setpoint_2->put(sh_setpoint_1->get());			// Motor 2
-	       
-	       // Change in motor 1 ticks indicates distance travelled
-	       encoder_count = sh_motor_1_speed->get();		
+	       int16_t velocity = route.velocity;
 	       
 	       // Initialization block
-	       if (sh_linear_start->get() == 1)				
+	       if (route.linear_start == 1)				
 	       {
 		    sh_servo_setpoint->put(3000);				// Sets neutral servo position
-		    sh_setpoint_1->put(0);					// Clears motor setpoints
-		    sh_setpoint_2 ->put(0);					
-		    distance = inch_to_ticks * sh_linear_distance ->get();	// Calculates total travel
-		    sh_linear_start ->put(0);					// Clears linear route start flag
+		    velocity = 0;						// Clears motor setpoints
+		    distance = (int32_t)inch_to_ticks * route.distance;		// Calculates total travel in 32 bits
+		    sh_route->begin_write().linear_start = 0;			// Clears linear route start flag
+		    sh_route->end_write();
+		    log_id(LOG_ROUTE_START, distance, (int16_t)route.velocity);
 	       }
 	       
 	       // Main operation block
 	       if(distance >= 0)
 	       {    
-		    new_servo_error = (sh_heading_setpoint->get() - sh_euler_heading->get())/10; // Determines heading error
+		    new_servo_error = (route.heading_setpoint - sh_imu->get().heading)/10;	 // Determines heading error
 		    new_servo_angle = new_servo_error;						 // Calculates new servo angle
 		    sh_servo_setpoint->put(routes::servo_power(new_servo_angle));		 // Sets new servo position
-		    distance -= encoder_count;							 // Subtracts the encoder distance travelled from the total
+		    distance -= odometer.get_delta();						 // Subtracts the encoder distance travelled from the total
 	       }
 	       else // Closing block
 	       {
-		   sh_PID_control->put(0);					// Ends route operation
-		   sh_setpoint_1->put(0);					// Clears motor setpoints
-		   sh_setpoint_2->put(0);	
+		   log_id(LOG_ROUTE_DONE, -distance);
+		   sh_route->begin_write().mode = 0;				// Ends route operation
+		   sh_route->end_write();
+		   velocity = 0;						// Clears motor setpoints
 		   distance = 0;						// Clears distance
-		   encoder_count = 0;						// Clears encoder_count
 		   sh_servo_setpoint -> put(3000);				// Puts servo in neutral position
 	       }
-	       
+
+	       // Both motors' setpoints are changed together
+	       motor_block_t& new_setpoints = sh_motors->begin_write();
+	       new_setpoints.setpoint[0] = velocity;			// Motor 1
+	       new_setpoints.setpoint[1] = velocity;			// Motor 2
+	       sh_motors->end_write();
 	  }
-	  else if (sh_PID_control->get() == 2)				// Circular Path Adherance
+	  else if (route.mode == 2)					// Circular Path Adherance
 	  {
 // 	       sh_setpoint_1->put(sh_path_velocity->get());
 // 	       sh_setpoint_2->put(sh_setpoint_1->get());
@@ -217,8 +188,20 @@ void task_control::run (void)
 // 		   *p_serial << PMS ("Finished Route! ") << endl << endl;
 // 	       }
 	  }
-		 
-     runs++;					// Increment the timer run counter.
-     delay_from_for_ms (previousTicks, 10);	// Task runs every 10 ms
-     }
+
+     pipeline::release (EV_CONTROLLED);
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** This method is called between steps when the control step has a task of its own. It waits for the power
+ *  step to release it once the speeds are found, or for 10 ms when \c PIPELINE_TASKS isn't set.
+ *  @param previous_ticks The time at which the step last ran, which is updated here
+ *  @param period The task's period in RTOS ticks; the pipeline's period is used instead
+ *  @return True if the step woke at the time put in \c previous_ticks rather than on being released
+ */
+
+bool task_control::wait_for_next (TickType_t& previous_ticks, TickType_t period)
+{
+     (void)period;
+     return (pipeline::wait (previous_ticks, EV_MEASURED));	// Runs after the speeds are found, or every 10 ms
 }
\ No newline at end of file
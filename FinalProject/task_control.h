@@ -17,6 +17,7 @@
 #include "semphr.h"                         // Header for FreeRTOS semaphores
 
 #include "taskbase.h"                       // ME405/507 base task class
+#include "cyclicexec.h"                     // Periodic steps and the cyclic executive
 #include "task.h"                           // Header for FreeRTOS task functions
 #include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
 #include "queue.h"                          // Header for FreeRTOS queues
@@ -26,22 +27,44 @@
 #include "shares.h"                         // Shared inter-task communications
 
 #include "pid.h"		            // Header for pid functions
+#include "pid_bank.h"			    // Header for banks of PIDs with fixed gains
 #include "routes.h"			    // Header of route library functions
+#include "encoder_snapshot.h"		    // Header for encoder position snapshots
 
-class task_control : public TaskBase
+/** \brief The type of the bank of two motor speed PI controllers, whose gains are fixed at compile time.
+ *  \details The speeds and setpoints are in quarter ticks per 10 ms (see @c encoder_snapshot::VELOCITY_Q),
+ *	      so the gains are those of a loop in whole ticks with Kp = 1, Ki = 0.25 and Kw = 0.25, scaled
+ *	      to give the same output: (1024x) Kp = 256, Ki = 64, Kd = 0 and Kw = 1024. The proportional and
+ *	      integral terms are then shifts and the anti-windup term costs nothing. Channel 0 is motor 1 and
+ *	      channel 1 is motor 2.
+ */
+typedef pid_bank<2, pid::PI, 1024 / 4, 256 / 4, 0, 256 * 4> motor_pid_bank_t;
+
+class task_control : public CyclicStep
 {
 private:
 	/// No private variables or methods for this class
 
 protected:
-	/// No protected variables or methods for this class
+	motor_pid_bank_t motor_pids;		///< PI controllers for both motors
+	int32_t distance;			///< Linear route distance left to travel, in ticks
+	encoder_snapshot odometer;		///< Motor 1's encoder position, which measures distance
+	uint16_t inch_to_ticks;			///< Distance unit conversion
+	int16_t new_servo_error;		///< Heading error
+	int16_t new_servo_angle;		///< New calculated servo angle
   
 public:
 	/// This constructor creates a generic control task of which many copies can be made.
-	task_control (const char*, unsigned portBASE_TYPE, size_t, emstream*);
+	task_control (const char*, emstream*);
  
-	/// This method is called by the RTOS once to run the task loop indefinetly.
-	void run (void);
+	/// This method creates and configures the PID objects before the task loop starts.
+	void setup (void);
+
+	/// This method runs the PID loops and route logic once; it's called every 10 ms.
+	void step (void);
+
+	/// This method waits for the power step to find the speeds when the step has a task of its own.
+	bool wait_for_next (TickType_t& previous_ticks, TickType_t period);
 };
 
 #endif /// _TASK_CONTROL_H__
\ No newline at end of file
@@ -5,6 +5,14 @@
  *  Revisions:
  *    @li 04-13-2016 ME405 Group 3 original file
  *    @li 06-10-2016 Combined task_motor and task_encoder into task_power
+ *    @li 10-17-2026 ME405 Group 3 Speeds are found from 32-bit encoder position snapshots
+ *    @li 10-17-2026 ME405 Group 3 Speeds are estimated from encoder edge times, in quarter ticks
+ *    @li 10-17-2026 ME405 Group 3 Motor speeds and powers go through the shared motor block
+ *    @li 10-17-2026 ME405 Group 3 Waits for the power and braking flags instead of polling them
+ *    @li 10-17-2026 ME405 Group 3 Measures the speeds as soon as the sensor task starts a period
+ *    @li 10-17-2026 ME405 Group 3 Split into setup() and step() so it can run in the cyclic executive
+ *    @li 10-17-2026 ME405 Group 3 wait_for_next() tells whether it woke on time, for the jitter histogram
+ *    @li 10-17-2026 ME405 Group 3 Full braking no longer wakes this task to clear the powers at once
  *
  */
 //***********************************************************************************************************
@@ -15,90 +23,123 @@
 #include "task_power.h"                     // Header for this task
 
 //-------------------------------------------------------------------------------------
-/** This constructor creates a task which controls the ouput of two motors and two encoders. The main job of this constructor
- *  is to call the constructor of parent class (\c frt_task ); the parent's constructor the work.
- *  @param a_name A character string which will be the name of this task
- *  @param a_priority The priority at which this task will initially run (default: 0)
- *  @param a_stack_size The size of this task's stack in bytes (default: configMINIMAL_STACK_SIZE)
- *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this task
- *		     to communicate (default: NULL)
+/** This constructor creates a step which controls the ouput of two motors and two encoders. The motor and
+ *  encoder drivers are made in \c setup(), once the step is running.
+ *  @param a_name A character string which will be the name of this step
+ *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this step
+ *		     to communicate
  */
 
-task_power::task_power (const char* a_name, unsigned portBASE_TYPE a_priority, size_t a_stack_size, 
-		        emstream* p_ser_dev):TaskBase (a_name, a_priority, a_stack_size, p_ser_dev)
+task_power::task_power (const char* a_name, emstream* p_ser_dev)
+	: CyclicStep (a_name, p_ser_dev),
+	  encoder_motor_1 (sh_encoder_position_1, sh_encoder_edge_time_1),
+	  encoder_motor_2 (sh_encoder_position_2, sh_encoder_edge_time_2)
 {
-	// Nothing is done in the body of this constructor. All the work is done in the
-	// call to the frt_task constructor on the line just above this one
+	// Nothing else is done in the body of this constructor
 }
 
 //-------------------------------------------------------------------------------------
-/** This method is called once by the RTOS scheduler. Each time around the for (;;) loop, it measures and calculates
- *  encoder parameters and passes motor velocity changes to the motor.
+/** This method is called once before the first step. It creates the motor drivers and the encoder drivers,
+ *  which set up the encoder interrupts.
  */
 
-void task_power::run (void)
+void task_power::setup (void)
 {
-	// Make a variable which will hold times to use for precise task scheduling
-        TickType_t previousTicks = xTaskGetTickCount ();
-     
-	// Create two motor driver object and a variable in which to store the output. 
-        // The variables p_motor_1 and p_motor_2 only exist within this run() method, so the motors cannot
-	// be used from any other function or method.
-	motor_drv* p_motor_1 = new motor_drv (p_serial, 1);
-	motor_drv* p_motor_2 = new motor_drv (p_serial, 2);
-	sh_power_set_flag->put(0);		// Flag used to only set power when it has changed
+	// Create two motor driver objects; they only exist within this step, so the motors cannot be used
+	// from any other function or method
+	p_motor_1 = new motor_drv (p_serial, 1);
+	p_motor_2 = new motor_drv (p_serial, 2);
+	sh_power_set_flag->put_quietly(0);	// Flag used to only set power when it has changed
 	
-	// Construction of encoder drivers
-        encoder_drv* encoder_driver_1 = new encoder_drv(p_serial, 7);  // 6 and 7 aliased
-        encoder_drv* encoder_driver_2 = new encoder_drv(p_serial, 3);  // 4 and 5 aliased
-	
-        // Initialization of encoder counts before/after used to determine speed 
-        uint16_t encoder_count_new_motor_1 = 0;
-        uint16_t encoder_count_old_motor_1 = 0;
-        uint16_t encoder_count_new_motor_2 = 0;
-        uint16_t encoder_count_old_motor_2 = 0;
+	// Construction of encoder drivers, which set up the encoder interrupts
+        new encoder_drv(p_serial, 7);  // 6 and 7 aliased
+        new encoder_drv(p_serial, 3);  // 4 and 5 aliased
+}
+
+//-------------------------------------------------------------------------------------
+/** This method sets both motor powers if the power flag has been set, or stops both motors if the braking
+ *  flag has been set, and clears the flags it acts on.
+ */
+
+void task_power::apply_flags (void)
+{
+	// Check if power variable has changed, power flag = high, if not skip
+	if (sh_power_set_flag->get() == 1)
+	{
+	     motor_block_t motors = sh_motors->get();		// Both powers from one PID update
+	     p_motor_1 -> set_power(motors.power[0]);		// Set power for motor 1
+	     p_motor_2 -> set_power(motors.power[1]);		// Set power for motor 2
+	     pipeline::record_motor_output ();
+	     
+	     sh_power_set_flag->put_quietly(0);	// Make power_set_flag low when succesful power set
+	}
+	// Clears both motor powers 
+	else if (sh_power_set_flag ->get() == 2)
+	{
+	     p_motor_1 -> set_power(0);
+	     p_motor_2 -> set_power(0);
+	     sh_power_set_flag -> put_quietly(0);
+	}
 	
-	for(;;)
+	// Check if braking full flag is high, if not skip
+	if (sh_braking_full_flag->get() == 1)
 	{
-	       // Sets the new/old variables so speed can be calculated
-	       encoder_count_old_motor_1 = encoder_count_new_motor_1;
-	       encoder_count_new_motor_1 = sh_encoder_count_1->get();
-	       encoder_count_old_motor_2 = encoder_count_new_motor_2;
-	       encoder_count_new_motor_2 = sh_encoder_count_2->get();
-	       
-	       // Sets motor speed variables using difference in encoder readings
-	       sh_motor_1_speed->put(encoder_driver_1->calc_motor(encoder_count_old_motor_1, encoder_count_new_motor_1));
-	       sh_motor_2_speed->put(encoder_driver_2->calc_motor(encoder_count_old_motor_2, encoder_count_new_motor_2));
-	       
-	       
-	       // Check if power variable has changed, power flag = high, if not skip
-	       if (sh_power_set_flag->get() == 1)
-	       {
-		    p_motor_1 -> set_power(sh_PID_1_power->get());	// Set power for motor 1
-		    p_motor_2 -> set_power(sh_PID_2_power->get());	// Set power for motor 2
-	       
-		    sh_power_set_flag->put(0);		// Make power_set_flag low when succesful power set
+	     p_motor_1 -> brake_full();		// Stop motor 1
+	     p_motor_2 -> brake_full();		// Stop motor 2
+		  
+	     // Clear the powers next period, without waking this task, so the brake holds for a period
+	     sh_power_set_flag->put_quietly(2);
+	     sh_braking_full_flag->put_quietly(0);	// Make braking_full_flag low when successful motor stop
+	}
+}
 
-	       }
-	       // Clears both motor powers 
-	       else if (sh_power_set_flag ->get() == 2)
-	       {
-		    p_motor_1 -> set_power(0);
-		    p_motor_2 -> set_power(0);
-		    sh_power_set_flag -> put(0);
-	       }
-       
-	       // Check if braking full flag is high, if not skip
-	       if (sh_braking_full_flag->get() == 1)
-	       {
-		    p_motor_1 -> brake_full();		// Stop motor 1
-		    p_motor_2 -> brake_full();		// Stop motor 2
-			 
-		    sh_power_set_flag->put(2);		// Make power_set_flag low when successful power set
-		    sh_braking_full_flag->put(0);	// Make braking_full_flag low when successful motor stop
-	       }
-	       
-	       runs++;					// Increment the timer run counter.
-	       delay_from_for_ms (previousTicks, 10);	// Task runs every 10 ms
+//-------------------------------------------------------------------------------------
+/** This method is called once each period. It applies any motor powers set since the last period, which
+ *  in the cyclic executive are those set by the previous control step, then measures the motor speeds
+ *  from the encoders and releases the control step.
+ */
+
+void task_power::step (void)
+{
+	apply_flags ();
+
+	// Reads the encoder positions and edge times and sets motor speeds from them
+	encoder_motor_1.update();
+	encoder_motor_2.update();
+	motor_block_t& speeds = sh_motors->begin_write();
+	speeds.speed[0] = encoder_motor_1.get_velocity();
+	speeds.speed[1] = encoder_motor_2.get_velocity();
+	sh_motors->end_write();
+	pipeline::release (EV_MEASURED);
+}
+
+//-------------------------------------------------------------------------------------
+/** This method is called between steps when the power step has a task of its own. Until the next period
+ *  begins, the task sleeps until the power or braking flag is written, so that a new power takes effect
+ *  within a tick of being set rather than at the next period. With \c PIPELINE_TASKS set, the period begins
+ *  when the sensor task releases it, or after a stall time.
+ *  @param previous_ticks The time at which the previous period began, which is updated here
+ *  @param period The task's period in RTOS ticks, which is used when \c PIPELINE_TASKS isn't set
+ *  @return True if the period began at the time put in \c previous_ticks rather than on being released
+ */
+
+bool task_power::wait_for_next (TickType_t& previous_ticks, TickType_t period)
+{
+#if PIPELINE_TASKS
+	const EventBits_t wake_bits = EV_POWER_SET | EV_BRAKING_FULL | EV_SENSED;
+	period = configMS_TO_TICKS (PIPELINE_STALL_MS);
+#else
+	const EventBits_t wake_bits = EV_POWER_SET | EV_BRAKING_FULL;
+#endif
+	TickType_t next_period = previous_ticks + period;
+	TickType_t ticks_left;				// Wraps to a huge number once the period is over
+	EventBits_t events = 0;
+	while (!(events & EV_SENSED)
+	       && (ticks_left = next_period - xTaskGetTickCount ()) - 1 < period)
+	{
+	     events = xEventGroupWaitBits (ev_tasks, wake_bits, pdTRUE, pdFALSE, ticks_left);
+	     apply_flags ();
 	}
-}
\ No newline at end of file
+	previous_ticks = (events & EV_SENSED) ? xTaskGetTickCount () : next_period;
+	return (!(events & EV_SENSED));
+}
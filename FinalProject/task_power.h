@@ -5,6 +5,7 @@
  *  Revisions:
  *    @li 04-13-2016 ME405 Group 3 original file
  *    @li 06-10-2016 Combined task_encoder and task_motor into task_power
+ *    @li 10-17-2026 ME405 Group 3 Made a cyclic step which can share a task with the other periodic steps
  *
  */
 //======================================================================================
@@ -21,6 +22,7 @@
 #include "semphr.h"                         // Header for FreeRTOS semaphores
 
 #include "taskbase.h"                       // ME405/507 base task class
+#include "cyclicexec.h"                     // Periodic steps and the cyclic executive
 #include "task.h"                           // Header for FreeRTOS task functions
 #include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
 #include "queue.h"                          // Header for FreeRTOS queues
@@ -31,21 +33,34 @@
 
 #include "motor_drv.h"                      // Include header for the motor class
 #include "encoder_drv.h"                    // Include header for the encoder class
+#include "encoder_snapshot.h"               // Include header for encoder position snapshots
 
-class task_power : public TaskBase
+class task_power : public CyclicStep
 {
 private:
 	/// No private variables or methods for this class
 
 protected:
-	/// No protected variables or methods for this class
+	motor_drv* p_motor_1;			///< Driver for motor 1
+	motor_drv* p_motor_2;			///< Driver for motor 2
+	encoder_snapshot encoder_motor_1;	///< Snapshot of motor 1's encoder, from which its speed is found
+	encoder_snapshot encoder_motor_2;	///< Snapshot of motor 2's encoder, from which its speed is found
+
+	/// This method sets the motor powers or brakes the motors if the power or braking flag is set.
+	void apply_flags (void);
   
 public:
 	/// This constructor creates a generic motor task of which many copies can be made.
-	task_power (const char*, unsigned portBASE_TYPE, size_t, emstream*);
- 
-	/// This method is called by the RTOS once to run the task loop for ever and ever.
-	void run (void);
+	task_power (const char*, emstream*);
+
+	/// This method creates the motor and encoder drivers before the first step.
+	void setup (void);
+
+	/// This method applies any new motor powers and measures the motor speeds; it's called every 10 ms.
+	void step (void);
+
+	/// This method waits for the next period, setting the motor powers whenever they're changed meanwhile.
+	bool wait_for_next (TickType_t& previous_ticks, TickType_t period);
 };
 
 #endif /// _Task_POWER_H__
\ No newline at end of file
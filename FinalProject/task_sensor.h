@@ -18,6 +18,7 @@
 #include "semphr.h"                         // Header for FreeRTOS semaphores
 
 #include "taskbase.h"                       // ME405/507 base task class
+#include "cyclicexec.h"                     // Periodic steps and the cyclic executive
 #include "task.h"                           // Header for FreeRTOS task functions
 #include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
 #include "queue.h"                          // Header for FreeRTOS queues
@@ -27,21 +28,27 @@
 #include "shares.h"                         // Shared inter-task communications
 
 #include "imu_drv.h"                        // Include header for the IMU driver class
+#include "adc.h"			    // Header for the adc class 
 
-class task_sensor : public TaskBase
+class task_sensor : public CyclicStep
 {
 private:
 	/// No private variables or methods for this class
 
 protected:
-	/// No protected variables or methods for this class
+	adc* side_IR_adc;			///< ADC for the side IR distance sensor
+	adc* front_IR_adc;			///< ADC for the front IR distance sensor
+	imu_drv* imu_sensor;			///< Driver for the IMU
   
 public:
 	/// This constructor creates a generic sensor task of which many copies can be made.
-	task_sensor (const char*, unsigned portBASE_TYPE, size_t, emstream*);
+	task_sensor (const char*, emstream*);
+
+	/// This method creates the IMU and ADC objects before the first step.
+	void setup (void);
  
-	/// This method is called by the RTOS once to run the task loop indefinetly.
-	void run (void);
+	/// This method reads the sensors once; it's called every 10 ms.
+	void step (void);
 };
 
 #endif /// _TASK_SENSOR_H__
\ No newline at end of file
@@ -0,0 +1,165 @@
+//***********************************************************************************************************
+/** @file task_sim.cpp
+ *  This file contains the code for a task which simulates the car's hardware in the host (PC) build of the
+ *  project. Every 10 ms it applies the PID power to a simple model of each drive motor, counts the simulated
+ *  encoder ticks and turns the car's heading according to the steering servo setpoint. The results go into
+ *  the same shares which \c task_power and \c task_sensor fill on the real car, so \c task_control runs
+ *  unchanged. When the run time is over the task prints the shares and the task list, then stops the
+ *  scheduler so that the program exits.
+ *
+ *  Revisions:
+ *    @li 10-17-2026 ME405 Group 3 original file
+ *    @li 10-17-2026 ME405 Group 3 Simulated encoders give 32-bit positions
+ *    @li 10-17-2026 ME405 Group 3 Simulated encoders give edge times; speeds are in quarter ticks
+ *    @li 10-17-2026 ME405 Group 3 Motor, route and IMU state go through shared blocks
+ *    @li 10-17-2026 ME405 Group 3 Starts each period of the control task pipeline and times its outputs
+ *    @li 10-17-2026 ME405 Group 3 Times each pass through the loop for the task list
+ *    @li 10-17-2026 ME405 Group 3 Prints each task's missed deadlines and wake up jitter at the end
+ *    @li 10-17-2026 ME405 Group 3 Dumps the trace buffer at the end when it's turned on
+ *    @li 10-17-2026 ME405 Group 3 The task's stack can be given to the constructor
+ *    @li 10-17-2026 ME405 Group 3 Full braking sets the power flag quietly, as task_power does
+ *
+ */
+//***********************************************************************************************************
+#include "textqueue.h"                      // Header for text queue class
+#include "taskshare.h"			    // Header for thread-safe shared data
+#include "shares.h"                         // Shared inter-task communications
+
+#include "task_sim.h"                       // Header for this task
+
+//-----------------------------------------------------------------------------------------------------------
+/** This constructor creates a task which simulates the car's motors, encoders, steering and IMU. The main
+ *  job of this constructor is to call the constructor of parent class (\c frt_task ); the parent's
+ *  constructor the work.
+ *  @param a_name A character string which will be the name of this task
+ *  @param a_priority The priority at which this task will initially run (default: 0)
+ *  @param a_stack_size The size of this task's stack in bytes (default: configMINIMAL_STACK_SIZE)
+ *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this task
+ *		     to communicate (default: NULL)
+ *  @param a_run_time_ms The number of milliseconds after which the simulation is stopped
+ *  @param p_stack_buffer Memory for the task's stack, or NULL to take the stack from the heap (default: NULL)
+ */
+
+task_sim::task_sim (const char* a_name, unsigned portBASE_TYPE a_priority, size_t a_stack_size,
+		    emstream* p_ser_dev, uint32_t a_run_time_ms, StackType_t* p_stack_buffer)
+	: TaskBase (a_name, a_priority, a_stack_size, p_ser_dev, p_stack_buffer)
+{
+	run_time_ms = a_run_time_ms;
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** This method is called once by the RTOS scheduler. Each time around the for (;;) loop it sets the motor
+ *  power the way \c task_power does, then updates a first order model of each motor in which full power
+ *  (1600) gives 100 encoder ticks per 10 ms with a time constant of about 40 ms. The servo setpoint is turned
+ *  back into a steering angle with the inverse of \c routes::servo_power() and the heading changes in
+ *  proportion to the steering angle and the speed of motor 1. As it takes the place of the sensor and power
+ *  tasks, it starts each period of the pipeline and releases the control task once the speeds are found.
+ */
+
+void task_sim::run (void)
+{
+     // Make a variable which will hold times to use for precise task scheduling
+     TickType_t previousTicks = xTaskGetTickCount ();
+     TickType_t startTicks = previousTicks;
+
+     int16_t power_1 = 0;				// Power applied to motor 1
+     int16_t power_2 = 0;				// Power applied to motor 2
+     int16_t speed_1 = 0;				// Simulated motor 1 speed, ticks per 10 ms
+     int16_t speed_2 = 0;				// Simulated motor 2 speed, ticks per 10 ms
+     int32_t position_1 = 0;				// Simulated encoder positions
+     int32_t position_2 = 0;
+     encoder_snapshot encoder_motor_1 (sh_encoder_position_1, sh_encoder_edge_time_1);
+     encoder_snapshot encoder_motor_2 (sh_encoder_position_2, sh_encoder_edge_time_2);
+     time_stamp now;					// Time at which the simulated encoders move
+     int32_t heading = 0;				// Simulated Euler heading
+     int16_t steer_angle = 0;				// Steering angle from the servo setpoint
+
+     sh_power_set_flag->put_quietly(0);
+     sh_servo_setpoint->put(3000);			// Straight position for servo at start up
+     sh_imu->begin_write().heading = 0;
+     sh_imu->end_write();
+     sh_encoder_position_1->put(0);
+     sh_encoder_position_2->put(0);
+
+     for(;;)
+     {
+	  exec_time.begin ();
+
+	  // Take up new motor power settings in the same way as task_power
+	  if (sh_power_set_flag->get() == 1)
+	  {
+	       motor_block_t motors = sh_motors->get();
+	       power_1 = motors.power[0];
+	       power_2 = motors.power[1];
+	       pipeline::record_motor_output ();
+	       sh_power_set_flag->put_quietly(0);
+	  }
+	  else if (sh_power_set_flag->get() == 2)
+	  {
+	       power_1 = 0;
+	       power_2 = 0;
+	       sh_power_set_flag->put_quietly(0);
+	  }
+	  if (sh_braking_full_flag->get() == 1)
+	  {
+	       power_1 = 0;
+	       power_2 = 0;
+	       speed_1 = 0;
+	       speed_2 = 0;
+	       sh_power_set_flag->put_quietly(2);
+	       sh_braking_full_flag->put_quietly(0);
+	  }
+
+	  // First order motor models, then the encoders count the ticks moved in this period
+	  speed_1 += (power_1 / 16 - speed_1) / 4;
+	  speed_2 += (power_2 / 16 - speed_2) / 4;
+
+	  // The servo setpoint from the previous period is taken up below, then a new sample begins. All of a
+	  // period's ticks are taken to come at once, at the time this period was scheduled to start
+	  pipeline::record_servo_output ();
+	  pipeline::mark_sample ();
+	  now = time_stamp (previousTicks, 0);
+	  position_1 += speed_1;
+	  position_2 += speed_2;
+	  sh_encoder_position_1->put(position_1);
+	  sh_encoder_position_2->put(position_2);
+	  if (speed_1 != 0) sh_encoder_edge_time_1->put(now);
+	  if (speed_2 != 0) sh_encoder_edge_time_2->put(now);
+
+	  // Speeds are estimated from the encoder positions and edge times, as task_power does it
+	  encoder_motor_1.update();
+	  encoder_motor_2.update();
+	  motor_block_t& speeds = sh_motors->begin_write();
+	  speeds.speed[0] = encoder_motor_1.get_velocity();
+	  speeds.speed[1] = encoder_motor_2.get_velocity();
+	  sh_motors->end_write();
+	  pipeline::release (EV_MEASURED);
+
+	  // The heading turns according to the steering angle and how fast the car is going
+	  steer_angle = (3034 - (int16_t)(sh_servo_setpoint->get())) / 34;
+	  heading += ((int32_t)steer_angle * speed_1) / 64;
+	  sh_imu->begin_write().heading = heading;
+	  sh_imu->end_write();
+
+	  // When the run time is over, show what happened and stop the scheduler
+	  if ((xTaskGetTickCount () - startTicks) >= configMS_TO_TICKS (run_time_ms))
+	  {
+	       *p_serial << PMS ("Simulation finished after ") << run_time_ms << PMS (" ms") << endl;
+		       *p_serial << PMS ("Encoders: ") << position_1 << PMS (", ")
+				 << position_2 << PMS ("  Heading: ") << heading
+				 << PMS ("  Route running: ") << sh_route->get().linear_start << endl;
+	       pipeline::print_latency (p_serial);
+	       print_all_shares (p_serial);
+	       print_task_list (p_serial);
+	       print_task_timing (p_serial);
+#if (configUSE_TRACE_BUFFER == 1)
+	       trace_buffer_dump (p_serial);
+#endif
+	       vTaskEndScheduler ();
+	  }
+
+	  exec_time.end ();
+	  runs++;					// Increment the timer run counter.
+	  delay_from_for_ms (previousTicks, 10);	// Task runs every 10 ms
+     }
+}
@@ -0,0 +1,47 @@
+//===========================================================================================================
+/** @file task_sim.h
+ *  This file contains the header for a task class which is used in the host (PC) build of the project in
+ *  place of the tasks which talk to the car's hardware. It simulates the motors, encoders, steering servo
+ *  and IMU heading through the same shares that \c task_power, \c task_sensor and \c task_steer use.
+ *
+ *  Revisions:
+ *    @li 10-17-2026 ME405 Group 3 original file
+ *    @li 10-17-2026 ME405 Group 3 The task's stack can be given to the constructor
+ *
+ */
+//===========================================================================================================
+
+/// This define prevents this .H file from being included multiple times in a .CPP file
+#ifndef _TASK_SIM_H_
+#define _TASK_SIM_H_
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+
+#include "emstream.h"                       // Header for serial ports and devices
+#include "FreeRTOS.h"                       // Header for the FreeRTOS RTOS
+#include "task.h"                           // Header for FreeRTOS task functions
+
+#include "taskbase.h"                       // ME405/507 base task class
+#include "taskshare.h"			    // Header for thread-safe shared data
+#include "textqueue.h"                      // Header for text queue class
+#include "shares.h"                         // Shared inter-task communications
+#include "encoder_snapshot.h"               // Header for encoder position snapshots
+
+class task_sim : public TaskBase
+{
+private:
+	/// No private variables or methods for this class
+
+protected:
+	/// The number of milliseconds for which the simulation runs before the scheduler is stopped
+	uint32_t run_time_ms;
+
+public:
+	/// This constructor creates a simulation task which stops the scheduler after the given time.
+	task_sim (const char*, unsigned portBASE_TYPE, size_t, emstream*, uint32_t, StackType_t* = NULL);
+
+	/// This method is called by the RTOS once to run the task loop until the run time is over.
+	void run (void);
+};
+
+#endif /// _TASK_SIM_H_
@@ -6,6 +6,9 @@
  *
  *  Revisions:
  *    @li May 19, 2016 -- BKK Created file
+ *    @li 10-17-2026 ME405 Group 3 Runs when the control task has set a new servo setpoint
+ *    @li 10-17-2026 ME405 Group 3 Split into setup() and step() so it can run in the cyclic executive
+ *    @li 10-17-2026 ME405 Group 3 wait_for_next() tells whether it woke on time, for the jitter histogram
  *
  */
 //***********************************************************************************************************
@@ -16,51 +19,61 @@
 #include "task_steer.h"                     // Header for this task
 
 //-----------------------------------------------------------------------------------------------------------
-/** This constructor creates a task which controls the ouput of the steering servo. The main job of this
- *  constructor is to call the constructor of parent class (\c frt_task ); the parent's constructor the work.
- *  @param a_name A character string which will be the name of this task
- *  @param a_priority The priority at which this task will initially run (default: 0)
- *  @param a_stack_size The size of this task's stack in bytes (default: configMINIMAL_STACK_SIZE)
- *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this task
- *		     to communicate (default: NULL)
+/** This constructor creates a step which controls the ouput of the steering servo. The servo and trim
+ *  potentiometer objects are made in \c setup(), once the step is running.
+ *  @param a_name A character string which will be the name of this step
+ *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this step
+ *		     to communicate
  */
 
-task_steer::task_steer (const char* a_name, unsigned portBASE_TYPE a_priority, size_t a_stack_size, 
-			emstream* p_ser_dev): TaskBase (a_name, a_priority, a_stack_size, p_ser_dev)
+task_steer::task_steer (const char* a_name, emstream* p_ser_dev): CyclicStep (a_name, p_ser_dev)
 {
 	// Nothing is done in the body of this constructor. 
 }
 
 //-----------------------------------------------------------------------------------------------------------
-/** This method is called once by the RTOS scheduler. Each time around the for (;;) loop, it instatiates a
- *  new servo object and reading a steering trim potentiometer to adjust the centering of our steering linkage. 
- *  The steering position is set with a shared setpoint variable.
+/** This method is called once before the first step. It instatiates a new servo object and reads a
+ *  steering trim potentiometer to adjust the centering of our steering linkage, then centers the steering.
  */
 
-void task_steer::run (void)
+void task_steer::setup (void)
 {
-     // Make a variable which will hold times to use for precise task scheduling
-     TickType_t previousTicks = xTaskGetTickCount ();
-     
      // Declaration of servo object
-     servo_drv* steer_servo = new servo_drv(p_serial);
+     steer_servo = new servo_drv(p_serial);
      
      // Declaration of an adc object to be used for steering trim
-     adc* adc_1 = new adc(p_serial);
+     adc_1 = new adc(p_serial);
      
      // Reads adc reading of a potentiometer and adds it to the servo position for setting center position
-     int16_t steering_trim = (adc_1->read_oversampled(0,10) / 2) + -127;
+     steering_trim = (adc_1->read_oversampled(0,10) / 2) + -127;
      sh_servo_setpoint->put(3000 + steering_trim);		// Straight position for servo at start up
      steer_servo->set_Pos(sh_servo_setpoint->get());
-     
-     // Max servo PWM = 2000 to 4000
-     for(;;) 
-     {
-	  // Adds steering trim and sets servo position
-	  steering_trim = (adc_1->read_oversampled(0,10) / 2) + -127; 
-	  steer_servo->set_Pos(sh_servo_setpoint->get()+ steering_trim);
+}
+
+//-----------------------------------------------------------------------------------------------------------
+/** This method is called once each period. The steering position is set with a shared setpoint variable
+ *  as soon as the control step has set it; the trim is read afterwards, so the slow oversampled reading
+ *  doesn't delay the new position. Max servo PWM = 2000 to 4000.
+ */
+
+void task_steer::step (void)
+{
+     // Adds steering trim and sets servo position
+     steer_servo->set_Pos(sh_servo_setpoint->get()+ steering_trim);
+     pipeline::record_servo_output ();
+     steering_trim = (adc_1->read_oversampled(0,10) / 2) + -127; 
+}
 
-	  runs++;					// Increment the timer run counter.
-	  delay_from_for_ms (previousTicks, 10);	// Task runs every 10 ms
-     }
-}
\ No newline at end of file
+//-----------------------------------------------------------------------------------------------------------
+/** This method is called between steps when the steering step has a task of its own. It waits for the
+ *  control step to release it, or for 10 ms when \c PIPELINE_TASKS isn't set.
+ *  @param previous_ticks The time at which the step last ran, which is updated here
+ *  @param period The task's period in RTOS ticks; the pipeline's period is used instead
+ *  @return True if the step woke at the time put in \c previous_ticks rather than on being released
+ */
+
+bool task_steer::wait_for_next (TickType_t& previous_ticks, TickType_t period)
+{
+     (void)period;
+     return (pipeline::wait (previous_ticks, EV_CONTROLLED));	// Runs after the control step, or every 10 ms
+}
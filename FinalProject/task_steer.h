@@ -5,6 +5,7 @@
  *
  *  Revisions:
  *    @li May 19, 2016 -- BKK Created file
+ *    @li 10-17-2026 ME405 Group 3 Made a cyclic step which can share a task with the other periodic steps
  *
  */
 //===========================================================================================================
@@ -21,6 +22,7 @@
 #include "semphr.h"                         // Header for FreeRTOS semaphores
 
 #include "taskbase.h"                       // ME405/507 base task class
+#include "cyclicexec.h"                     // Periodic steps and the cyclic executive
 #include "task.h"                           // Header for FreeRTOS task functions
 #include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
 #include "queue.h"                          // Header for FreeRTOS queues
@@ -32,20 +34,28 @@
 #include "servo_drv.h"                      // Include header for the servo class
 #include "adc.h"			    // Header for ADC
 
-class task_steer : public TaskBase
+class task_steer : public CyclicStep
 {
 private:
 	/// No private variables or methods for this class
 
 protected:
-	/// No protected variables or methods for this class
+	servo_drv* steer_servo;			///< Driver for the steering servo
+	adc* adc_1;				///< ADC for the steering trim potentiometer
+	int16_t steering_trim;			///< Trim added to the servo setpoint to center the steering
   
 public:
 	/// This constructor creates a generic servo task of which many copies can be made.
-	task_steer (const char*, unsigned portBASE_TYPE, size_t, emstream*);
+	task_steer (const char*, emstream*);
+
+	/// This method creates the servo and ADC objects and centers the steering before the first step.
+	void setup (void);
  
-	/// This method is called by the RTOS once to run the task loop indefinetly.
-	void run (void);
+	/// This method sets the servo position once; it's called every 10 ms.
+	void step (void);
+
+	/// This method waits for the control step to set a new servo setpoint when the step has its own task.
+	bool wait_for_next (TickType_t& previous_ticks, TickType_t period);
 };
 
 #endif /// _TASK_STEER_H__
\ No newline at end of file
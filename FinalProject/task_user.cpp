@@ -9,6 +9,13 @@
  *    @li 11-04-2012 JRR Modified from the data acquisition example to the test suite
  *    @li 01-04-2014 JRR Changed base class names to TaskBase, TaskShare, etc.
  *    @li April 29, 2016 -- BKK Cleaned up comments, added return command to Main Menu
+ *    @li 10-17-2026 ME405 Group 3 Route, motor setpoint and IMU requests go through shared blocks
+ *    @li 10-17-2026 ME405 Group 3 Added a help menu command showing the sensor to PWM delays
+ *    @li 10-17-2026 ME405 Group 3 Times each pass through the loop for the task list
+ *    @li 10-17-2026 ME405 Group 3 Added a help menu command showing missed deadlines and wake up jitter
+ *    @li 10-17-2026 ME405 Group 3 Added a help menu command which dumps the trace buffer
+ *    @li 10-17-2026 ME405 Group 3 The task's stack can be given to the constructor
+ *    @li 10-17-2026 ME405 Group 3 Copies text from the print queue in blocks
  *
  *  License:
  *	This file is copyright 2015 by JR Ridgely and released under the Lesser GNU Public License, 
@@ -62,10 +69,12 @@ const TickType_t ticks_to_delay = ((configTICK_RATE_HZ / 1000) * 5);
  *  @param a_stack_size The size of this task's stack in bytes (default: configMINIMAL_STACK_SIZE)
  *  @param p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which can be used by this task
  *		     to communicate (default: NULL)
+ *  @param p_stack_buffer Memory for the task's stack, or NULL to take the stack from the heap (default: NULL)
  */
 
 task_user::task_user (const char* a_name, unsigned portBASE_TYPE a_priority, size_t a_stack_size, 
-		      emstream* p_ser_dev):TaskBase (a_name, a_priority, a_stack_size, p_ser_dev)
+		      emstream* p_ser_dev, StackType_t* p_stack_buffer)
+		      :TaskBase (a_name, a_priority, a_stack_size, p_ser_dev, p_stack_buffer)
 {
 	// Nothing is done in the body of this constructor. All the work is done in the
 	// call to the frt_task constructor on the line just above this one
@@ -96,6 +105,8 @@ void task_user::run (void)
      // This is an infinite loop; it runs until the power is turned off; one for each task.
      for (;;)
      {
+	  exec_time.begin ();
+
 	  // Run the finite state machine. The variable 'state' is kept by parent class
 	  switch (state)
 	  {
@@ -178,8 +189,26 @@ void task_user::run (void)
 			      
 			      // The 'i' command: displays IMU calibration status
 			      case ('i'):
-				   sh_imu_status->put(1);
+				   sh_imu->begin_write().status_request = 1;
+				   sh_imu->end_write();
+				   break;
+
+			      // The 'l' command: displays the delays from sensor sample to motor and servo PWM
+			      case ('l'):
+				   pipeline::print_latency (p_serial);
+				   break;
+
+			      // The 'j' command: displays each task's missed deadlines and wake up times
+			      case ('j'):
+				   print_task_timing (p_serial);
+				   break;
+
+#if (configUSE_TRACE_BUFFER == 1)
+			      // The 'x' command: dumps the task switch trace, to be read by trace2json
+			      case ('x'):
+				   trace_buffer_dump (p_serial);
 				   break;
+#endif
 				   
 			      // A Ctrl-C character causes the CPU to restart
 			      case (3):
@@ -250,7 +279,8 @@ void task_user::run (void)
 			      {
 				   if (number_entered > 15 && number_entered <= 30)
 				   {
-					sh_path_radius->put(number_entered);	// Set servo position to number_entered
+					sh_route->begin_write().radius = number_entered;	// Set the route radius to number_entered
+					sh_route->end_write();
 					number_entered = 0;			// Clear number_entered
 					number_state = 3;			// Sets to velocity entry number state
 					*p_serial << PMS ("Please enter a circular path velocity [0, 80]") << endl;		// Display error message for out of range
@@ -268,7 +298,8 @@ void task_user::run (void)
 			      {
 				   if (number_entered > 0 && number_entered <= 180)
 				   {
-					sh_linear_distance->put(number_entered);	// Set motor setpoint 1 to number_entered
+					sh_route->begin_write().distance = number_entered;	// Set the route distance to number_entered
+					sh_route->end_write();
 					number_entered = 0;				// Clear number_entered
 					number_state = 3;				// Sets to velocity entry number state	
 					*p_serial << endl << PMS ("Please enter a linear path velocity [0, 80]") << endl; 	// Display error message for out of range
@@ -287,13 +318,17 @@ void task_user::run (void)
 			      {
 				   if (number_entered > 0 && number_entered <= 80)
 				   {
-					sh_path_velocity->put(number_entered);	// Set path velocity setpoint to number_entered
+					// The velocity is set and the route started together, so the control task
+					// never sees a started route without its velocity
+					route_block_t& route = sh_route->begin_write();
+					route.velocity = number_entered;	// Set path velocity setpoint to number_entered
+					if (route.linear_start == 1)
+					     route.mode = 1; 			// Sets linear route control enable
+					if (route.circular_start == 1)
+					     route.mode = 2;			// Sets circular route control enable
+					sh_route->end_write();
 					number_entered = 0;			// Clear number_entered
 					number_state = 0;			// Clear number_state
-					if (sh_linear_start ->get() == 1)
-					     sh_PID_control->put(1); 		// Sets linear route control enable
-					if (sh_circular_start->get() == 1)
-					     sh_PID_control->put(2);		// Sets circular route control enable
 					transition_to (ROUTES);
 				   }
 				   else
@@ -314,7 +349,10 @@ void task_user::run (void)
 
 		    // Check the print queue to see if another task has sent something to be printed
 		    else if (p_print_ser_queue->check_for_char ())
-			 p_serial->putchar (p_print_ser_queue->getchar ());
+		    {
+			 char block[16];				// Characters copied out of the queue together
+			 p_serial->write (block, p_print_ser_queue->read (block, sizeof (block), 0));
+		    }
 
 		    break; // End of state 1
 
@@ -332,8 +370,13 @@ void task_user::run (void)
 				   // The 'l' command activates linear heading adherance
 				   case ('l'):
 					*p_serial << PMS ("Enter distance of linear path [0,180] inches") << endl;
-					sh_heading_setpoint->put(sh_euler_heading->get());                         // Sets heading setpoint for linear path
-					sh_linear_start ->put(1);						   // Sets linear start initialization flag
+					{
+					     int32_t heading = sh_imu->get().heading;
+					     route_block_t& route = sh_route->begin_write();
+					     route.heading_setpoint = heading;				   // Sets heading setpoint for linear path
+					     route.linear_start = 1;					   // Sets linear start initialization flag
+					     sh_route->end_write();
+					}
 					number_state = 2; 							   // Sets number state for entering linear path distance
 					transition_to (NUMBER);
 					break;
@@ -341,7 +384,8 @@ void task_user::run (void)
 				   // The 'c' command activates circular path routing
 				   case ('c'):
 					*p_serial << PMS ("Enter radius of circular path [15,30] inches") << endl;
-					sh_circular_start ->put(1);						   // Sets circular start initialization flag
+					sh_route->begin_write().circular_start = 1;				   // Sets circular start initialization flag
+					sh_route->end_write();
 					number_state = 1;							   // Sets number state for entering circle radius
 					transition_to (NUMBER);
 					break;
@@ -379,11 +423,15 @@ void task_user::run (void)
 			 {
 			      // The 'w' command increments the motor power by 10
 			      case ('w'):
-				   sh_setpoint_1-> put(sh_setpoint_1 -> get()+10); // Saturates max power to 80
-				   if (sh_setpoint_1 -> get() >= 80)
-				     sh_setpoint_1 -> put(80);
-				   sh_setpoint_2-> put(sh_setpoint_1->get()); // Sets motor 2 to motor 1 setpoint
-				   *p_serial << PMS ("Current Motor Velocities: ") << sh_setpoint_1->get() << endl;
+				   {
+					motor_block_t& motors = sh_motors->begin_write();
+					motors.setpoint[0] += 10; // Saturates max power to 80
+					if (motors.setpoint[0] >= 80)
+					  motors.setpoint[0] = 80;
+					motors.setpoint[1] = motors.setpoint[0]; // Sets motor 2 to motor 1 setpoint
+					sh_motors->end_write();
+				   }
+				   *p_serial << PMS ("Current Motor Velocities: ") << sh_motors->get().setpoint[0] << endl;
 				   *p_serial << PMS ("Current Servo Position: ") << sh_servo_setpoint->get() << endl;
 				   *p_serial << endl;
 				   transition_to (DRIVE);
@@ -391,11 +439,15 @@ void task_user::run (void)
 
 			      // The 's' command decrements the motor power by 10
 			      case ('s'):
-				   sh_setpoint_1-> put(sh_setpoint_1 -> get()-10); // Saturates max power to 
-				   if (sh_setpoint_1 -> get() <= -80)
-				     sh_setpoint_1 -> put(-80);
-				   sh_setpoint_2-> put(sh_setpoint_1->get()); // Saturates max power to 255
-				   *p_serial << PMS ("Current Motor Velocities: ") << sh_setpoint_1->get() << endl;
+				   {
+					motor_block_t& motors = sh_motors->begin_write();
+					motors.setpoint[0] -= 10; // Saturates max power to 
+					if (motors.setpoint[0] <= -80)
+					  motors.setpoint[0] = -80;
+					motors.setpoint[1] = motors.setpoint[0]; // Saturates max power to 255
+					sh_motors->end_write();
+				   }
+				   *p_serial << PMS ("Current Motor Velocities: ") << sh_motors->get().setpoint[0] << endl;
 				   *p_serial << PMS ("Current Servo Position: ") << sh_servo_setpoint->get() << endl;
 				   *p_serial << endl;
 				   transition_to (DRIVE);
@@ -406,7 +458,7 @@ void task_user::run (void)
 				   sh_servo_setpoint -> put(sh_servo_setpoint->get()+100);
 				   if (sh_servo_setpoint -> get() >= 4000) // Saturates max angle to 29
 				     sh_servo_setpoint -> put(4000);
-				   *p_serial << PMS ("Current Motor Velocities: ") << sh_setpoint_1->get() << endl;
+				   *p_serial << PMS ("Current Motor Velocities: ") << sh_motors->get().setpoint[0] << endl;
 				   *p_serial << PMS ("Current Servo Position: ") << sh_servo_setpoint->get() << endl;
 				   *p_serial << endl;
 				   transition_to (DRIVE);
@@ -417,7 +469,7 @@ void task_user::run (void)
 				   sh_servo_setpoint -> put(sh_servo_setpoint->get()-100); // Saturates min angle to 15
 				   if (sh_servo_setpoint -> get() <= 2000)
 				     sh_servo_setpoint -> put(2000);
-				   *p_serial << PMS ("Current Motor Velocities: ") << sh_setpoint_1->get() << endl;
+				   *p_serial << PMS ("Current Motor Velocities: ") << sh_motors->get().setpoint[0] << endl;
 				   *p_serial << PMS ("Current Servo Position: ") << sh_servo_setpoint->get() << endl;
 				   *p_serial << endl;
 				   transition_to (DRIVE);
@@ -454,6 +506,7 @@ void task_user::run (void)
 		    break;
 	  } // End switch state
 
+	  exec_time.end ();
 	  runs++;			// Increment counter for debugging
 	  delay_ms (50);		// Delay 50 millisecond to all lower priority tasks to run
      }
@@ -497,6 +550,11 @@ void task_user::print_help_menu (void)
      *p_serial << PMS ("    s:      Version/Setup information") << endl;
      *p_serial << PMS ("    d:      Stack dump for tasks") << endl;
      *p_serial << PMS ("    i:      Print IMU status codes") << endl;
+     *p_serial << PMS ("    l:      Show sensor to PWM latency") << endl;
+     *p_serial << PMS ("    j:      Show task deadline misses and jitter") << endl;
+#if (configUSE_TRACE_BUFFER == 1)
+     *p_serial << PMS ("    x:      Dump the task switch trace") << endl;
+#endif
      *p_serial << PMS ("  Ctl-C:    Reset AVR microcontroller") << endl;
      *p_serial << PMS ("    r:      Return to Main Menu") << endl;
      *p_serial << endl;
@@ -77,7 +77,7 @@ protected:
 
 public:
 	/// This constructor creates a user interface task object
-	task_user (const char*, unsigned portBASE_TYPE, size_t, emstream*);
+	task_user (const char*, unsigned portBASE_TYPE, size_t, emstream*, StackType_t* = NULL);
 
 	/// This method is called by the RTOS once to run the task loop for ever and ever.
 	void run (void);
@@ -0,0 +1,392 @@
+//***********************************************************************************************************
+/** \file telem2csv.cpp
+ *    This file contains a program for the PC which decodes the binary records sent by a \c Telemetry task
+ *    and writes them out as CSV, one line for each data record. The first columns are the record's sequence
+ *    number and its time in microseconds; then comes one column for each channel, named as the telemetry
+ *    task named it. Records whose CRC doesn't match are skipped, and a gap in the sequence numbers shows
+ *    that records were lost; both are counted and reported at the end. Log records, sent by \c log_id(),
+ *    have their values put into the text of their message from \c log_messages.h, and are printed on
+ *    standard error with their time so they don't get mixed into the CSV.
+ *
+ *    The program reads from the file or serial device named on the command line, or from standard input,
+ *    and writes the CSV to standard output. Data records are only written once the names of all the
+ *    channels have come in, which takes a second or two. It's built with 'make -f Makefile.host telem2csv'
+ *    and used like this:
+ *    \code
+ *    stty -F /dev/ttyUSB1 57600 raw
+ *    build_host/telem2csv /dev/ttyUSB1 > log.csv
+ *    \endcode
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ *    \li 10-17-2026 ME405 Group 3 Prints log records with the text from log_messages.h
+ */
+//***********************************************************************************************************
+
+#include <stdio.h>                          // Standard C file input and output
+#include <stdint.h>                         // Standard integer types
+#include <string.h>                         // C string handling functions
+#include <string>                           // C++ strings for the channel names
+#include <vector>                           // For the list of channels
+#include "log_messages.h"                   // The text of each log message
+
+// These record types must match those in telemetry.h
+const uint8_t TELEMETRY_DATA = 'D';         ///< A record with one sample of every channel
+const uint8_t TELEMETRY_NAME = 'N';         ///< A record with the name and type of one channel
+const uint8_t TELEMETRY_LOG = 'L';          ///< A record with one entry from the log queue
+
+/// The number of bytes before the values in a data record
+const size_t DATA_HEADER = 6;
+
+/// The number of bytes before the name in a name record
+const size_t NAME_HEADER = 4;
+
+/// The number of bytes before the values in a log record
+const size_t LOG_HEADER = 6;
+
+/// The text of each log message, in the order of their numbers
+static const char* const log_formats[] =
+{
+	#define LOG_MESSAGE(name, format) format,
+	LOG_MESSAGES
+	#undef LOG_MESSAGE
+};
+
+
+/// One channel, as described by a name record
+struct channel_t
+{
+	std::string name;                       ///< The name of the channel, or empty if not yet known
+	char type;                              ///< The type code, such as 'h' for a signed 16-bit value
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function works out the CRC-16/CCITT-FALSE of some bytes, as \c Telemetry::crc16() does.
+ *  @param p_data The bytes
+ *  @param length The number of bytes
+ *  @return The CRC
+ */
+
+static uint16_t crc16 (const uint8_t* p_data, size_t length)
+{
+	uint16_t crc = 0xFFFF;
+	for (size_t index = 0; index < length; index++)
+	{
+		crc ^= (uint16_t)p_data[index] << 8;
+		for (int bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+		}
+	}
+	return (crc);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function undoes the COBS framing of one frame, without the zero which ended it.
+ *  @param frame The bytes of the frame
+ *  @param record The vector into which the record is put
+ *  @return True if the frame was good, or false if a code byte pointed past its end
+ */
+
+static bool cobs_decode (const std::vector<uint8_t>& frame, std::vector<uint8_t>& record)
+{
+	record.clear ();
+	size_t index = 0;
+	while (index < frame.size ())
+	{
+		uint8_t code = frame[index++];
+		if (code == 0 || index + code - 1 > frame.size ())
+		{
+			return (false);
+		}
+		record.insert (record.end (), frame.begin () + index, frame.begin () + index + code - 1);
+		index += code - 1;
+		if (code != 0xFF && index < frame.size ())
+		{
+			record.push_back (0);
+		}
+	}
+	return (true);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function gets the number of bytes taken by a value of the given type.
+ *  @param type The type code, as in \c telemetry_type or \c log_type
+ *  @return The number of bytes, or 0 if the type code is unknown
+ */
+
+static size_t type_size (char type)
+{
+	switch (type)
+	{
+		case ('b'): case ('B'): case ('c'): return (1);
+		case ('h'): case ('H'): return (2);
+		case ('i'): case ('I'): case ('f'): return (4);
+	}
+	return (0);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function prints one value from a data record.
+ *  @param p_out The file to which the CSV is written
+ *  @param type The type code of the value
+ *  @param p_data The value's bytes, least significant first
+ */
+
+static void print_value (FILE* p_out, char type, const uint8_t* p_data)
+{
+	uint32_t raw = 0;
+	size_t size = type_size (type);
+	for (size_t index = size; index > 0; index--)
+	{
+		raw = (raw << 8) | p_data[index - 1];
+	}
+	switch (type)
+	{
+		case ('b'): fprintf (p_out, ",%d", (int)(int8_t)raw); break;
+		case ('h'): fprintf (p_out, ",%d", (int)(int16_t)raw); break;
+		case ('i'): fprintf (p_out, ",%ld", (long)(int32_t)raw); break;
+		default:    fprintf (p_out, ",%lu", (unsigned long)raw); break;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function puts the values from a log record into the text of its message and prints it.
+ *  \details Each conversion in the text takes the next value, whose type code says how many bytes it has
+ *           and whether it's signed; the flags, width and precision of the conversion are kept, and its
+ *           length modifiers are replaced by those which suit a value of that type.
+ *  @param p_out The file on which the message is printed
+ *  @param record The log record, without its CRC
+ */
+
+static void print_log (FILE* p_out, const std::vector<uint8_t>& record)
+{
+	uint32_t time_us = record[2] | ((uint32_t)record[3] << 8) | ((uint32_t)record[4] << 16)
+					   | ((uint32_t)record[5] << 24);
+	fprintf (p_out, "%10lu us: ", (unsigned long)time_us);
+	if (record[1] >= LOG_NUM_MESSAGES)
+	{
+		fprintf (p_out, "unknown log message %u\n", record[1]);
+		return;
+	}
+
+	size_t offset = LOG_HEADER;
+	for (const char* p_char = log_formats[record[1]]; *p_char != '\0'; p_char++)
+	{
+		if (*p_char != '%')
+		{
+			fputc (*p_char, p_out);
+			continue;
+		}
+		if (p_char[1] == '%')
+		{
+			fputc ('%', p_out);
+			p_char++;
+			continue;
+		}
+
+		// Copy the flags, width and precision, then skip any length modifiers
+		std::string spec ("%");
+		while (*++p_char != '\0' && strchr ("-+ #0123456789.", *p_char) != NULL)
+		{
+			spec += *p_char;
+		}
+		while (*p_char != '\0' && strchr ("hlLqjzt", *p_char) != NULL)
+		{
+			p_char++;
+		}
+		if (*p_char == '\0')
+		{
+			break;
+		}
+
+		// Get the next value, as wide as its type, then print it with the conversion
+		char type = (offset < record.size ()) ? (char)record[offset++] : '\0';
+		size_t size = type_size (type);
+		if (size == 0 || offset + size > record.size ())
+		{
+			fprintf (p_out, "<missing>");
+			offset = record.size ();
+			continue;
+		}
+		uint32_t raw = 0;
+		for (size_t index = size; index > 0; index--)
+		{
+			raw = (raw << 8) | record[offset + index - 1];
+		}
+		offset += size;
+
+		if (type == 'f')
+		{
+			float value;
+			memcpy (&value, &raw, sizeof (value));
+			spec += strchr ("eEfFgGaA", *p_char) ? *p_char : 'g';
+			fprintf (p_out, spec.c_str (), (double)value);
+			continue;
+		}
+		long long value;
+		switch (type)
+		{
+			case ('b'): value = (int8_t)raw; break;
+			case ('h'): value = (int16_t)raw; break;
+			case ('i'): value = (int32_t)raw; break;
+			default:    value = raw; break;
+		}
+		if (*p_char == 'c')
+		{
+			fprintf (p_out, (spec + 'c').c_str (), (int)value);
+		}
+		else if (strchr ("diuoxX", *p_char) != NULL)
+		{
+			fprintf (p_out, (spec + "ll" + *p_char).c_str (), value);
+		}
+		else
+		{
+			fprintf (p_out, (spec + "lld").c_str (), value);
+		}
+	}
+	fputc ('\n', p_out);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function reads telemetry records, then writes the data records out as CSV.
+ *  @param argc The number of command line arguments
+ *  @param argv The command line arguments; the first, if given, is the name of the file or device
+ *  @return 0 if the input was read to its end, or 1 if it couldn't be opened
+ */
+
+int main (int argc, char** argv)
+{
+	FILE* p_in = stdin;
+	if (argc > 1 && (p_in = fopen (argv[1], "rb")) == NULL)
+	{
+		fprintf (stderr, "telem2csv: can't open %s\n", argv[1]);
+		return (1);
+	}
+
+	FILE* p_out = stdout;
+	std::vector<channel_t> channels;
+	std::vector<uint8_t> frame;
+	std::vector<uint8_t> record;
+	bool header_written = false;
+	bool in_sync = false;                   // The first frame may have been joined partway through
+	bool have_sequence = false;
+	uint8_t next_sequence = 0;
+	unsigned long bad_records = 0;
+	unsigned long lost_records = 0;
+	unsigned long data_records = 0;
+	unsigned long log_records = 0;
+	int ch;
+
+	while ((ch = fgetc (p_in)) != EOF)
+	{
+		if (ch != 0)
+		{
+			frame.push_back ((uint8_t)ch);
+			continue;
+		}
+		if (!in_sync || frame.empty ())
+		{
+			in_sync = true;
+			frame.clear ();
+			continue;
+		}
+
+		// A whole frame has come in; check it, then take off its CRC
+		bool good = cobs_decode (frame, record) && record.size () >= 3;
+		frame.clear ();
+		if (good)
+		{
+			size_t length = record.size () - 2;
+			uint16_t crc = record[length] | ((uint16_t)record[length + 1] << 8);
+			good = (crc == crc16 (&record[0], length));
+			record.resize (length);
+		}
+		if (!good)
+		{
+			bad_records++;
+			continue;
+		}
+
+		if (record[0] == TELEMETRY_NAME && record.size () >= NAME_HEADER)
+		{
+			uint8_t index = record[1];
+			if (channels.size () != record[2])
+			{
+				channels.assign (record[2], channel_t ());
+				header_written = false;
+			}
+			if (index < channels.size ())
+			{
+				channels[index].type = (char)record[3];
+				channels[index].name.assign (record.begin () + NAME_HEADER, record.end ());
+			}
+		}
+		else if (record[0] == TELEMETRY_LOG && record.size () >= LOG_HEADER)
+		{
+			print_log (stderr, record);
+			log_records++;
+		}
+		else if (record[0] == TELEMETRY_DATA && record.size () >= DATA_HEADER)
+		{
+			uint8_t sequence = record[1];
+			if (have_sequence && sequence != next_sequence)
+			{
+				lost_records += (uint8_t)(sequence - next_sequence);
+			}
+			have_sequence = true;
+			next_sequence = sequence + 1;
+			data_records++;
+
+			// Nothing can be written until every channel's name and type are known
+			size_t expected = DATA_HEADER;
+			bool known = !channels.empty ();
+			for (size_t index = 0; index < channels.size (); index++)
+			{
+				known = known && !channels[index].name.empty ();
+				expected += type_size (channels[index].type);
+			}
+			if (!known || record.size () != expected)
+			{
+				continue;
+			}
+
+			if (!header_written)
+			{
+				fprintf (p_out, "sequence,time_us");
+				for (size_t index = 0; index < channels.size (); index++)
+				{
+					fprintf (p_out, ",%s", channels[index].name.c_str ());
+				}
+				fprintf (p_out, "\n");
+				header_written = true;
+			}
+
+			uint32_t time_us = record[2] | ((uint32_t)record[3] << 8) | ((uint32_t)record[4] << 16)
+							   | ((uint32_t)record[5] << 24);
+			fprintf (p_out, "%u,%lu", sequence, (unsigned long)time_us);
+			size_t offset = DATA_HEADER;
+			for (size_t index = 0; index < channels.size (); index++)
+			{
+				print_value (p_out, channels[index].type, &record[offset]);
+				offset += type_size (channels[index].type);
+			}
+			fprintf (p_out, "\n");
+			fflush (p_out);
+		}
+	}
+	if (p_in != stdin)
+	{
+		fclose (p_in);
+	}
+
+	fprintf (stderr, "telem2csv: %lu data records, %lu log records, %lu lost, %lu bad\n", data_records,
+			 log_records, lost_records, bad_records);
+	return (0);
+}
@@ -0,0 +1,225 @@
+//***********************************************************************************************************
+/** \file textbench.cpp
+ *    This file contains a program for the PC which measures how many characters per second can be sent
+ *    from one task to another through a \c TextQueue and through a \c StreamBuffer. A writing task prints
+ *    status lines of about 40 characters with \c <<, as the car's tasks do, and a reading task takes the
+ *    characters out, one at a time with \c getchar() from the \c TextQueue or in blocks with \c read()
+ *    from the \c StreamBuffer. Each kind of queue is run for the same time in turn, under FreeRTOS on its
+ *    POSIX port, and the number of characters which came through is printed for each.
+ *
+ *    The numbers only compare the queues with each other on the same PC; the AVR is much slower, but
+ *    the kernel calls which the \c StreamBuffer saves cost it as much in proportion. The program is built
+ *    with 'make -f Makefile.host textbench' and run with the number of seconds for each queue (default 2):
+ *    \code
+ *    build_host/textbench 2
+ *    \endcode
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//***********************************************************************************************************
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+
+#include "FreeRTOS.h"                       // Primary header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS task functions
+
+#include "host_serial.h"                    // Serial device on the PC's terminal
+#include "taskbase.h"                       // Header of wrapper for FreeRTOS tasks
+#include "textqueue.h"                      // Wrapper for FreeRTOS character queues
+#include "streambuffer.h"                   // Text queue which moves characters in blocks
+
+
+/// The number of characters which each queue holds, as for the car's print queue
+const uint16_t BENCH_QUEUE_SIZE = 32;
+
+/// The number of characters which the reader of a stream buffer takes out at once
+const size_t BENCH_BLOCK_SIZE = 16;
+
+/// The number of queues measured, one after another
+const uint8_t BENCH_NUM_QUEUES = 3;
+
+/// The names of the queues, as printed in the results
+static const char* const bench_names[BENCH_NUM_QUEUES] =
+{
+	"TextQueue, getchar()",
+	"StreamBuffer, trigger 1",
+	"StreamBuffer, trigger 16"
+};
+
+/// The queues; the first is a TextQueue and the others are stream buffers
+static emstream* p_bench_queues[BENCH_NUM_QUEUES];
+
+/// The queue being measured, which the writer and readers check before each line or read
+static volatile uint8_t bench_queue = 0;
+
+/// The number of characters which have been read from the queue being measured
+static volatile uint32_t bench_chars = 0;
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This task prints status lines into whichever queue is being measured, as fast as it can.
+ */
+
+class bench_writer : public TaskBase
+{
+	public:
+		/** \brief This constructor creates the writing task.
+		 *  @param a_name The name of the task
+		 *  @param a_priority The task's priority
+		 */
+		bench_writer (const char* a_name, unsigned portBASE_TYPE a_priority)
+			: TaskBase (a_name, a_priority, 280, NULL)
+		{
+		}
+
+		/** \brief This method writes lines like those the car's tasks print, with a number which changes.
+		 */
+		void run (void)
+		{
+			for (int32_t count = 0; ; count++)
+			{
+				if (bench_queue < BENCH_NUM_QUEUES)
+				{
+					*p_bench_queues[bench_queue] << PMS ("Encoders: ") << count << PMS (", ")
+												 << -count << PMS ("  Heading: 0") << endl;
+				}
+				else
+				{
+					vTaskDelay (configMS_TO_TICKS (10));
+				}
+			}
+		}
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This task reads characters from one of the queues and counts them while it's being measured.
+ */
+
+class bench_reader : public TaskBase
+{
+	protected:
+		uint8_t queue;                      ///< The number of the queue which this task reads
+
+	public:
+		/** \brief This constructor creates a task which reads one queue.
+		 *  @param a_name The name of the task
+		 *  @param a_priority The task's priority
+		 *  @param a_queue The number of the queue which the task reads
+		 */
+		bench_reader (const char* a_name, unsigned portBASE_TYPE a_priority, uint8_t a_queue)
+			: TaskBase (a_name, a_priority, 280, NULL), queue (a_queue)
+		{
+		}
+
+		/** \brief This method reads the queue, one character at a time if it's the \c TextQueue or in
+		 *  blocks if it's a stream buffer, and counts the characters while the queue is being measured.
+		 */
+		void run (void)
+		{
+			char block[BENCH_BLOCK_SIZE];
+
+			for (;;)
+			{
+				size_t count;
+				if (queue == 0)
+				{
+					p_bench_queues[queue]->getchar ();
+					count = 1;
+				}
+				else
+				{
+					count = ((StreamBuffer*)p_bench_queues[queue])->read (block, sizeof (block));
+				}
+				if (bench_queue == queue)
+				{
+					bench_chars += count;
+				}
+			}
+		}
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This task lets each queue run for the given time in turn, then prints the results and stops the
+ *  scheduler.
+ */
+
+class bench_timer : public TaskBase
+{
+	protected:
+		uint32_t run_ms;                    ///< How long each queue is measured, in milliseconds
+
+	public:
+		/** \brief This constructor creates the timing task.
+		 *  @param a_name The name of the task
+		 *  @param a_priority The task's priority, which must be above those of the writer and readers
+		 *  @param p_ser_dev The serial device on which the results are printed
+		 *  @param a_run_ms How long each queue is measured, in milliseconds
+		 */
+		bench_timer (const char* a_name, unsigned portBASE_TYPE a_priority, emstream* p_ser_dev,
+					 uint32_t a_run_ms)
+			: TaskBase (a_name, a_priority, 280, p_ser_dev), run_ms (a_run_ms)
+		{
+		}
+
+		/** \brief This method measures each queue in turn.
+		 */
+		void run (void)
+		{
+			uint32_t chars_per_s[BENCH_NUM_QUEUES];
+
+			for (uint8_t queue = 0; queue < BENCH_NUM_QUEUES; queue++)
+			{
+				bench_queue = queue;
+				bench_chars = 0;
+				vTaskDelay (configMS_TO_TICKS (run_ms));
+				chars_per_s[queue] = (uint64_t)bench_chars * 1000 / run_ms;
+			}
+			bench_queue = BENCH_NUM_QUEUES;
+
+			for (uint8_t queue = 0; queue < BENCH_NUM_QUEUES; queue++)
+			{
+				*p_serial << bench_names[queue] << PMS (": ") << chars_per_s[queue]
+						  << PMS (" characters per second") << endl;
+			}
+			vTaskEndScheduler ();
+		}
+};
+
+
+//===========================================================================================================
+/** The main function creates the queues and the tasks, then runs the scheduler until the timing task has
+ *  measured every queue.
+ *  @param argc The number of command line arguments
+ *  @param argv The command line arguments; the first, if given, is the time for each queue in seconds
+ *  @return Zero, once the measurements have finished
+ */
+
+int main (int argc, char** argv)
+{
+	uint32_t run_ms = 2000;
+	if (argc > 1)
+	{
+		run_ms = 1000UL * atol (argv[1]);
+	}
+
+	host_serial* p_ser_port = new host_serial ();
+
+	p_bench_queues[0] = new TextQueue (BENCH_QUEUE_SIZE, "TextQueue", p_ser_port);
+	p_bench_queues[1] = new StreamBuffer (BENCH_QUEUE_SIZE, "Stream 1", p_ser_port);
+	p_bench_queues[2] = new StreamBuffer (BENCH_QUEUE_SIZE, "Stream 16", p_ser_port, portMAX_DELAY,
+										  BENCH_BLOCK_SIZE);
+
+	// The readers run above the writer, as the user interface task runs above most tasks which print
+	new bench_writer ("Writer", task_priority(1));
+	for (uint8_t queue = 0; queue < BENCH_NUM_QUEUES; queue++)
+	{
+		new bench_reader ("Reader", task_priority(2), queue);
+	}
+	new bench_timer ("Timer", task_priority(3), p_ser_port, run_ms);
+
+	vTaskStartScheduler ();
+	return (0);
+}
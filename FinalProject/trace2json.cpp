@@ -0,0 +1,261 @@
+//***********************************************************************************************************
+/** \file trace2json.cpp
+ *    This file contains a program for the PC which turns a dump of the trace buffer, as printed by
+ *    \c trace_buffer_dump() when the user types 'x' in the help menu, into a timeline in the JSON trace
+ *    event format. The timeline can be opened in Chrome's \c chrome://tracing page or at ui.perfetto.dev.
+ *    Each task gets a track showing when it ran; each traced interrupt gets a track showing when its
+ *    service routine ran, and each queue gets a track with a mark at every send and receive.
+ *
+ *    The program reads a saved terminal log from the file named on the command line, or from standard
+ *    input, and writes the JSON to standard output. Anything in the log outside the lines between
+ *    "TRACE BEGIN" and "TRACE END" is ignored; if there are several dumps in the log, the last one is used.
+ *    It's built with 'make -f Makefile.host trace2json' and used like this:
+ *    \code
+ *    build_host/trace2json terminal.log > trace.json
+ *    \endcode
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//***********************************************************************************************************
+
+#include <stdio.h>                          // Standard C file input and output
+#include <stdint.h>                         // Standard integer types
+#include <string.h>                         // C string handling functions
+#include <map>                              // For task names, looked up by number
+#include <string>                           // C++ strings for the task names
+#include <vector>                           // For the list of records
+
+// These record types must match those in tracebuf.h
+const unsigned TRACE_TASK_IN = 1;           ///< A task has begun to run
+const unsigned TRACE_TASK_OUT = 2;          ///< A task has stopped running
+const unsigned TRACE_ISR_ENTER = 3;         ///< An interrupt service routine has begun
+const unsigned TRACE_ISR_EXIT = 4;          ///< An interrupt service routine has finished
+const unsigned TRACE_QUEUE_SEND = 5;        ///< An item was put into a queue
+const unsigned TRACE_QUEUE_RECEIVE = 6;     ///< An item was taken from a queue
+
+/// Interrupt tracks are numbered from here so they don't get mixed up with the tasks
+const unsigned ISR_TRACK = 1000;
+
+/// Queue tracks are numbered from here
+const unsigned QUEUE_TRACK = 2000;
+
+
+/// One record from the trace dump, with its time made into a count which doesn't wrap around
+struct record_t
+{
+	uint64_t time_us;                       ///< Time of the event, in microseconds
+	unsigned type;                          ///< What happened, such as \c TRACE_TASK_IN
+	unsigned id;                            ///< Which task, queue or interrupt it was
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function prints a metadata event which gives a track its name.
+ *  @param p_out The file to which the JSON is written
+ *  @param track The number of the track
+ *  @param name The name shown for the track
+ */
+
+static void print_track_name (FILE* p_out, unsigned track, const std::string& name)
+{
+	fprintf (p_out, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+			 "\"args\":{\"name\":\"%s\"}},\n", track, name.c_str ());
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function prints the beginning or end of a span of time on a track.
+ *  @param p_out The file to which the JSON is written
+ *  @param phase 'B' for the beginning of the span or 'E' for its end
+ *  @param track The number of the track
+ *  @param name The name of the span
+ *  @param time_us The time in microseconds
+ */
+
+static void print_span (FILE* p_out, char phase, unsigned track, const std::string& name, uint64_t time_us)
+{
+	fprintf (p_out, "{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"name\":\"%s\",\"ts\":%llu},\n",
+			 phase, track, name.c_str (), (unsigned long long)time_us);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This function reads a trace dump, then writes it out as a JSON timeline.
+ *  @param argc The number of command line arguments
+ *  @param argv The command line arguments; the first, if given, is the name of the log file
+ *  @return 0 if the dump was converted, or 1 if the file couldn't be read or held no dump
+ */
+
+int main (int argc, char** argv)
+{
+	FILE* p_in = stdin;
+	if (argc > 1 && (p_in = fopen (argv[1], "r")) == NULL)
+	{
+		fprintf (stderr, "trace2json: can't open %s\n", argv[1]);
+		return (1);
+	}
+
+	std::map<unsigned, std::string> task_names;
+	std::vector<record_t> records;
+	bool in_dump = false;
+	bool found_dump = false;
+	unsigned long lost = 0;
+	uint64_t wraps = 0;                     // Added to the times each time the 32 bit count wraps
+	uint32_t previous_time = 0;
+	char line[256];
+
+	while (fgets (line, sizeof (line), p_in) != NULL)
+	{
+		line[strcspn (line, "\r\n")] = '\0';
+		if (strncmp (line, "TRACE BEGIN", 11) == 0)
+		{
+			in_dump = found_dump = true;
+			task_names.clear ();
+			records.clear ();
+			wraps = 0;
+			unsigned long count = 0;
+			sscanf (line + 11, "%lu %lu", &count, &lost);
+		}
+		else if (!in_dump)
+		{
+			continue;
+		}
+		else if (strcmp (line, "TRACE END") == 0)
+		{
+			in_dump = false;
+		}
+		else if (strncmp (line, "TASK ", 5) == 0)
+		{
+			unsigned number;
+			int name_at = 0;
+			if (sscanf (line + 5, "%u %n", &number, &name_at) == 1)
+			{
+				std::string name (line + 5 + name_at);
+				name.erase (name.find_last_not_of (' ') + 1);
+				task_names[number] = name;
+			}
+		}
+		else
+		{
+			unsigned long time_us;
+			record_t record;
+			if (sscanf (line, "%lu %u %u", &time_us, &record.type, &record.id) == 3)
+			{
+				if (!records.empty () && (uint32_t)time_us < previous_time)
+				{
+					wraps += (uint64_t)1 << 32;
+				}
+				previous_time = (uint32_t)time_us;
+				record.time_us = wraps + (uint32_t)time_us;
+				records.push_back (record);
+			}
+		}
+	}
+	if (p_in != stdin)
+	{
+		fclose (p_in);
+	}
+
+	if (!found_dump || records.empty ())
+	{
+		fprintf (stderr, "trace2json: no trace records found\n");
+		return (1);
+	}
+	if (lost)
+	{
+		fprintf (stderr, "trace2json: %lu older records were lost before the dump\n", lost);
+	}
+
+	// Times are shown from the first record, so the timeline begins at zero
+	uint64_t start = records.front ().time_us;
+	FILE* p_out = stdout;
+	fprintf (p_out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	// Name every track which appears in the records
+	std::map<unsigned, std::string> tracks;
+	for (size_t index = 0; index < records.size (); index++)
+	{
+		const record_t& record = records[index];
+		char name[32];
+		switch (record.type)
+		{
+			case (TRACE_TASK_IN):
+			case (TRACE_TASK_OUT):
+				if (task_names.count (record.id))
+				{
+					tracks[record.id] = task_names[record.id];
+				}
+				else
+				{
+					snprintf (name, sizeof (name), "Task %u", record.id);
+					tracks[record.id] = name;
+				}
+				break;
+			case (TRACE_ISR_ENTER):
+			case (TRACE_ISR_EXIT):
+				snprintf (name, sizeof (name), "ISR %u", record.id);
+				tracks[ISR_TRACK + record.id] = name;
+				break;
+			case (TRACE_QUEUE_SEND):
+			case (TRACE_QUEUE_RECEIVE):
+				snprintf (name, sizeof (name), "Queue %u", record.id);
+				tracks[QUEUE_TRACK + record.id] = name;
+				break;
+		}
+	}
+	for (std::map<unsigned, std::string>::iterator it = tracks.begin (); it != tracks.end (); ++it)
+	{
+		print_track_name (p_out, it->first, it->second);
+	}
+
+	// Spans are only ended if they were begun within the dump, and any still open at the end are closed
+	std::map<unsigned, bool> open;
+	for (size_t index = 0; index < records.size (); index++)
+	{
+		const record_t& record = records[index];
+		uint64_t time_us = record.time_us - start;
+		unsigned track;
+
+		switch (record.type)
+		{
+			case (TRACE_TASK_IN):
+			case (TRACE_ISR_ENTER):
+				track = (record.type == TRACE_TASK_IN) ? record.id : ISR_TRACK + record.id;
+				if (!open[track])
+				{
+					print_span (p_out, 'B', track, tracks[track], time_us);
+					open[track] = true;
+				}
+				break;
+			case (TRACE_TASK_OUT):
+			case (TRACE_ISR_EXIT):
+				track = (record.type == TRACE_TASK_OUT) ? record.id : ISR_TRACK + record.id;
+				if (open[track])
+				{
+					print_span (p_out, 'E', track, tracks[track], time_us);
+					open[track] = false;
+				}
+				break;
+			case (TRACE_QUEUE_SEND):
+			case (TRACE_QUEUE_RECEIVE):
+				fprintf (p_out, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"name\":\"%s\",\"ts\":%llu},\n",
+						 QUEUE_TRACK + record.id, (record.type == TRACE_QUEUE_SEND) ? "send" : "receive",
+						 (unsigned long long)time_us);
+				break;
+		}
+	}
+	uint64_t end = records.back ().time_us - start;
+	for (std::map<unsigned, bool>::iterator it = open.begin (); it != open.end (); ++it)
+	{
+		if (it->second)
+		{
+			print_span (p_out, 'E', it->first, tracks[it->first], end);
+		}
+	}
+
+	// The trace event format allows no comma after the last event, so an empty metadata event ends the list
+	fprintf (p_out, "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"ME405\"}}\n]}\n");
+
+	return (0);
+}
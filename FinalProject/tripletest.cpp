@@ -0,0 +1,231 @@
+//***********************************************************************************************************
+/** \file tripletest.cpp
+ *    This file contains a program for the PC which checks that the reader of a \c TripleBuffer never gets
+ *    a record which is partly written. A writing task fills records of 66 words one word at a time with a
+ *    pattern made from a sequence number, so that every word of a complete record can be checked against
+ *    the others, and it gives up the processor part of the way through some of the records so that the
+ *    reader runs while a record is half written. A reading task at the same priority checks every record
+ *    it gets, gives up the processor, and then checks that the record hasn't changed under it, as it must
+ *    not until the next call to \c get(); it also checks that the sequence numbers never go backwards.
+ *
+ *    Before the tasks start, the check is given a record made of halves of two records, to show that it
+ *    finds a torn one. The tasks run under FreeRTOS on its POSIX port. The program is built with
+ *    'make -f Makefile.host tripletest' and run with the number of records to check (default 100000):
+ *    \code
+ *    build_host/tripletest 100000
+ *    \endcode
+ *    It returns zero if every record was whole and one otherwise.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//***********************************************************************************************************
+
+#include <stdlib.h>                         // Prototype declarations for I/O functions
+
+#include "FreeRTOS.h"                       // Primary header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS task functions
+
+#include "host_serial.h"                    // Serial device on the PC's terminal
+#include "taskbase.h"                       // Header of wrapper for FreeRTOS tasks
+#include "triplebuffer.h"                   // The triple buffer being checked
+
+
+/// The number of patterned words in each record
+const uint8_t TEST_WORDS = 64;
+
+/// The writer gives up the processor halfway through each record whose sequence number has these bits clear
+const uint32_t TEST_YIELD_MASK = 0x07;
+
+/** \brief This structure is the record passed from the writer to the reader. Every word is made from the
+ *  sequence number, so a record which is partly one and partly another doesn't match itself.
+ */
+struct test_record_t
+{
+	uint32_t sequence;                      ///< The number of the record, counting up from one
+	uint32_t words[TEST_WORDS];             ///< Words made from the sequence number and their index
+	uint32_t check;                         ///< The complement of the sequence number, written last
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function returns the word expected at a given place in a record with a given sequence number.
+ *  @param sequence The record's sequence number
+ *  @param index The index of the word in the record
+ *  @return The word which should be there
+ */
+
+static uint32_t test_pattern (uint32_t sequence, uint8_t index)
+{
+	return ((sequence * 2654435761UL) ^ ((uint32_t)index << 24 | index));
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** This function checks that every word of a record was made from the record's sequence number. A record
+ *  of zeros, which the buffer holds until the first record has been published, is also taken as whole.
+ *  @param record The record to be checked
+ *  @return True if the record is whole, false if it's partly one record and partly another
+ */
+
+static bool test_whole (const test_record_t& record)
+{
+	bool zeros = (record.sequence == 0);
+	if (record.check != (zeros ? 0 : ~record.sequence))
+	{
+		return (false);
+	}
+	for (uint8_t index = 0; index < TEST_WORDS; index++)
+	{
+		if (record.words[index] != (zeros ? 0 : test_pattern (record.sequence, index)))
+		{
+			return (false);
+		}
+	}
+	return (true);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This task fills records with the pattern, one word at a time, and publishes each one.
+ */
+
+class test_writer : public TaskBase
+{
+	protected:
+		TripleBuffer<test_record_t>* p_records;     ///< The buffer into which records are written
+
+	public:
+		/** \brief This constructor creates the writing task.
+		 *  @param a_name The name of the task
+		 *  @param a_priority The task's priority
+		 *  @param p_buffer The buffer into which records are written
+		 */
+		test_writer (const char* a_name, unsigned portBASE_TYPE a_priority,
+					 TripleBuffer<test_record_t>* p_buffer)
+			: TaskBase (a_name, a_priority, 280, NULL), p_records (p_buffer)
+		{
+		}
+
+		/** \brief This method writes records as fast as it can, giving up the processor halfway through
+		 *  some of them.
+		 */
+		void run (void)
+		{
+			for (uint32_t sequence = 1; ; sequence++)
+			{
+				test_record_t& record = p_records->back ();
+				record.sequence = sequence;
+				for (uint8_t index = 0; index < TEST_WORDS; index++)
+				{
+					record.words[index] = test_pattern (sequence, index);
+					if (index == TEST_WORDS / 2 && (sequence & TEST_YIELD_MASK) == 0)
+					{
+						taskYIELD ();
+					}
+				}
+				record.check = ~sequence;
+				p_records->publish ();
+			}
+		}
+};
+
+
+//-----------------------------------------------------------------------------------------------------------
+/** \brief This task gets records, checks each one before and after letting the writer run, and when it has
+ *  checked enough of them prints the result and stops the scheduler.
+ */
+
+class test_reader : public TaskBase
+{
+	protected:
+		TripleBuffer<test_record_t>* p_records;     ///< The buffer from which records are read
+		uint32_t records_to_check;                  ///< How many records are checked before stopping
+
+	public:
+		/// The number of records which were torn, changed while being used, or older than the one before
+		uint32_t torn;
+
+		/** \brief This constructor creates the reading task.
+		 *  @param a_name The name of the task
+		 *  @param a_priority The task's priority, which should be the writer's so that they share time
+		 *  @param p_ser_dev The serial device on which the result is printed
+		 *  @param p_buffer The buffer from which records are read
+		 *  @param a_count How many records are checked
+		 */
+		test_reader (const char* a_name, unsigned portBASE_TYPE a_priority, emstream* p_ser_dev,
+					 TripleBuffer<test_record_t>* p_buffer, uint32_t a_count)
+			: TaskBase (a_name, a_priority, 280, p_ser_dev), p_records (p_buffer),
+			  records_to_check (a_count), torn (0)
+		{
+		}
+
+		/** \brief This method checks the records and prints how many of them were bad.
+		 */
+		void run (void)
+		{
+			uint32_t last_sequence = 0;
+
+			for (uint32_t count = 0; count < records_to_check; count++)
+			{
+				const test_record_t& record = p_records->get ();
+				uint32_t sequence = record.sequence;
+				bool good = test_whole (record) && sequence >= last_sequence;
+
+				// The record must stay as it is until the next get(), however long the writer runs
+				taskYIELD ();
+				if (!good || record.sequence != sequence || !test_whole (record))
+				{
+					torn++;
+				}
+				last_sequence = sequence;
+			}
+
+			*p_serial << records_to_check << PMS (" records checked, up to number ") << last_sequence
+					  << PMS (", ") << torn << PMS (" torn") << endl;
+			vTaskEndScheduler ();
+		}
+};
+
+
+//===========================================================================================================
+/** The main function checks that a torn record is found, then creates the triple buffer and the tasks and
+ *  runs the scheduler until the reader has checked all its records.
+ *  @param argc The number of command line arguments
+ *  @param argv The command line arguments; the first, if given, is the number of records to check
+ *  @return Zero if every record was whole, one if any wasn't
+ */
+
+int main (int argc, char** argv)
+{
+	uint32_t count = 100000UL;
+	if (argc > 1)
+	{
+		count = atol (argv[1]);
+	}
+
+	host_serial* p_ser_port = new host_serial ();
+
+	// The first half of record 2 with the second half of record 1 must be found torn
+	test_record_t halves;
+	halves.sequence = 2;
+	for (uint8_t index = 0; index < TEST_WORDS; index++)
+	{
+		halves.words[index] = test_pattern ((index < TEST_WORDS / 2) ? 2 : 1, index);
+	}
+	halves.check = ~(uint32_t)2;
+	if (test_whole (halves))
+	{
+		*p_ser_port << "The check didn't find a torn record" << endl;
+		return (1);
+	}
+
+	TripleBuffer<test_record_t>* p_buffer = new TripleBuffer<test_record_t> ("Records");
+
+	// The writer and reader share a priority, so each is also switched out at ticks in the middle of a record
+	new test_writer ("Writer", task_priority(1), p_buffer);
+	test_reader* p_reader = new test_reader ("Reader", task_priority(1), p_ser_port, p_buffer, count);
+
+	vTaskStartScheduler ();
+	return (p_reader->torn ? 1 : 0);
+}
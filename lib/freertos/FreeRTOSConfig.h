@@ -119,17 +119,38 @@
  */
 #define configENABLE_BACKWARD_COMPATIBILITY 0
 
+/** This define causes task run times to be measured by the RTOS profiler. This is a
+ *  useful debugging feature, but it takes up memory and processor time, so it should
+ *  only be used when debugging the performance of a program. The time is counted in
+ *  microseconds from the RTOS tick timer, adding four bytes to each task and a few
+ *  microseconds to each task switch; @c print_task_list() then shows the share of
+ *  the CPU used by each task. Set it to 0 to leave all this out.
+ */
+#ifndef configGENERATE_RUN_TIME_STATS
+	#define configGENERATE_RUN_TIME_STATS   1
+#endif
+
+/** This define turns on a buffer in RAM which records each task switch, queue send and
+ *  receive, and traced interrupt with a time stamp in microseconds; the records are 
+ *  printed by @c trace_buffer_dump() only when asked for, so the serial port isn't
+ *  slowed down. Each record costs a few microseconds, so it's off unless turned on,
+ *  for example with @c -DconfigUSE_TRACE_BUFFER=1 in the makefile.
+ */
+#ifndef configUSE_TRACE_BUFFER
+	#define configUSE_TRACE_BUFFER          0
+#endif
+
 /** This define is set to compile some extra code that helps keep track of memory and
  *  processor usage in tasks. It does not check for state transitions in tasks. Since
  *  tracing takes up memory and processor time, it should only be used for debugging.
+ *  It's needed by @c print_task_list() to read the run time statistics above, and by
+ *  the trace buffer to number the tasks and queues.
  */
-#define configUSE_TRACE_FACILITY        0
-
-/** This define causes task run times to be measured by the RTOS profiler. This is a
- *  useful debugging feature, but it takes up memory and processor time, so it should
- *  only be used when debugging the performance of a program.
- */
-#define configGENERATE_RUN_TIME_STATS   0
+#if (configGENERATE_RUN_TIME_STATS == 1 || configUSE_TRACE_BUFFER == 1)
+	#define configUSE_TRACE_FACILITY    1
+#else
+	#define configUSE_TRACE_FACILITY    0
+#endif
 
 /** This define sets the maximum number of task priorities available for use. More
  *  memory is used if a higher number of priorities is set, so you should not make
@@ -145,6 +166,32 @@
  */
 #define configMINIMAL_STACK_SIZE        ( ( unsigned short ) 100 )
 
+/** Set this to 1 to keep the tasks' stacks, and the tasks, shares and queues made in
+ *  main(), in the holders from staticstore.h, which the linker lays out, or to 0 to make
+ *  them all with new from the heap. It's 0 until configSTATIC_RAM_SIZE has been checked
+ *  against an AVR build of the program, as described below.
+ */
+#ifndef STATIC_ALLOCATION
+	#define STATIC_ALLOCATION			0
+#endif
+
+/** This is how much RAM the static holders take out of the heap. The heap is made this
+ *  much smaller so that the program as a whole doesn't use more RAM. It must match the
+ *  sum of the sizes of the holders in main.cpp, which main.cpp checks when it's compiled
+ *  for the AVR; if they don't match, the compiler's error message shows the sum, which
+ *  'make ramreport' also prints. The number here is for main.cpp's default options and
+ *  can be given to the compiler instead for other options. FreeRTOS itself still takes
+ *  task control blocks, queue storage and event groups from the heap.
+ */
+#if (STATIC_ALLOCATION == 1)
+	#ifndef configSTATIC_RAM_SIZE
+		#define configSTATIC_RAM_SIZE	2560
+	#endif
+#else
+	#undef configSTATIC_RAM_SIZE
+	#define configSTATIC_RAM_SIZE		0
+#endif
+
 /** This define sets the size of the block of memory from which all dynamically 
  *  allocated memory is allocated -- including task stacks, queues, and whatever the
  *  user's functions need (but not the main system stack). Since the amount of SRAM
@@ -154,8 +201,16 @@
  *  data memory for the heap. The default from FreeRTOS for the ATmega323 is 2500 
  *  bytes, which seems strange because the data sheets say is only has 2K of SRAM. 
  *  This formula is intended to be altered by the user for different configurations.
+ *  In a host (PC) build, pointers are four times as big as an AVR's, so the heap is
+ *  made four times as big too.
  */
-#define configTOTAL_HEAP_SIZE           (1024 + ((((uint32_t)RAMEND - 2143) * 3) / 4 ))
+#ifdef __AVR
+	#define configTOTAL_HEAP_SIZE       (1024 + ((((uint32_t)RAMEND - 2143) * 3) / 4 ) \
+										 - configSTATIC_RAM_SIZE)
+#else
+	#define configTOTAL_HEAP_SIZE       (4 * (1024 + ((((uint32_t)RAMEND - 2143) * 3) / 4 ) \
+										 - configSTATIC_RAM_SIZE))
+#endif
 
 /** This define sets the maximum length of task names, plus one byte for the '\0'
  *  which signifies the end of the string. When set to 8, it allows 7-letter names.
@@ -163,9 +218,15 @@
 #define configMAX_TASK_NAME_LEN         ( 10 )
 
 /** This define enables use of vApplicationIdleHook() to run a task (or a set of
- *  "co-routines", cooperatively scheduled tasks) at the lowest priority.
+ *  "co-routines", cooperatively scheduled tasks) at the lowest priority. The POSIX
+ *  port used for host (PC) builds supplies its own idle hook, which puts the idle
+ *  task to sleep until the next tick.
  */
-#define configUSE_IDLE_HOOK             0
+#ifdef __AVR
+	#define configUSE_IDLE_HOOK         0
+#else
+	#define configUSE_IDLE_HOOK         1
+#endif
 
 /** This define enables the use of vApplicationTickHook(), which runs within the
  *  RTOS tick timer interrupt. Code which does timing tasks can be put here. This
@@ -200,9 +261,14 @@
 #define configUSE_MUTEXES               1
 
 /** The RAM pointer size on an AVR processor is 16 bits; set it here to shut up a dumb
- *  compiler warning that comes out in tasks.c if the default 32 bits is used. 
+ *  compiler warning that comes out in tasks.c if the default 32 bits is used. A host
+ *  (PC) build needs an integer as big as the PC's pointers.
  */
-#define portPOINTER_SIZE_TYPE           uint16_t
+#ifdef __AVR
+	#define portPOINTER_SIZE_TYPE       uint16_t
+#else
+	#define portPOINTER_SIZE_TYPE       uintptr_t
+#endif
 
 /** This define is set to 1 in order to allow the use of co-routines, which are a sort
  *  of cooperatively multitasked set of tasks.
@@ -229,6 +295,9 @@
 #define INCLUDE_uxTaskGetStackHighWaterMark      1
 #define INCLUDE_xTaskGetIdleTaskHandle           1
 
+// The serial driver asks whether the scheduler is running before it waits with vTaskDelay()
+#define INCLUDE_xTaskGetSchedulerState           1
+
 
 // //-------------------------------------------------------------------------------------
 // /** @brief   Macro which is run by FreeRTOS when a task is switched in.
@@ -243,6 +312,39 @@
 // 
 // #define traceTASK_SWITCHED_OUT() task_switched_out_function ()
 
+//-------------------------------------------------------------------------------------
+/** When the trace buffer is turned on, these FreeRTOS trace macros put a record into
+ *  it at each task switch and each queue send and receive. Queues, semaphores and 
+ *  mutexes are numbered as they're created. The macros @c traceISR_ENTER() and 
+ *  @c traceISR_EXIT() can be put at the beginning and end of an interrupt service 
+ *  routine, with a number which identifies it; they do nothing when the buffer is off.
+ */
+#if (configUSE_TRACE_BUFFER == 1)
+	#include "tracebuf.h"
+
+	#define traceTASK_SWITCHED_IN()  \
+		trace_buffer_put (TRACE_TASK_IN, (uint8_t)(pxCurrentTCB->uxTCBNumber))
+	#define traceTASK_SWITCHED_OUT() \
+		trace_buffer_put (TRACE_TASK_OUT, (uint8_t)(pxCurrentTCB->uxTCBNumber))
+	#define traceQUEUE_CREATE(pxNewQueue) \
+		((pxNewQueue)->uxQueueNumber = trace_buffer_queue_number ())
+	#define traceCREATE_MUTEX(pxNewQueue) \
+		((pxNewQueue)->uxQueueNumber = trace_buffer_queue_number ())
+	#define traceQUEUE_SEND(pxQueue) \
+		trace_buffer_put (TRACE_QUEUE_SEND, (uint8_t)((pxQueue)->uxQueueNumber))
+	#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+		trace_buffer_put (TRACE_QUEUE_SEND, (uint8_t)((pxQueue)->uxQueueNumber))
+	#define traceQUEUE_RECEIVE(pxQueue) \
+		trace_buffer_put (TRACE_QUEUE_RECEIVE, (uint8_t)((pxQueue)->uxQueueNumber))
+	#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+		trace_buffer_put (TRACE_QUEUE_RECEIVE, (uint8_t)((pxQueue)->uxQueueNumber))
+	#define traceISR_ENTER(id)       trace_buffer_put (TRACE_ISR_ENTER, (id))
+	#define traceISR_EXIT(id)        trace_buffer_put (TRACE_ISR_EXIT, (id))
+#else
+	#define traceISR_ENTER(id)
+	#define traceISR_EXIT(id)
+#endif
+
 //-------------------------------------------------------------------------------------
 
 // #define configGENERATE_RUN_TIME_STATS            1
@@ -265,7 +367,8 @@
 //-------------------------------------------------------------------------------------
 /** This macro returns the current real time measured by the RTOS timer, truncated to
 *  fit in a 32 bit integer so that FreeRTOS's run-time statistics measurement code
-*  can make use of the time measurement. 
+*  can make use of the time measurement. The time is in microseconds, so it wraps
+*  around about every 71 minutes; only differences between times should be used.
 */
 #define portGET_RUN_TIME_COUNTER_VALUE()  func_get_run_time_counter ()
 
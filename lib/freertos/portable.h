@@ -88,6 +88,10 @@ include path. */
 	#include "portmacro.h"
 #endif
 
+#ifdef GCC_POSIX
+	#include "posix/portmacro.h"
+#endif
+
 #ifdef IAR_MEGA_AVR
 	#include "../portable/IAR/ATMega323/portmacro.h"
 #endif
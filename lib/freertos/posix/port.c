@@ -0,0 +1,372 @@
+/*
+    FreeRTOS V8.1.2 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+	POSIX (Linux) port used for the host build of the ME405 projects.
+
+	Every task runs in its own POSIX thread, but the threads never run at the
+	same time.  A mutex stands for the processor's global interrupt enable bit:
+	a task which enters a critical section or disables interrupts holds the
+	mutex, and the thread which generates the RTOS tick must take the mutex
+	before it can increment the tick count, just as the tick interrupt on the
+	AVR can't run while interrupts are disabled.  The same mutex protects the
+	variable which says which task's thread may run, and a condition variable is
+	used to hand the processor from one thread to the next.
+
+	A task switch requested by the tick can't stop a thread in the middle of
+	its code, so it is left pending until the running task next leaves a
+	critical section or calls the kernel.  Tasks written in the usual ME405
+	style, which use shares and delay every few milliseconds, do that often.
+	The idle task waits for the next tick in the idle hook rather than spinning.
+
+	The stack which the kernel allocates for each task isn't used by the task's
+	code, which runs on its thread's own stack; the top of the kernel's stack
+	holds the structure which describes the thread.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX port.
+ *----------------------------------------------------------*/
+
+/* The number of nanoseconds between ticks. */
+#define portTICK_PERIOD_NS		( 1000000000L / configTICK_RATE_HZ )
+
+/* We require the address of the pxCurrentTCB variable, but don't want to know
+any details of its type. */
+typedef void TCB_t;
+extern volatile TCB_t * volatile pxCurrentTCB;
+
+/* Everything the port needs to know about the thread in which a task runs. */
+typedef struct xTHREAD_STATE
+{
+	pthread_t xThread;						/* The thread running the task. */
+	TaskFunction_t pxCode;					/* The task's function. */
+	void *pvParameters;						/* Parameter given to the function. */
+	volatile UBaseType_t uxCriticalNesting;	/* Depth of critical sections. */
+} xThreadState;
+
+/*-----------------------------------------------------------*/
+
+/* If stack tracing is active, declare a variable which will be used by the task
+ * wrapper class to get the address of the top of the stack just after a task has
+ * been created. The variable is static so it retains its value. */
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+	size_t portStackTopForTask;
+#endif
+
+/* The mutex which stands for the interrupt enable bit, and the conditions used
+to wake a task's thread and the idle task. */
+static pthread_mutex_t xInterruptMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xRunCondition = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t xTickCondition = PTHREAD_COND_INITIALIZER;
+
+/* The thread of the task which is allowed to run; protected by the mutex. */
+static xThreadState * volatile pxRunningThread = NULL;
+
+/* Set by the tick when the scheduler wants a different task to run. */
+static volatile BaseType_t xSwitchPending = pdFALSE;
+
+/* Set when vTaskEndScheduler() has been called. */
+static volatile BaseType_t xSchedulerEnded = pdFALSE;
+
+/* The thread which generates ticks. */
+static pthread_t xTickThread;
+
+/* The state of the thread calling the port; main() uses a state of its own. */
+static __thread xThreadState *pxThisThread = NULL;
+static xThreadState xMainThread;
+
+/*-----------------------------------------------------------*/
+
+/* Find the state of the thread which is calling a port function. */
+static xThreadState *prvThisThread( void )
+{
+	return ( pxThisThread != NULL ) ? pxThisThread : &xMainThread;
+}
+
+/* Find the state of the thread which belongs to the current task. */
+static xThreadState *prvCurrentTaskThread( void )
+{
+	/* The first member of the TCB is the task's top of stack pointer. */
+	return *( xThreadState ** ) pxCurrentTCB;
+}
+
+/* Give the processor to the current task and wait until this thread's task is
+chosen to run again.  Must be called with the mutex held. */
+static void prvSwitchThreads( xThreadState *pxThread )
+{
+	xThreadState *pxNext = prvCurrentTaskThread();
+
+	if( pxNext != pxThread )
+	{
+		pxRunningThread = pxNext;
+		pthread_cond_broadcast( &xRunCondition );
+
+		while( pxRunningThread != pxThread )
+		{
+			pthread_cond_wait( &xRunCondition, &xInterruptMutex );
+		}
+	}
+}
+
+/* Each task's thread starts here, waiting until the scheduler picks its task. */
+static void *prvThreadEntry( void *pvThread )
+{
+	xThreadState *pxThread = ( xThreadState * ) pvThread;
+
+	pxThisThread = pxThread;
+
+	pthread_mutex_lock( &xInterruptMutex );
+	while( pxRunningThread != pxThread )
+	{
+		pthread_cond_wait( &xRunCondition, &xInterruptMutex );
+	}
+
+	/* Tasks start with interrupts enabled. */
+	pxThread->uxCriticalNesting = 0;
+	pthread_mutex_unlock( &xInterruptMutex );
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	return NULL;
+}
+
+/* The tick "interrupt" runs in its own thread at the tick rate. */
+static void *prvTickThread( void *pvUnused )
+{
+	struct timespec xNextTick;
+
+	( void ) pvUnused;
+	clock_gettime( CLOCK_MONOTONIC, &xNextTick );
+
+	for( ;; )
+	{
+		xNextTick.tv_nsec += portTICK_PERIOD_NS;
+		if( xNextTick.tv_nsec >= 1000000000L )
+		{
+			xNextTick.tv_nsec -= 1000000000L;
+			xNextTick.tv_sec++;
+		}
+		clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xNextTick, NULL );
+
+		pthread_mutex_lock( &xInterruptMutex );
+		if( xSchedulerEnded != pdFALSE )
+		{
+			pthread_mutex_unlock( &xInterruptMutex );
+			break;
+		}
+
+		#if configUSE_PREEMPTION == 1
+		{
+			if( xTaskIncrementTick() != pdFALSE )
+			{
+				xSwitchPending = pdTRUE;
+			}
+		}
+		#else
+		{
+			( void ) xTaskIncrementTick();
+		}
+		#endif
+
+		pthread_cond_broadcast( &xTickCondition );
+		pthread_mutex_unlock( &xInterruptMutex );
+	}
+
+	return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.  The thread which will run the task is
+ * created here; it waits until the scheduler starts the task.
+ */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack,
+									  TaskFunction_t pxCode, void *pvParameters )
+{
+	xThreadState *pxThread;
+
+	#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+		portStackTopForTask = (size_t)pxTopOfStack;
+	#endif
+
+	/* Keep the thread's state at the top of the task's stack. */
+	pxThread = ( xThreadState * ) ( ( ( size_t ) ( pxTopOfStack + 1 )
+				- sizeof( xThreadState ) ) & ~( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->uxCriticalNesting = 0;
+
+	if( pthread_create( &( pxThread->xThread ), NULL, prvThreadEntry, pxThread ) != 0 )
+	{
+		perror( "FreeRTOS POSIX port: can't create task thread" );
+		abort();
+	}
+
+	return ( StackType_t * ) pxThread;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+	xThreadState *pxThread = prvThisThread();
+
+	/* vTaskStartScheduler() has disabled interrupts, so the mutex is held.
+	Start the first task, then the tick. */
+	pxRunningThread = prvCurrentTaskThread();
+	pthread_cond_broadcast( &xRunCondition );
+
+	if( pthread_create( &xTickThread, NULL, prvTickThread, NULL ) != 0 )
+	{
+		perror( "FreeRTOS POSIX port: can't create tick thread" );
+		abort();
+	}
+
+	/* The thread which started the scheduler sleeps until it is ended. */
+	while( xSchedulerEnded == pdFALSE )
+	{
+		pthread_cond_wait( &xRunCondition, &xInterruptMutex );
+	}
+	pxThread->uxCriticalNesting = 0;
+	pthread_mutex_unlock( &xInterruptMutex );
+
+	pthread_join( xTickThread, NULL );
+
+	/* The scheduler was stopped by vTaskEndScheduler(). */
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* vTaskEndScheduler() has disabled interrupts, so the mutex is held.  Wake
+	the thread which started the scheduler; this task's thread never runs again. */
+	xSchedulerEnded = pdTRUE;
+	pxRunningThread = NULL;
+	pthread_cond_broadcast( &xRunCondition );
+
+	for( ;; )
+	{
+		pthread_cond_wait( &xRunCondition, &xInterruptMutex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Manual context switch.  A task which yields inside a critical section keeps
+ * its nesting count, and holds the mutex again when it next runs.
+ */
+void vPortYield( void )
+{
+	xThreadState *pxThread = prvThisThread();
+
+	if( pxThread->uxCriticalNesting == 0 )
+	{
+		pthread_mutex_lock( &xInterruptMutex );
+	}
+
+	xSwitchPending = pdFALSE;
+	vTaskSwitchContext();
+	prvSwitchThreads( pxThread );
+
+	if( pxThread->uxCriticalNesting == 0 )
+	{
+		pthread_mutex_unlock( &xInterruptMutex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	xThreadState *pxThread = prvThisThread();
+
+	if( pxThread->uxCriticalNesting == 0 )
+	{
+		pthread_mutex_lock( &xInterruptMutex );
+	}
+	pxThread->uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	xThreadState *pxThread = prvThisThread();
+
+	if( pxThread->uxCriticalNesting > 0 )
+	{
+		pxThread->uxCriticalNesting--;
+		if( pxThread->uxCriticalNesting == 0 )
+		{
+			pthread_mutex_unlock( &xInterruptMutex );
+
+			/* Now that "interrupts" are enabled again, carry out a task switch
+			which the tick asked for while they were disabled. */
+			if( ( xSwitchPending != pdFALSE ) && ( pxThisThread != NULL ) )
+			{
+				vPortYield();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xThreadState *pxThread = prvThisThread();
+
+	if( pxThread->uxCriticalNesting == 0 )
+	{
+		pthread_mutex_lock( &xInterruptMutex );
+		pxThread->uxCriticalNesting = 1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	xThreadState *pxThread = prvThisThread();
+
+	if( pxThread->uxCriticalNesting > 0 )
+	{
+		pxThread->uxCriticalNesting = 0;
+		pthread_mutex_unlock( &xInterruptMutex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * The idle task would otherwise spin forever without calling the kernel, so
+ * nothing could preempt it.  Instead it sleeps until a tick asks for a switch.
+ */
+void vApplicationIdleHook( void )
+{
+	pthread_mutex_lock( &xInterruptMutex );
+	while( xSwitchPending == pdFALSE )
+	{
+		pthread_cond_wait( &xTickCondition, &xInterruptMutex );
+	}
+	pthread_mutex_unlock( &xInterruptMutex );
+
+	vPortYield();
+}
@@ -11,6 +11,7 @@
  *
  *  Revised:
  *    \li 10-18-2014 JRR Created file
+ *    \li 10-17-2026 ME405 Group 3 The name is kept in the object rather than on the heap
  *
  *  License:
  *		This file is copyright 2014 by JR Ridgely and released under the Lesser GNU 
@@ -47,14 +48,15 @@ BaseShare* BaseShare::p_newest = NULL;
 
 BaseShare::BaseShare (const char* p_name = NULL)
 {
-	// Allocate some memory and then save the share's name; trim it to 12 characters
+	// Save the share's name, trimmed to 12 characters
+	size_t namelength = 0;
 	if (p_name != NULL)
 	{
-		uint8_t namelength = strlen (p_name);
-		namelength = (namelength <= 12) ? namelength : 12;
-		name = new char[namelength + 1];
-		strncpy (name, p_name, namelength);
+		namelength = strlen (p_name);
+		namelength = (namelength < sizeof (name)) ? namelength : sizeof (name) - 1;
+		memcpy (name, p_name, namelength);
 	}
+	name[namelength] = '\0';
 
 	// Install this share in the linked list of shares
 	p_next = p_newest;
@@ -11,6 +11,7 @@
  *
  *  Revised:
  *    \li 10-18-2014 JRR Created file
+ *    \li 10-17-2026 ME405 Group 3 The name is kept in the object rather than on the heap
  *
  *  License:
  *		This file is copyright 2014 by JR Ridgely and released under the Lesser GNU 
@@ -54,10 +55,12 @@ class BaseShare
 		emstream* p_serial;
 
 		/** @brief   The name of the shared item.
-		 *  @details This string holds the shared item's name. The name is only used
-		 *           for identification on debugging printouts or logs.
+		 *  @details This string holds the shared item's name, cut to 12 characters.
+		 *           The name is only used for identification on debugging printouts 
+		 *           or logs. It's kept in the object rather than on the heap, so a 
+		 *           share which isn't made with @c new uses no heap at all.
 		 */
-		char* name;
+		char name[13];
 
 		/** @brief   Pointer to the next item in the linked list of shares.
 		 *  @details This pointer points to the next item in the system's list of
@@ -0,0 +1,239 @@
+//*************************************************************************************
+/** @file    cyclicexec.cpp
+ *  @brief   Source code for periodic steps which can be run either each in its own
+ *           task or all together from one task by a cyclic executive.
+ *  @details This file contains the methods of classes @c CyclicStep, @c CyclicTask
+ *           and @c CyclicExecutive; see @c cyclicexec.h for how they're used.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *    \li 10-17-2026 ME405 Group 3 Missed deadlines and wake up times kept by TaskBase
+ *    \li 10-17-2026 ME405 Group 3 Task stacks can be given to the constructors
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+#include <string.h>                         // C language string handling functions
+#include "cyclicexec.h"                     // Pull in the header for these classes
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Construct a step which hasn't yet been run.
+ *  @param   a_name A character string which will be the name of this step
+ *  @param   p_ser_dev Pointer to a serial device which can be used by this step to
+ *                     communicate (default: NULL)
+ */
+
+CyclicStep::CyclicStep (const char* a_name, emstream* p_ser_dev)
+	: name (a_name), p_serial (p_ser_dev), runs (0)
+{
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Wait until it's time to run the step again, when the step has a task of
+ *           its own.
+ *  @details This method is only called by a @c CyclicTask; a cyclic executive keeps
+ *           the time for all its steps itself. The default waits until one period
+ *           after the previous run. A step which should instead be woken by an event
+ *           can wait for that event here.
+ *  @param   previous_ticks The time at which the step was last due, which is
+ *                          updated here
+ *  @param   period The period of the task running the step, in RTOS ticks
+ *  @return  @c true if the step woke at the time put in @c previous_ticks, so that
+ *           how late it woke can be measured, or @c false if it woke on an event
+ */
+
+bool CyclicStep::wait_for_next (TickType_t& previous_ticks, TickType_t period)
+{
+	vTaskDelayUntil (&previous_ticks, period);
+	return (true);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Create a task which runs one step in a task of its own.
+ *  @param   a_step The step which the task runs; the task has the same name
+ *  @param   a_period_ms The period at which the step runs, in milliseconds
+ *  @param   a_priority The priority at which this task will run
+ *  @param   a_stack_size The size of this task's stack in bytes
+ *  @param   p_ser_dev Pointer to a serial device which can be used by this task to
+ *                     communicate (default: NULL)
+ *  @param   p_stack_buffer Memory for the task's stack, or NULL to take the stack
+ *                          from the heap (default: NULL)
+ */
+
+CyclicTask::CyclicTask (CyclicStep* a_step, uint16_t a_period_ms,
+						unsigned portBASE_TYPE a_priority, size_t a_stack_size,
+						emstream* p_ser_dev, StackType_t* p_stack_buffer)
+	: TaskBase (a_step->get_name (), a_priority, a_stack_size, p_ser_dev,
+				p_stack_buffer),
+	  p_step (a_step), period (configMS_TO_TICKS (a_period_ms))
+{
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Run the step, once after each wait, for ever.
+ */
+
+void CyclicTask::run (void)
+{
+	TickType_t previous_ticks = xTaskGetTickCount ();
+
+	p_step->setup ();
+
+	for (;;)
+	{
+		exec_time.begin ();
+		p_step->run_step ();
+		exec_time.end ();
+		runs++;
+
+		period_timing.check_deadline (previous_ticks, period);
+		if (p_step->wait_for_next (previous_ticks, period))
+		{
+			period_timing.woke (previous_ticks);
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Create a cyclic executive with no steps yet.
+ *  @param   a_name A character string which will be the name of this task
+ *  @param   a_priority The priority at which this task will run; it's usually the
+ *                      highest priority of any task in the program
+ *  @param   a_stack_size The size of this task's stack in bytes, which must be
+ *                        enough for the step which uses the most stack
+ *  @param   p_ser_dev Pointer to a serial device which can be used by this task to
+ *                     communicate, or @c NULL
+ *  @param   a_frame_ms The length of one frame, in milliseconds
+ *  @param   p_stack_buffer Memory for the task's stack, or NULL to take the stack
+ *                          from the heap (default: NULL)
+ */
+
+CyclicExecutive::CyclicExecutive (const char* a_name, unsigned portBASE_TYPE a_priority,
+								  size_t a_stack_size, emstream* p_ser_dev,
+								  uint16_t a_frame_ms, StackType_t* p_stack_buffer)
+	: TaskBase (a_name, a_priority, a_stack_size, p_ser_dev, p_stack_buffer),
+	  num_slots (0), frame (configMS_TO_TICKS (a_frame_ms))
+{
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Add a step to the end of the executive's table of steps.
+ *  @details Steps which are due in the same frame run in the order in which they were
+ *           added. This method must be called before the scheduler is started.
+ *  @param   p_step The step to be added
+ *  @param   period_frames The number of frames from one run of the step to the next
+ *                         (default: 1, every frame)
+ *  @param   phase_frames The frame, counted from 0, in which the step first runs; it
+ *                        must be less than the period (default: 0)
+ *  @return  @c true if the step was added, or @c false if the table was full or the
+ *           period or phase made no sense
+ */
+
+bool CyclicExecutive::add (CyclicStep* p_step, uint8_t period_frames,
+						   uint8_t phase_frames)
+{
+	if (num_slots >= CYCLIC_MAX_STEPS || period_frames == 0
+		|| phase_frames >= period_frames)
+	{
+		if (p_serial != NULL)
+		{
+			*p_serial << PMS ("ERROR adding step \"") << p_step->get_name () << '"'
+					  << endl;
+		}
+		return (false);
+	}
+
+	slots[num_slots].p_step = p_step;
+	slots[num_slots].period = period_frames;
+	slots[num_slots].countdown = phase_frames;
+	num_slots++;
+
+	return (true);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Set up all the steps, then run those which are due in each frame.
+ *  @details A step's countdown is the number of frames left before it's next due; it
+ *           runs when the countdown is zero, then waits @c period - 1 more frames.
+ *           No division is needed to find which steps are due. Each step is timed
+ *           on its own, and so is the whole frame.
+ */
+
+void CyclicExecutive::run (void)
+{
+	for (uint8_t index = 0; index < num_slots; index++)
+	{
+		slots[index].p_step->setup ();
+	}
+
+	TickType_t previous_ticks = xTaskGetTickCount ();
+
+	for (;;)
+	{
+		exec_time.begin ();
+		for (uint8_t index = 0; index < num_slots; index++)
+		{
+			slot_t& slot = slots[index];
+			if (slot.countdown == 0)
+			{
+				slot.exec_time.begin ();
+				slot.p_step->run_step ();
+				slot.exec_time.end ();
+				slot.countdown = slot.period;
+			}
+			slot.countdown--;
+		}
+		exec_time.end ();
+		runs++;
+
+		// If this frame's steps took the whole frame, the next frame is already late
+		// and counts as an overrun
+		delay_from_for (previous_ticks, frame);
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Print the table of steps, how often each runs, how many times each has
+ *           run and how long each run takes.
+ *  @param   p_ser_dev Pointer to a serial device on which to print the table
+ */
+
+void CyclicExecutive::print_steps (emstream* p_ser_dev)
+{
+	*p_ser_dev << PMS ("Step            Period\tRuns\tus min/avg/max") << endl;
+	for (uint8_t index = 0; index < num_slots; index++)
+	{
+		const char* step_name = slots[index].p_step->get_name ();
+		*p_ser_dev << step_name;
+		for (uint8_t cols = strlen (step_name); cols < 16; cols++)
+		{
+			p_ser_dev->putchar (' ');
+		}
+		*p_ser_dev << slots[index].period << '\t' << slots[index].p_step->get_runs ()
+				   << '\t';
+		slots[index].exec_time.print (*p_ser_dev);
+		*p_ser_dev << endl;
+	}
+	*p_ser_dev << PMS ("Frame overruns: ") << period_timing.get_misses () << endl;
+}
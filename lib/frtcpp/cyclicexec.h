@@ -0,0 +1,222 @@
+//*************************************************************************************
+/** @file    cyclicexec.h
+ *  @brief   Headers for periodic steps which can be run either each in its own task
+ *           or all together from one task by a cyclic executive.
+ *  @details This file contains a base class for periodic work which is written as a
+ *           @c setup() method and a @c step() method rather than as a task with its
+ *           own endless loop. A step can be run in its own FreeRTOS task by a
+ *           @c CyclicTask, or several steps can share one task, and one stack, in a
+ *           @c CyclicExecutive, which runs them in a fixed order each frame.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *    \li 10-17-2026 ME405 Group 3 Missed deadlines and wake up times kept by TaskBase
+ *    \li 10-17-2026 ME405 Group 3 Task stacks can be given to the constructors
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _CYCLICEXEC_H_
+#define _CYCLICEXEC_H_
+
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS tasks
+#include "taskbase.h"                       // Header for the ME405 base task class
+#include "emstream.h"                       // Header for serial ports and devices
+
+
+/** @brief   The largest number of steps which one cyclic executive can run.
+ *  @details The table of steps is kept inside the executive object, so each entry
+ *           costs a few bytes of RAM whether it's used or not.
+ */
+#ifndef CYCLIC_MAX_STEPS
+	#define CYCLIC_MAX_STEPS	6
+#endif
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Base class for a piece of periodic work which doesn't need a task of its
+ *           own.
+ *  @details A step is written much as a task is, except that the code which a task
+ *           would run once before its loop goes in @c setup(), and the code which it
+ *           would run each time around the loop goes in @c step(). Whatever runs the
+ *           step calls @c setup() once and then calls @c step() once each period, so
+ *           the step must never block for long or wait for its next period itself.
+ *           Variables which a task would keep in its @c run() method become members
+ *           of the step's class. Example:
+ *           @code
+ *           class StepExample : public CyclicStep
+ *           {
+ *           protected:
+ *               motor_drv* p_motor;
+ *           public:
+ *               StepExample (const char* a_name, emstream* p_ser_dev)
+ *                   : CyclicStep (a_name, p_ser_dev) { }
+ *               void setup (void) { p_motor = new motor_drv (p_serial, 1); }
+ *               void step (void) { p_motor->set_power (1000); }
+ *           };
+ *           ...
+ *           // Run the step every 10 ms in a task of its own...
+ *           new CyclicTask (new StepExample ("Example", &ser_port), 10,
+ *                           task_priority (2), 200, &ser_port);
+ *           // ...or share a task with other steps
+ *           p_executive->add (new StepExample ("Example", &ser_port));
+ *           @endcode
+ */
+
+class CyclicStep
+{
+	protected:
+		/// The name of the step, which is shown in lists of steps
+		const char* name;
+
+		/// A serial device on which the step can print, or @c NULL
+		emstream* p_serial;
+
+		/// The number of times the step has been run
+		uint32_t runs;
+
+	public:
+		// This constructor saves the step's name and serial device
+		CyclicStep (const char* a_name, emstream* p_ser_dev = NULL);
+
+		/** @brief   Get ready to run, before the first call to @c step().
+		 *  @details This is called once by the task which runs the step, after the
+		 *           scheduler has started. The default does nothing.
+		 */
+		virtual void setup (void) { }
+
+		/** @brief   Do one period's work.
+		 *  @details Each class of step must supply this method.
+		 */
+		virtual void step (void) = 0;
+
+		// Wait for the next period when the step has a task of its own
+		virtual bool wait_for_next (TickType_t& previous_ticks, TickType_t period);
+
+		/** @brief   Run the step once and count the run.
+		 */
+		void run_step (void)
+		{
+			step ();
+			runs++;
+		}
+
+		/// Get the name of the step
+		const char* get_name (void) const { return (name); }
+
+		/// Get the number of times the step has been run
+		uint32_t get_runs (void) const { return (runs); }
+}; // class CyclicStep
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Task class which runs one step in a FreeRTOS task of its own.
+ *  @details The task has the same name as its step. It calls the step's @c setup()
+ *           method, then calls @c step() and the step's @c wait_for_next() method
+ *           over and over; unless the step has its own way of waiting, it runs once
+ *           each period. Missed deadlines and wake up times are kept in the task's
+ *           @c period_timing, as they are for tasks which use @c delay_from_for().
+ */
+
+class CyclicTask : public TaskBase
+{
+	protected:
+		/// The step which this task runs
+		CyclicStep* p_step;
+
+		/// The period at which the step runs, in RTOS ticks
+		TickType_t period;
+
+	public:
+		// This constructor creates a task which runs one step
+		CyclicTask (CyclicStep* a_step, uint16_t a_period_ms,
+					unsigned portBASE_TYPE a_priority, size_t a_stack_size,
+					emstream* p_ser_dev = NULL, StackType_t* p_stack_buffer = NULL);
+
+		// This method is called by the RTOS to run the step indefinitely
+		void run (void);
+}; // class CyclicTask
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Task class which runs several steps from one task in a fixed order.
+ *  @details Time is divided into frames of equal length. At the start of each frame
+ *           the executive runs, in the order in which they were added, each step
+ *           which is due in that frame; a step added with a period of @e n frames
+ *           and a phase of @e p runs in frames @e p, @e p + @e n, @e p + 2 @e n and
+ *           so on. The steps never preempt one another, so they need no critical
+ *           sections among themselves, and they all use the executive's one stack
+ *           rather than a stack each. Tasks which aren't periodic, such as a user
+ *           interface, stay ordinary tasks, and should have lower priorities than
+ *           the executive.
+ *
+ *           The steps due in one frame must finish within the frame. When they
+ *           don't, the frame is counted as an overrun and the next frame starts at
+ *           once, so the executive catches up rather than drifting. Steps are
+ *           added before the scheduler is started:
+ *           @code
+ *           CyclicExecutive* p_exec = new CyclicExecutive ("Cyclic", task_priority (4),
+ *                                                          400, &ser_port, 10);
+ *           p_exec->add (p_sensor_step);         // Every frame, first
+ *           p_exec->add (p_control_step);        // Every frame, after the sensor
+ *           p_exec->add (p_logging_step, 10, 5); // Every 10th frame, in frames 5, 15...
+ *           @endcode
+ */
+
+class CyclicExecutive : public TaskBase
+{
+	protected:
+		/// An entry in the table of steps
+		struct slot_t
+		{
+			CyclicStep* p_step;				///< The step which is run
+			uint8_t period;					///< Frames from one run to the next
+			uint8_t countdown;				///< Frames left until the next run
+			ExecTime exec_time;				///< How long the step's runs take
+		};
+
+		/// The table of steps, in the order in which they're run
+		slot_t slots[CYCLIC_MAX_STEPS];
+
+		/// The number of steps in the table
+		uint8_t num_slots;
+
+		/// The length of one frame, in RTOS ticks
+		TickType_t frame;
+
+	public:
+		// This constructor creates an executive whose frames are the given length
+		CyclicExecutive (const char* a_name, unsigned portBASE_TYPE a_priority,
+						 size_t a_stack_size, emstream* p_ser_dev, uint16_t a_frame_ms,
+						 StackType_t* p_stack_buffer = NULL);
+
+		// Add a step to the end of the table
+		bool add (CyclicStep* p_step, uint8_t period_frames = 1,
+				  uint8_t phase_frames = 0);
+
+		// This method is called by the RTOS to run the steps indefinitely
+		void run (void);
+
+		/// Get the number of frames whose steps didn't finish within the frame
+		uint16_t get_overruns (void) const { return (period_timing.get_misses ()); }
+
+		// Print the table of steps, how many times each has run and for how long
+		void print_steps (emstream* p_ser_dev);
+}; // class CyclicExecutive
+
+#endif  // _CYCLICEXEC_H_
@@ -0,0 +1,148 @@
+//*************************************************************************************
+/** @file    exectime.h
+ *  @brief   A class which keeps the shortest, average and longest times taken by each
+ *           pass through a loop.
+ *  @details This file contains a small class which a task uses to time each pass
+ *           through its loop in microseconds, so that the list of tasks can show how
+ *           much of its period each task needs.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _EXECTIME_H_
+#define _EXECTIME_H_
+
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "time_stamp.h"                     // Header for high resolution time stamps
+#include "emstream.h"                       // Header for serial ports and devices
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Class which times passes through a loop and keeps their shortest, average
+ *           and longest durations.
+ *  @details A task calls @c begin() when it wakes up and @c end() when its work for
+ *           the period is done. The time between them is real time, so it includes any
+ *           time for which the task was preempted by higher priority tasks and
+ *           interrupts; it is the time the task's output takes to come out, which is
+ *           what must fit within the period. The FreeRTOS run time statistics, shown
+ *           by @c print_task_list(), give the CPU time used by the task alone.
+ *
+ *           The times are kept in microseconds. The average is the sum of the times
+ *           divided by the number of passes; when the sum gets big, both are halved,
+ *           so that the average keeps working for ever and is weighted a little
+ *           toward recent passes. Example:
+ *           @code
+ *           for (;;)
+ *           {
+ *               exec_time.begin ();
+ *               do_the_work ();
+ *               exec_time.end ();
+ *               delay_from_for_ms (previous_ticks, 10);
+ *           }
+ *           @endcode
+ */
+
+class ExecTime
+{
+	protected:
+		uint32_t start_us;					///< Time at which the current pass began
+		uint32_t min_us;					///< The shortest pass timed so far
+		uint32_t max_us;					///< The longest pass timed so far
+		uint32_t total_us;					///< Sum of the times of the counted passes
+		uint16_t count;						///< The number of passes in the sum
+
+	public:
+		/** @brief   Create a timer which hasn't timed any passes yet.
+		 */
+		ExecTime (void)
+		{
+			reset ();
+		}
+
+		/** @brief   Forget all the passes timed so far.
+		 */
+		void reset (void)
+		{
+			start_us = 0;
+			min_us = UINT32_MAX;
+			max_us = 0;
+			total_us = 0;
+			count = 0;
+		}
+
+		/** @brief   Note the time at which a pass through the loop begins.
+		 */
+		void begin (void)
+		{
+			time_stamp now;
+			start_us = now.set_to_now ().to_run_time_us ();
+		}
+
+		/** @brief   Note the time at which a pass through the loop ends, and keep it.
+		 */
+		void end (void)
+		{
+			time_stamp now;
+			uint32_t duration = now.set_to_now ().to_run_time_us () - start_us;
+
+			if (duration < min_us)
+			{
+				min_us = duration;
+			}
+			if (duration > max_us)
+			{
+				max_us = duration;
+			}
+			if (count == UINT16_MAX || total_us > UINT32_MAX - duration)
+			{
+				total_us /= 2;
+				count /= 2;
+			}
+			total_us += duration;
+			count++;
+		}
+
+		/// Get the shortest time of a pass in microseconds, or 0 if none were timed
+		uint32_t get_min_us (void) const { return (count ? min_us : 0); }
+
+		/// Get the average time of a pass in microseconds, or 0 if none were timed
+		uint32_t get_avg_us (void) const { return (count ? total_us / count : 0); }
+
+		/// Get the longest time of a pass in microseconds
+		uint32_t get_max_us (void) const { return (max_us); }
+
+		/** @brief   Print the shortest, average and longest times as "min/avg/max".
+		 *  @details If no passes have been timed, a dash is printed instead.
+		 *  @param   ser_dev The serial device on which to print the times
+		 */
+		void print (emstream& ser_dev) const
+		{
+			if (count == 0)
+			{
+				ser_dev << '-';
+			}
+			else
+			{
+				ser_dev << get_min_us () << '/' << get_avg_us () << '/' << max_us;
+			}
+		}
+}; // class ExecTime
+
+#endif  // _EXECTIME_H_
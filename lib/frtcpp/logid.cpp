@@ -0,0 +1,73 @@
+//*************************************************************************************
+/** @file    logid.cpp
+ *  @brief   Source code for log messages which are sent as a number and the raw
+ *           bytes of their values, and only made into text on a PC.
+ *  @details This file contains the log queue and the function which puts entries
+ *           into it; see @c logid.h for how entries are made.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+#include "time_stamp.h"                     // Header for high resolution time stamps
+#include "logid.h"                          // Pull in the header for these functions
+
+
+/** @brief   The queue into which log entries are put.
+ *  @details The program creates it with a wait time of zero, so that @c log_id() never
+ *           waits; until it's created, log entries are just counted as lost.
+ */
+TaskQueue<log_entry_t>* p_log_queue = NULL;
+
+/// The number of log entries lost because the queue was full or missing
+static uint16_t log_lost = 0;
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Time stamp a log entry and put it into the log queue, if there's room.
+ *  @details This is called by @c log_id() once the values are in the entry.
+ *  @param   entry The log entry
+ */
+
+void log_send (log_entry_t& entry)
+{
+	if (p_log_queue == NULL)
+	{
+		log_lost++;
+		return;
+	}
+
+	time_stamp now;
+	entry.time_us = now.set_to_now ().to_run_time_us ();
+	if (!p_log_queue->put (entry))
+	{
+		log_lost++;
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Get the number of log entries which have been lost because the queue was
+ *           full, or hadn't been created.
+ *  @return  The number of entries lost
+ */
+
+uint16_t log_get_lost (void)
+{
+	return (log_lost);
+}
@@ -0,0 +1,174 @@
+//*************************************************************************************
+/** @file    logid.h
+ *  @brief   Headers for log messages which are sent as a number and the raw bytes of
+ *           their values, and only made into text on a PC.
+ *  @details This file contains functions which put a log entry into a queue. An entry
+ *           holds the number of a message, the time and the values to be shown in it,
+ *           each as the bytes of a variable rather than as text, so logging costs a
+ *           few bytes copied rather than a call to @c ltoa() or @c __ftoa_engine for
+ *           each number. The text of each message lives only in a table which the PC
+ *           program @c telem2csv is compiled with; the program puts the values into
+ *           the text when the entry comes in through the telemetry port.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _LOGID_H_
+#define _LOGID_H_
+
+#include <string.h>                         // For memcpy()
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "taskqueue.h"                      // Header of wrapper for FreeRTOS queues
+
+
+/** @brief   The number of bytes of values which one log entry can hold.
+ *  @details Each value takes one byte for its type code and then its own bytes, so
+ *           12 bytes hold two 32-bit values and a 16-bit one, for example. A call to
+ *           @c log_id() with more than this is caught by the compiler.
+ */
+#ifndef LOG_ARG_BYTES
+	#define LOG_ARG_BYTES		12
+#endif
+
+
+/// One log entry, as it's kept in the log queue
+struct log_entry_t
+{
+	uint32_t time_us;						///< Time at which the entry was made
+	uint8_t id;								///< The number of the message
+	uint8_t length;							///< The number of bytes used in args
+	uint8_t args[LOG_ARG_BYTES];			///< Each value's type code, then its bytes
+};
+
+
+/// The queue into which log entries are put, or @c NULL if logging is turned off
+extern TaskQueue<log_entry_t>* p_log_queue;
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Trait which gives the one letter code by which the PC knows each type of
+ *           value in a log entry.
+ *  @details The integer codes are the same as those used by @c Telemetry. A value of
+ *           a type with no code, such as a @c double, is caught by the compiler and
+ *           can be cast to one which has a code.
+ */
+
+template <class DataType> struct log_type;
+
+/// Code for a character, which is shown as a character by a @c %c conversion
+template <> struct log_type<char> { static const char code = 'c'; };
+
+/// Code for a signed 8-bit value
+template <> struct log_type<int8_t> { static const char code = 'b'; };
+
+/// Code for an unsigned 8-bit value, which a @c bool is also sent as
+template <> struct log_type<uint8_t> { static const char code = 'B'; };
+
+/// Code for a @c bool, which takes one byte
+template <> struct log_type<bool> { static const char code = 'B'; };
+
+/// Code for a signed 16-bit value
+template <> struct log_type<int16_t> { static const char code = 'h'; };
+
+/// Code for an unsigned 16-bit value
+template <> struct log_type<uint16_t> { static const char code = 'H'; };
+
+/// Code for a signed 32-bit value
+template <> struct log_type<int32_t> { static const char code = 'i'; };
+
+/// Code for an unsigned 32-bit value
+template <> struct log_type<uint32_t> { static const char code = 'I'; };
+
+/// Code for a 32-bit floating point value
+template <> struct log_type<float> { static const char code = 'f'; };
+
+
+/// The number of bytes which a list of values takes in a log entry
+template <typename... Args> struct log_args_size
+{
+	static const uint8_t value = 0;			///< No values take no bytes
+};
+
+/// The number of bytes of a list of values is that of the first one and the rest
+template <class DataType, typename... Rest> struct log_args_size<DataType, Rest...>
+{
+	/// Each value takes a byte for its type code, then its own bytes
+	static const uint8_t value = 1 + sizeof (DataType) + log_args_size<Rest...>::value;
+};
+
+
+/** @brief   Put no more values into a log entry; this ends the list.
+ *  @param   entry The log entry
+ */
+inline void log_pack (log_entry_t& entry)
+{
+	(void)entry;
+}
+
+/** @brief   Put values into a log entry, each as a type code and then its own bytes.
+ *  @param   entry The log entry
+ *  @param   value The first value
+ *  @param   rest The rest of the values
+ */
+template <class DataType, typename... Rest>
+inline void log_pack (log_entry_t& entry, DataType value, Rest... rest)
+{
+	entry.args[entry.length++] = log_type<DataType>::code;
+	memcpy (entry.args + entry.length, &value, sizeof (DataType));
+	entry.length += sizeof (DataType);
+	log_pack (entry, rest...);
+}
+
+
+// Time stamp a log entry and put it into the queue, if there's room
+void log_send (log_entry_t& entry);
+
+// Get the number of log entries lost because the queue was full or missing
+uint16_t log_get_lost (void);
+
+
+/** @brief   Make a log entry holding a message number and some values.
+ *  @details The message numbers and the text into which the values are put are kept
+ *           in a table such as @c log_messages.h, which the PC decoder is compiled
+ *           with. The values are put into the text in order, one for each conversion
+ *           in it such as @c %d or @c %ld; their own types, not the conversions, set
+ *           how many bytes are sent, so a @c %d can show a 32-bit value. This function
+ *           never waits, so it can be called from the control loop; when the queue is
+ *           full the entry is dropped and counted. It must not be called in an ISR.
+ *           Example:
+ *           @code
+ *           log_id (LOG_ROUTE_START, distance, velocity);
+ *           @endcode
+ *  @param   id The number of the message
+ *  @param   args The values to be put into the message
+ */
+template <typename... Args> void log_id (uint8_t id, Args... args)
+{
+	static_assert (log_args_size<Args...>::value <= LOG_ARG_BYTES,
+				   "Too many bytes of values for one log entry");
+
+	log_entry_t entry;
+	entry.id = id;
+	entry.length = 0;
+	log_pack (entry, args...);
+	log_send (entry);
+}
+
+#endif  // _LOGID_H_
@@ -0,0 +1,147 @@
+//*************************************************************************************
+/** @file    notifyshare.h
+ *  @brief   A task share which wakes the tasks waiting for it when it is written.
+ *  @details This file contains a template class which adds a FreeRTOS event group to
+ *           a @c TaskShare. Each time a new value is put into the share, the share's
+ *           bits in the event group are set, so a task which would otherwise check
+ *           the share over and over can block until it has been written.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *    \li 10-17-2026 ME405 Group 3 Derived from @c TaskShare as protected, so it can't
+ *                                  be written through a @c TaskShare pointer
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _NOTIFYSHARE_H_
+#define _NOTIFYSHARE_H_
+
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "event_groups.h"                   // Header for FreeRTOS event groups
+#include "taskshare.h"                      // Header for thread-safe shared data
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Class for a task share which sets bits in an event group when it is
+ *           written.
+ *  @details A flag share, such as one which tells a task that a new motor power is
+ *           ready, is usually checked by its reader once each period. A change made
+ *           just after the check then waits almost a whole period to take effect.
+ *           This class sets bits in a FreeRTOS event group each time a value is put
+ *           into it, and a task can block on those bits with @c wait() or with
+ *           @c xEventGroupWaitBits(), waking as soon as the share is written.
+ *
+ *           Several shares may use the same event group with different bits, so one
+ *           task can wait for any of them at once; that's why the event group is
+ *           made by the caller and handed to the constructor. (The direct-to-task
+ *           notifications of later FreeRTOS versions would be a little faster, but
+ *           the FreeRTOS version in this library doesn't have them.)
+ *
+ *           A task which clears a flag after acting on it should use
+ *           @c put_quietly(), which doesn't set the bits, so that it isn't woken by
+ *           its own write. The event bits can't be set from within an ISR, as that
+ *           needs the FreeRTOS timer task; @c ISR_put() writes the data only.
+ *
+ *           @c TaskShare::put() isn't virtual, as making it so would turn every
+ *           write to every share into a call through a table. A @c put() made
+ *           through a @c TaskShare pointer would then skip the event bits, so this
+ *           class derives from @c TaskShare as @c protected: such a pointer can't be
+ *           taken, and only the methods which act the same as the base class's are
+ *           made public again. The increment and decrement operators aren't, as
+ *           they would change the data without setting the bits. @c Telemetry has
+ *           its own @c add() for these shares.
+ *           Example:
+ *           @code
+ *           EventGroupHandle_t power_events = xEventGroupCreate ();
+ *           NotifyShare<int8_t>* p_flag
+ *                       = new NotifyShare<int8_t> ("power_flag", power_events, 0x01);
+ *           ...
+ *           // In the task which acts on the flag
+ *           if (p_flag->wait (timeout_ticks) && p_flag->get () == 1)
+ *           {
+ *               do_something ();
+ *               p_flag->put_quietly (0);
+ *           }
+ *           @endcode
+ */
+
+template <class DataType> class NotifyShare : protected TaskShare<DataType>
+{
+	protected:
+		/// The event group in which bits are set when the share is written
+		EventGroupHandle_t event_group;
+
+		/// The bits which are set in the event group when the share is written
+		EventBits_t event_bits;
+
+	public:
+		// Reading, and writing from within an ISR, are just as in a TaskShare
+		using TaskShare<DataType>::get;
+		using TaskShare<DataType>::ISR_get;
+		using TaskShare<DataType>::ISR_put;
+
+		/** @brief   Construct a shared data item which sets event bits when written.
+		 *  @param   p_name A name to be shown in the list of task shares
+		 *  @param   a_group The event group in which bits are set; it must have been
+		 *           made with @c xEventGroupCreate()
+		 *  @param   a_bits The bits which are set each time the share is written
+		 */
+		NotifyShare<DataType> (const char* p_name, EventGroupHandle_t a_group,
+							   EventBits_t a_bits)
+			: TaskShare<DataType> (p_name), event_group (a_group), event_bits (a_bits)
+		{
+		}
+
+		/** @brief   Put data into the share and wake the tasks waiting for it.
+		 *  @param   new_data The data which is to be written
+		 */
+		void put (DataType new_data)
+		{
+			TaskShare<DataType>::put (new_data);
+			xEventGroupSetBits (event_group, event_bits);
+		}
+
+		/** @brief   Put data into the share without waking any task.
+		 *  @param   new_data The data which is to be written
+		 */
+		void put_quietly (DataType new_data)
+		{
+			TaskShare<DataType>::put (new_data);
+		}
+
+		/** @brief   Wait until the share is written or a time runs out.
+		 *  @details The share's bits are cleared when this method returns, so each
+		 *           write wakes the waiting task once. If the share was written
+		 *           since the last wait, this method returns at once.
+		 *  @param   ticks_to_wait The longest time to wait, in RTOS ticks
+		 *  @return  @c true if the share was written, or @c false if the time ran out
+		 */
+		bool wait (TickType_t ticks_to_wait)
+		{
+			return ((xEventGroupWaitBits (event_group, event_bits, pdTRUE, pdFALSE,
+										  ticks_to_wait) & event_bits) != 0);
+		}
+
+		/// Get the event group in which this share sets bits
+		EventGroupHandle_t get_event_group (void) const { return (event_group); }
+
+		/// Get the bits which this share sets in its event group
+		EventBits_t get_event_bits (void) const { return (event_bits); }
+}; // class NotifyShare<DataType>
+
+#endif  // _NOTIFYSHARE_H_
@@ -0,0 +1,46 @@
+//*************************************************************************************
+/** @file    periodtiming.cpp
+ *  @brief   Source code for a class which checks how late a periodic task wakes up
+ *           and whether it has missed its deadline.
+ *  @details This file contains the method of class @c PeriodTiming which prints its
+ *           histogram; the rest of the class is in @c periodtiming.h.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+#include "periodtiming.h"                   // Pull in the header for this class
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Print the histogram of wake up times on one line.
+ *  @details Each bin is shown as its upper limit in microseconds, a colon, and the
+ *           count, followed by the latest wake up and the number of missed deadlines.
+ *  @param   ser_dev The serial device on which to print the histogram
+ */
+
+void PeriodTiming::print (emstream& ser_dev) const
+{
+	for (uint8_t bin = 0; bin < PERIOD_TIMING_BINS - 1; bin++)
+	{
+		ser_dev << '<' << bin_limit_us (bin) << ':' << bins[bin] << ' ';
+	}
+	ser_dev << PMS (">=") << bin_limit_us (PERIOD_TIMING_BINS - 2) << ':'
+			<< bins[PERIOD_TIMING_BINS - 1] << PMS ("  max ") << max_late_us
+			<< PMS (" us  missed ") << misses;
+}
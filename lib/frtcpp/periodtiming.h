@@ -0,0 +1,172 @@
+//*************************************************************************************
+/** @file    periodtiming.h
+ *  @brief   A class which checks how late a periodic task wakes up and whether it
+ *           has missed its deadline.
+ *  @details This file contains a small class which keeps, for one periodic task, a
+ *           count of the periods in which the task's work wasn't finished before its
+ *           next period should have begun, and a histogram of how late the task woke
+ *           up at the start of each period.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *    \li 10-17-2026 ME405 Group 3 An early wake up counts as on time, not as very late
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _PERIODTIMING_H_
+#define _PERIODTIMING_H_
+
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS tasks
+#include "time_stamp.h"                     // Header for high resolution time stamps
+#include "emstream.h"                       // Header for serial ports and devices
+
+
+/** @brief   The number of bins in the histogram of wake up times.
+ *  @details The bins' upper limits are given by @c PeriodTiming::bin_limit_us().
+ */
+const uint8_t PERIOD_TIMING_BINS = 8;
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Class which keeps track of missed deadlines and wake up jitter of a task
+ *           which runs periodically.
+ *  @details A periodic task waits until a time computed from the time at which it was
+ *           last due, so each period should begin right on an RTOS tick. Just before
+ *           the task waits, @c check_deadline() sees whether that time has already
+ *           passed; if so, the task's work overran its period, the deadline is
+ *           counted as missed, and the RTOS lets the task run again at once to catch
+ *           up. When the task wakes, @c woke() finds how many microseconds after the
+ *           due time it actually began to run, and counts that time in a histogram.
+ *           The bins have limits of 50, 100, 200 and 500 us, 1, 2 and 5 ms; the last
+ *           bin holds everything later than that. The counts stop at 65535 rather
+ *           than wrapping around. @c TaskBase::delay_from_for() does all this for
+ *           each task which uses it.
+ */
+
+class PeriodTiming
+{
+	protected:
+		uint16_t bins[PERIOD_TIMING_BINS];	///< Counts of wake up times in each bin
+		uint16_t misses;					///< The number of missed deadlines
+		uint32_t max_late_us;				///< The latest wake up seen, in us
+
+		/** @brief   Add one to a count unless it's already as high as it can go.
+		 *  @param   count The count to be increased
+		 */
+		static void count_up (uint16_t& count)
+		{
+			if (count < UINT16_MAX)
+			{
+				count++;
+			}
+		}
+
+	public:
+		/** @brief   Create a record with no periods in it yet.
+		 */
+		PeriodTiming (void)
+		{
+			reset ();
+		}
+
+		/** @brief   Forget all the periods recorded so far.
+		 */
+		void reset (void)
+		{
+			for (uint8_t index = 0; index < PERIOD_TIMING_BINS; index++)
+			{
+				bins[index] = 0;
+			}
+			misses = 0;
+			max_late_us = 0;
+		}
+
+		/** @brief   Get the upper limit of one bin of the histogram.
+		 *  @param   bin The number of the bin, from 0 to @c PERIOD_TIMING_BINS - 1
+		 *  @return  The shortest time, in microseconds, which is too late for the bin;
+		 *           the last bin has no limit, so @c UINT32_MAX is returned
+		 */
+		static uint32_t bin_limit_us (uint8_t bin)
+		{
+			switch (bin)
+			{
+				case (0): return (50);
+				case (1): return (100);
+				case (2): return (200);
+				case (3): return (500);
+				case (4): return (1000);
+				case (5): return (2000);
+				case (6): return (5000);
+				default:  return (UINT32_MAX);
+			}
+		}
+
+		/** @brief   Check, just before a task waits, whether it's too late for the
+		 *           next period.
+		 *  @param   from_ticks The time at which the current period began
+		 *  @param   period The length of a period in RTOS ticks
+		 */
+		void check_deadline (TickType_t from_ticks, TickType_t period)
+		{
+			if ((TickType_t)(xTaskGetTickCount () - from_ticks) >= period)
+			{
+				count_up (misses);
+			}
+		}
+
+		/** @brief   Find how late a task woke up for a new period and record it.
+		 *  @details The time stamp and the tick count aren't read at the same moment,
+		 *           so a task can seem to wake a few microseconds before it was due;
+		 *           that is counted as waking on time.
+		 *  @param   due_ticks The RTOS tick at which the new period was to begin
+		 */
+		void woke (TickType_t due_ticks)
+		{
+			time_stamp now;
+			int32_t early_or_late = (int32_t)(now.set_to_now ().to_run_time_us ()
+									- (uint32_t)due_ticks * (1000000UL / configTICK_RATE_HZ));
+			uint32_t late_us = (early_or_late < 0) ? 0 : early_or_late;
+
+			uint8_t bin = 0;
+			while (bin < PERIOD_TIMING_BINS - 1 && late_us >= bin_limit_us (bin))
+			{
+				bin++;
+			}
+			count_up (bins[bin]);
+
+			if (late_us > max_late_us)
+			{
+				max_late_us = late_us;
+			}
+		}
+
+		/// Get the number of deadlines missed
+		uint16_t get_misses (void) const { return (misses); }
+
+		/// Get the latest wake up seen, in microseconds
+		uint32_t get_max_late_us (void) const { return (max_late_us); }
+
+		/// Get the number of wake ups counted in one bin of the histogram
+		uint16_t get_bin (uint8_t bin) const { return (bins[bin]); }
+
+		// Print the histogram of wake up times on one line
+		void print (emstream& ser_dev) const;
+}; // class PeriodTiming
+
+#endif  // _PERIODTIMING_H_
@@ -0,0 +1,283 @@
+//*************************************************************************************
+/** @file    sharedblock.h
+ *  @brief   A structure of related data which is shared between tasks as one item.
+ *  @details This file contains a template class which shares a whole @c struct
+ *           between tasks, so that fields which belong together are always written
+ *           and read together. A writer publishes the structure in one critical
+ *           section; readers take a consistent snapshot of it without any critical
+ *           section, using a sequence count in the manner of a Linux @e seqlock.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but its
+ *		use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _SHAREDBLOCK_H_
+#define _SHAREDBLOCK_H_
+
+#include <string.h>                         // C language string handling functions
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "baseshare.h"                      // Base class for shared data items
+
+
+/** @brief   Keeps the compiler from moving memory accesses across this point.
+ *  @details The AVR port's critical section macros don't tell the compiler that
+ *           memory may change, so this barrier is needed to keep the copying of a
+ *           block's data between the two changes of its sequence count. No
+ *           instructions are generated for it.
+ */
+#define SHARED_BLOCK_BARRIER()  __asm__ __volatile__ ("" ::: "memory")
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Class for a structure of data shared in a thread-safe manner between
+ *           tasks.
+ *  @details A @c TaskShare holds one variable, so a task which needs several related
+ *           variables must read them one at a time, paying for a critical section
+ *           each time and risking getting some values from before and some from
+ *           after another task has changed them. A @c SharedBlock holds a whole
+ *           @c struct instead, and all of it is written or read as one item.
+ *
+ *           Writing is done inside a critical section, just as for a share. Reading
+ *           uses no critical section at all. The block keeps a one-byte sequence
+ *           count which a writer makes odd before it changes the data and even again
+ *           afterwards; a reader notes the count, copies the data, and then checks
+ *           that the count is even and hasn't changed. If a write came while the
+ *           copy was being made, the reader simply copies the data again. On a
+ *           single processor a task can't be reading while a write is half done
+ *           (the write is in a critical section), so a reader makes a second copy
+ *           only if it was interrupted by a write, and never waits. Interrupts are
+ *           thus never held off by readers, however large the block.
+ *
+ *           The count is one byte so that it can be read with one instruction. It
+ *           wraps around after 128 writes, so a reader which is kept from running in
+ *           the middle of its copy for that many writes could miss them; the blocks
+ *           in a control program are written once per period or less, so this would
+ *           take seconds of starvation.
+ *
+ *           A writer which changes only some fields uses @c begin_write(), which
+ *           returns a reference to the data, and @c end_write(). Fields which aren't
+ *           changed keep their values, so tasks which each own some of the fields
+ *           don't overwrite each other's. As these calls enter and exit a critical
+ *           section, the code between them must be short and must not block.
+ *           Example:
+ *           @code
+ *           struct motor_block_t { int16_t speed[2]; int16_t power[2]; };
+ *           SharedBlock<motor_block_t>* sh_motors
+ *                                         = new SharedBlock<motor_block_t> ("motors");
+ *           ...
+ *           // In the task which measures speed
+ *           motor_block_t& motors = sh_motors->begin_write ();
+ *           motors.speed[0] = speed_1;
+ *           motors.speed[1] = speed_2;
+ *           sh_motors->end_write ();
+ *           ...
+ *           // In the task which uses the speeds and powers together
+ *           motor_block_t motors = sh_motors->get ();
+ *           @endcode
+ */
+
+template <class DataType> class SharedBlock : public BaseShare
+{
+	protected:
+		DataType the_data;					///< Holds the data to be shared
+
+		/** @brief   The sequence count, which is odd while a write is under way.
+		 */
+		volatile uint8_t sequence;
+
+	public:
+		/** @brief   Construct a shared block of data.
+		 *  @details The data is set to all zeros, so each field of a plain @c struct
+		 *           starts at zero.
+		 *  @param   p_name A name to be shown in the list of task shares
+		 */
+		SharedBlock<DataType> (const char* p_name) : BaseShare (p_name), sequence (0)
+		{
+			memset (&the_data, 0, sizeof (DataType));
+		}
+
+		// Begin changing some of the data; a critical section is entered. On the
+		// AVR the critical section pushes the status register onto the stack, so
+		// this and end_write() must always be inlined into the caller
+		inline DataType& begin_write (void) __attribute__ ((always_inline));
+
+		// Finish changing the data and exit the critical section
+		inline void end_write (void) __attribute__ ((always_inline));
+
+		// Write the whole structure of data
+		void put (const DataType& new_data);
+
+		// Write the whole structure of data from within an ISR only
+		void ISR_put (const DataType& new_data);
+
+		// Read a consistent copy of the whole structure of data
+		DataType get (void);
+
+		// Read the whole structure of data from within an ISR only
+		DataType ISR_get (void);
+
+		// Print the block's status within a list of all shares' statuses
+		void print_in_list (emstream* p_ser_dev);
+}; // class SharedBlock<DataType>
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Begin changing the data in the shared block.
+ *  @details This method enters a critical section and makes the sequence count odd,
+ *           then returns a reference through which the data can be changed. Every
+ *           call must be followed, soon and in the same task, by a call to
+ *           @c end_write(). It must not be called from within an ISR.
+ *  @return  A reference to the block's data
+ */
+
+template <class DataType>
+inline DataType& SharedBlock<DataType>::begin_write (void)
+{
+	portENTER_CRITICAL ();
+	sequence = sequence + 1;
+	SHARED_BLOCK_BARRIER ();
+
+	return (the_data);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Finish changing the data in the shared block.
+ *  @details This method makes the sequence count even again, which tells readers
+ *           that a new, complete set of data is available, and then exits the
+ *           critical section entered by @c begin_write().
+ */
+
+template <class DataType>
+inline void SharedBlock<DataType>::end_write (void)
+{
+	SHARED_BLOCK_BARRIER ();
+	sequence = sequence + 1;
+	portEXIT_CRITICAL ();
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Write a whole new structure of data into the shared block.
+ *  @param   new_data The data which is to be written
+ */
+
+template <class DataType>
+void SharedBlock<DataType>::put (const DataType& new_data)
+{
+	begin_write () = new_data;
+	end_write ();
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Write a whole new structure of data into the shared block from within
+ *           an ISR.
+ *  @details This method must only be called from within a hardware interrupt, not a
+ *           normal task, as critical section protection isn't used here. The
+ *           sequence count is still changed so that a task which was interrupted
+ *           while it was reading the block will read it again.
+ *  @param   new_data The data which is to be written
+ */
+
+template <class DataType>
+void SharedBlock<DataType>::ISR_put (const DataType& new_data)
+{
+	sequence = sequence + 1;
+	SHARED_BLOCK_BARRIER ();
+	the_data = new_data;
+	SHARED_BLOCK_BARRIER ();
+	sequence = sequence + 1;
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Read a consistent copy of the data in the shared block.
+ *  @details This method copies the data without a critical section. If the sequence
+ *           count shows that the data was being changed while it was copied, the
+ *           copy is made again, so the copy returned is always one which a writer
+ *           published as a whole.
+ *  @return  A copy of the data in the shared block
+ */
+
+template <class DataType>
+DataType SharedBlock<DataType>::get (void)
+{
+	DataType copy;
+	uint8_t count_before;
+
+	do
+	{
+		count_before = sequence;
+		SHARED_BLOCK_BARRIER ();
+		copy = the_data;
+		SHARED_BLOCK_BARRIER ();
+	}
+	while ((count_before & 0x01) || sequence != count_before);
+
+	return (copy);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Read the data in the shared block from within an ISR.
+ *  @details This method must only be called from within an interrupt service
+ *           routine, not a normal task. As no task can write while an interrupt is
+ *           being serviced, and tasks write only in critical sections, the data is
+ *           simply copied.
+ *  @return  A copy of the data in the shared block
+ */
+
+template <class DataType>
+DataType SharedBlock<DataType>::ISR_get (void)
+{
+	return (the_data);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Print the block's name and type within a list of all shares.
+ *  @details This method prints one line for this block and then asks the next item
+ *           in the list of shares to print itself.
+ *  @param   p_ser_dev Pointer to a serial device on which to print the status
+ */
+
+template <class DataType>
+void SharedBlock<DataType>::print_in_list (emstream* p_ser_dev)
+{
+	// Print this block's name and pad it to 16 characters
+	*p_ser_dev << name;
+	for (uint8_t cols = strlen (name); cols < 16; cols++)
+	{
+		p_ser_dev->putchar (' ');
+	}
+
+	p_ser_dev->puts ("block\t");
+
+	// End the line
+	*p_ser_dev << endl;
+
+	// Call the next item
+	if (p_next != NULL)
+	{
+		p_next->print_in_list (p_ser_dev);
+	}
+}
+
+#endif  // _SHAREDBLOCK_H_
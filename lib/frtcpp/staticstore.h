@@ -0,0 +1,159 @@
+//*************************************************************************************
+/** @file    staticstore.h
+ *  @brief   Templates which hold objects and task stacks in memory laid out by the
+ *           linker rather than taken from the heap.
+ *  @details This file contains a holder for one object of any class, such as a task,
+ *           a share or a queue, and a holder for a task's stack. Each holder is made a
+ *           global or static variable, so it appears by name in the link map and in
+ *           the list printed by 'make ramreport'. When @c STATIC_ALLOCATION is 0 the
+ *           holders take no space and use @c new instead, so that the same program
+ *           can be built either way. FreeRTOS 8 always takes each task's control
+ *           block, each queue's storage and each event group from the heap, so the
+ *           heap can be made smaller but can't be done away with.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *    \li 10-17-2026 ME405 Group 3 Holders are off unless STATIC_ALLOCATION is set
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _STATICSTORE_H_
+#define _STATICSTORE_H_
+
+#include <stdlib.h>                         // For size_t
+#include "FreeRTOS.h"                       // Main header for FreeRTOS, for StackType_t
+#include "mechutil.h"                       // The ME405 versions of new and delete
+
+#if defined (__AVR__)
+	/** @brief   The placement form of @c new, which builds an object in memory which
+	 *           has already been set aside for it.
+	 *  @details It isn't in avr-libc, so it's defined here; elsewhere it comes from
+	 *           the C++ library's header @c <new>.
+	 *  @param   size The size of the object, which isn't needed
+	 *  @param   p_place A pointer to the memory in which the object is built
+	 *  @return  The same pointer, @c p_place
+	 */
+	inline void* operator new (size_t size, void* p_place)
+	{
+		(void)size;
+		return (p_place);
+	}
+#else
+	#include <new>
+#endif
+
+
+// STATIC_ALLOCATION is set in FreeRTOSConfig.h, where the heap is made smaller to suit;
+// this default is only for programs whose configuration file doesn't set it
+#ifndef STATIC_ALLOCATION
+	#define STATIC_ALLOCATION	0
+#endif
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Holder for one object which is built in place rather than with @c new.
+ *  @details The holder is a global or static variable, so the space for the object is
+ *           laid out by the linker; the object is built in it by @c create(), which
+ *           takes the same parameters as the object's constructor and returns a
+ *           pointer just as @c new would. The object is never destroyed, as tasks,
+ *           shares and queues live until the power goes off. @c create() must only be
+ *           called once for each holder. Example:
+ *           @code
+ *           StaticStore<TaskShare<int32_t> > store_position;
+ *           ...
+ *           sh_position = store_position.create ("sh_position");
+ *           @endcode
+ */
+
+template <class T, bool STATIC = STATIC_ALLOCATION> class StaticStore
+{
+	protected:
+		/// The space in which the object is built, aligned as the object needs
+		uint8_t storage[sizeof (T)] __attribute__ ((aligned (__alignof__ (T))));
+
+	public:
+		/** @brief   Build the object in the holder.
+		 *  @param   args The parameters for the object's constructor
+		 *  @return  A pointer to the new object
+		 */
+		template <typename... Args> T* create (Args... args)
+		{
+			return (new (storage) T (args...));
+		}
+}; // class StaticStore
+
+
+/** @brief   Holder which builds its object with @c new, used when @c STATIC_ALLOCATION
+ *           is 0.
+ */
+template <class T> class StaticStore<T, false>
+{
+	public:
+		/** @brief   Build the object on the heap.
+		 *  @param   args The parameters for the object's constructor
+		 *  @return  A pointer to the new object
+		 */
+		template <typename... Args> T* create (Args... args)
+		{
+			return (new T (args...));
+		}
+}; // class StaticStore<T, false>
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Holder for a task's stack.
+ *  @details The holder is given to the task's constructor as the size and place of
+ *           the stack, and FreeRTOS then uses it rather than taking the stack from
+ *           the heap. Example:
+ *           @code
+ *           TaskStack<280> stack_user;
+ *           ...
+ *           new task_user ("UserInterface", task_priority (1), stack_user.size (),
+ *                          &ser_port, stack_user.buffer ());
+ *           @endcode
+ */
+
+template <size_t SIZE, bool STATIC = STATIC_ALLOCATION> class TaskStack
+{
+	protected:
+		/// The stack itself
+		StackType_t stack[SIZE];
+
+	public:
+		/// Get the size of the stack, in units of @c StackType_t (bytes on an AVR)
+		size_t size (void) const { return (SIZE); }
+
+		/// Get a pointer to the stack, to be given to the task's constructor
+		StackType_t* buffer (void) { return (stack); }
+}; // class TaskStack
+
+
+/** @brief   Stack holder which lets FreeRTOS take the stack from the heap, used when
+ *           @c STATIC_ALLOCATION is 0.
+ */
+template <size_t SIZE> class TaskStack<SIZE, false>
+{
+	public:
+		/// Get the size of the stack, in units of @c StackType_t (bytes on an AVR)
+		size_t size (void) const { return (SIZE); }
+
+		/// Get a null pointer, which tells FreeRTOS to take the stack from the heap
+		StackType_t* buffer (void) { return (NULL); }
+}; // class TaskStack<SIZE, false>
+
+#endif  // _STATICSTORE_H_
@@ -0,0 +1,287 @@
+//*************************************************************************************
+/** @file    streambuffer.cpp
+ *  @brief   Source code for a text queue which moves characters in blocks through a
+ *           circular buffer rather than one at a time through a FreeRTOS queue.
+ *  @details This file contains the methods of class @c StreamBuffer; see
+ *           @c streambuffer.h for how it's used.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+#include <string.h>                         // C language string handling functions
+#include "streambuffer.h"                   // Pull in the header for this class
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Create a stream buffer, with its memory and the semaphores on which tasks
+ *           wait for it.
+ *  @param   size The number of characters which the buffer can hold
+ *  @param   p_name A name to be shown in the list of task shares
+ *  @param   p_ser_dev A pointer to a serial device on which errors are printed, or
+ *                     @c NULL (default: @c NULL)
+ *  @param   a_wait_time How long, in RTOS ticks, a writer waits for room in a full
+ *                       buffer before it drops the characters which don't fit
+ *                       (default: @c portMAX_DELAY)
+ *  @param   a_trigger_level The number of characters which must be in the buffer
+ *                           before a waiting reader is woken up (default: 1)
+ */
+
+StreamBuffer::StreamBuffer (uint16_t size, const char* p_name, emstream* p_ser_dev,
+							TickType_t a_wait_time, uint16_t a_trigger_level)
+	: emstream (), BaseShare (p_name), buf_size (size), i_put (0), i_get (0),
+	  how_full (0), writers_waiting (0), lost (0), ticks_to_wait (a_wait_time),
+	  p_serial (p_ser_dev)
+{
+	// A trigger level of zero or more than the buffer holds could never be reached
+	trigger_level = a_trigger_level;
+	if (trigger_level == 0)
+	{
+		trigger_level = 1;
+	}
+	else if (trigger_level > size)
+	{
+		trigger_level = size;
+	}
+
+	p_buffer = new char[size];
+	data_ready = xSemaphoreCreateBinary ();
+	space_ready = xSemaphoreCreateBinary ();
+
+	if (p_buffer == NULL || data_ready == NULL || space_ready == NULL)
+	{
+		DBG (p_serial, PMS ("ERROR creating ") << size << PMS ("B stream buffer ")
+			 << p_name << endl);
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Write a block of characters into the buffer.
+ *  @details As many of the characters as fit are copied in one critical section. If
+ *           the number of characters in the buffer reaches the trigger level, the
+ *           reader is woken up. If the buffer fills, this method waits for the reader
+ *           to make room, then carries on; if no room is made within the wait time,
+ *           the rest of the characters are dropped and counted.
+ *  @param   p_data A pointer to the characters to be written
+ *  @param   length The number of characters to write
+ */
+
+void StreamBuffer::write (const char* p_data, size_t length)
+{
+	while (length > 0)
+	{
+		portENTER_CRITICAL ();
+		uint16_t count = buf_size - how_full;
+		if (count > length)
+		{
+			count = length;
+		}
+
+		// The characters may wrap around the end of the buffer, taking two copies
+		uint16_t first = buf_size - i_put;
+		if (first > count)
+		{
+			first = count;
+		}
+		memcpy (p_buffer + i_put, p_data, first);
+		memcpy (p_buffer, p_data + first, count - first);
+		i_put += count;
+		if (i_put >= buf_size)
+		{
+			i_put -= buf_size;
+		}
+
+		bool wake_reader = (how_full < trigger_level
+							&& how_full + count >= trigger_level);
+		how_full += count;
+		if (count == 0)
+		{
+			writers_waiting++;
+		}
+		portEXIT_CRITICAL ();
+
+		if (wake_reader)
+		{
+			xSemaphoreGive (data_ready);
+		}
+
+		p_data += count;
+		length -= count;
+
+		// If nothing fit, wait for the reader to make room or give up
+		if (count == 0 && xSemaphoreTake (space_ready, ticks_to_wait) != pdTRUE)
+		{
+			portENTER_CRITICAL ();
+			if (writers_waiting > 0)
+			{
+				writers_waiting--;
+			}
+			lost += length;
+			portEXIT_CRITICAL ();
+			return;
+		}
+	}
+
+	// If another writer is waiting and there's still room, pass the wake up along
+	portENTER_CRITICAL ();
+	bool wake_writer = (writers_waiting > 0 && how_full < buf_size);
+	if (wake_writer)
+	{
+		writers_waiting--;
+	}
+	portEXIT_CRITICAL ();
+
+	if (wake_writer)
+	{
+		xSemaphoreGive (space_ready);
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Read up to the given number of characters from the buffer.
+ *  @details If there are fewer characters in the buffer than the trigger level (or
+ *           than @c length, if that's smaller), this method waits for a writer to
+ *           bring the buffer up to the trigger level. Once there are enough, or once
+ *           the wait time is over, it copies out as many as there are, up to
+ *           @c length. A wait time of zero makes this method return at once with
+ *           whatever is in the buffer, as a polling task would want. If a writer is
+ *           waiting for room, it's woken up.
+ *  @param   p_data A pointer to the memory into which the characters are copied
+ *  @param   length The largest number of characters to copy
+ *  @param   wait The longest time to wait, in RTOS ticks (default: @c portMAX_DELAY)
+ *  @return  The number of characters copied, which is zero if the wait time was over
+ *           with nothing in the buffer
+ */
+
+size_t StreamBuffer::read (char* p_data, size_t length, TickType_t wait)
+{
+	bool timed_out = (length == 0);
+	uint16_t wanted = (length < trigger_level) ? length : trigger_level;
+
+	for (;;)
+	{
+		portENTER_CRITICAL ();
+		if (how_full >= wanted || timed_out)
+		{
+			uint16_t count = (how_full < length) ? how_full : length;
+			uint16_t first = buf_size - i_get;
+			if (first > count)
+			{
+				first = count;
+			}
+			memcpy (p_data, p_buffer + i_get, first);
+			memcpy (p_data + first, p_buffer, count - first);
+			i_get += count;
+			if (i_get >= buf_size)
+			{
+				i_get -= buf_size;
+			}
+			how_full -= count;
+
+			bool wake_writer = (writers_waiting > 0 && count > 0);
+			if (wake_writer)
+			{
+				writers_waiting--;
+			}
+			portEXIT_CRITICAL ();
+
+			if (wake_writer)
+			{
+				xSemaphoreGive (space_ready);
+			}
+			return (count);
+		}
+		portEXIT_CRITICAL ();
+
+		// A give left over from an earlier write may wake this task early; if so, the
+		// buffer is checked again and the task waits again
+		if (xSemaphoreTake (data_ready, wait) != pdTRUE)
+		{
+			timed_out = true;
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Check if a character is ready to be read from the buffer.
+ *  @return  True if there's a character in the buffer, false if not
+ */
+
+bool StreamBuffer::check_for_char (void)
+{
+	portENTER_CRITICAL ();
+	bool not_empty = (how_full != 0);
+	portEXIT_CRITICAL ();
+
+	return (not_empty);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Read one character from the buffer.
+ *  @details If the buffer is empty, this method blocks until a writer brings it up to
+ *           the trigger level, as @c TextQueue::getchar() blocks until a character is
+ *           received.
+ *  @return  The character which was read, or -1 if none came
+ */
+
+char StreamBuffer::getchar (void)
+{
+	char recv_char;
+
+	if (read (&recv_char, 1) == 0)
+	{
+		return (-1);
+	}
+	return (recv_char);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Print the status of the buffer.
+ *  @details This method writes the buffer's name, its free and total space and the
+ *           number of characters which have been dropped to the given serial device,
+ *           then calls the same method for the next item in the list of shares.
+ *  @param   p_ser_dev Pointer to a serial device on which to print the status
+ */
+
+void StreamBuffer::print_in_list (emstream* p_ser_dev)
+{
+	// Print this buffer's name and pad it to 16 characters
+	*p_ser_dev << name;
+	for (uint8_t cols = strlen (name); cols < 16; cols++)
+	{
+		p_ser_dev->putchar (' ');
+	}
+
+	// Print the type, then the free and total space and how many characters were lost
+	p_ser_dev->puts ("str_b\t");
+	portENTER_CRITICAL ();
+	uint16_t free_space = buf_size - how_full;
+	portEXIT_CRITICAL ();
+	*p_ser_dev << free_space << '/' << buf_size << '\t' << lost << PMS (" lost") << endl;
+
+	// Call the next item
+	if (p_next != NULL)
+	{
+		p_next->print_in_list (p_ser_dev);
+	}
+}
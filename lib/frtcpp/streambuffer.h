@@ -0,0 +1,143 @@
+//*************************************************************************************
+/** @file    streambuffer.h
+ *  @brief   Headers for a text queue which moves characters in blocks through a
+ *           circular buffer rather than one at a time through a FreeRTOS queue.
+ *  @details This file contains a class which can be used in place of @c TextQueue.
+ *           A @c TextQueue calls @c xQueueSendToBack() for each character written
+ *           and @c xQueueReceive() for each one read, and each call goes into the
+ *           kernel and a critical section, so a 40 character line costs about 80
+ *           kernel calls. A @c StreamBuffer copies each block of characters into its
+ *           buffer in one short critical section, and only calls the kernel to wake a
+ *           task which is waiting.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _STREAMBUFFER_H_
+#define _STREAMBUFFER_H_
+
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "semphr.h"                         // Header for FreeRTOS semaphores
+#include "emstream.h"                       // Pull in the base class header file
+#include "baseshare.h"                      // Base class for thread-safe shared data
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Converts data to characters with @c << and puts them into a circular
+ *           buffer from which another task reads them in blocks.
+ *  @details This class has the same @c emstream interface as @c TextQueue, so it's
+ *           written to with @c << and read with @c check_for_char() and @c getchar(),
+ *           and it also has @c write() and @c read() methods which move a block of
+ *           characters at once. Strings printed with @c << arrive in @c write() as
+ *           one block, so they take one critical section however long they are.
+ *
+ *           The characters are kept in a buffer of the size given to the constructor.
+ *           Any number of tasks may write into it, but only one task should read from
+ *           it. A reader which finds it empty waits on a binary semaphore, which a
+ *           writer gives only when the number of characters in the buffer reaches the
+ *           trigger level; a trigger level of more than one lets a reader wake up once
+ *           for each block of text rather than once for each character. A writer
+ *           which finds the buffer full waits on a second semaphore, which the reader
+ *           gives when it makes room, for no longer than the wait time given to the
+ *           constructor; characters which still don't fit are dropped and counted.
+ *           Neither semaphore is touched while nobody is waiting, so a write or a
+ *           read usually costs no kernel calls at all. This class must not be used in
+ *           an interrupt service routine.
+ *
+ *           Example, in which the reading task copies what it reads to a serial port:
+ *           @code
+ *           StreamBuffer* p_print_ser_queue;
+ *           ...
+ *           p_print_ser_queue = new StreamBuffer (64, "Print", p_ser_port, 30);
+ *           ...
+ *           *p_print_ser_queue << PMS ("The data is: ") << a_data_item << endl;
+ *           ...
+ *           char block[16];
+ *           size_t count = p_print_ser_queue->read (block, sizeof (block), 0);
+ *           p_serial->write (block, count);
+ *           @endcode
+ */
+
+class StreamBuffer : public emstream, public BaseShare
+{
+	// This protected data can only be accessed from this class or its descendents
+	protected:
+		char* p_buffer;                     ///< The memory which holds the characters
+		uint16_t buf_size;                  ///< Size of the buffer in bytes
+		uint16_t i_put;                     ///< Index where the next character goes
+		uint16_t i_get;                     ///< Index of the oldest character
+		uint16_t how_full;                  ///< Number of characters in the buffer
+		uint16_t trigger_level;             ///< Characters which wake the reader
+		uint8_t writers_waiting;            ///< Writers waiting for room
+		uint16_t lost;                      ///< Characters dropped after waiting
+		SemaphoreHandle_t data_ready;       ///< Given when the trigger level is reached
+		SemaphoreHandle_t space_ready;      ///< Given when room is made for a writer
+		TickType_t ticks_to_wait;           ///< RTOS ticks to wait for a full buffer
+		emstream* p_serial;                 ///< Serial device used for debugging
+
+	// Public methods can be called from anywhere in the program where there is a
+	// pointer or reference to an object of this class
+	public:
+		// The constructor creates the buffer and its semaphores
+		StreamBuffer (uint16_t size, const char* p_name, emstream* = NULL,
+					  TickType_t = portMAX_DELAY, uint16_t a_trigger_level = 1);
+
+		// Write a block of characters into the buffer
+		void write (const char* p_data, size_t length);
+
+		// Read up to the given number of characters from the buffer
+		size_t read (char* p_data, size_t length, TickType_t wait = portMAX_DELAY);
+
+		/** @brief   Write one character into the buffer.
+		 *  @param   a_char The character to be written
+		 */
+		void putchar (char a_char)
+		{
+			write (&a_char, 1);
+		}
+
+		// Check if a character is in the buffer
+		bool check_for_char (void);
+
+		// Read a character from the buffer, waiting for one if there isn't one
+		char getchar (void);
+
+		/** This overloaded boolean operator returns true if there are characters in
+		 *  the buffer, as it does for a @c TextQueue.
+		 */
+		operator bool ()
+		{
+			return (check_for_char ());
+		}
+
+		/** @brief   Get the number of characters which were dropped because the
+		 *           buffer stayed full for longer than the wait time.
+		 *  @return  The number of characters lost
+		 */
+		uint16_t get_lost (void)
+		{
+			return (lost);
+		}
+
+		// Print the status of this buffer in the table of queue status printouts
+		void print_in_list (emstream* p_ser_dev);
+};
+
+#endif  // _STREAMBUFFER_H_
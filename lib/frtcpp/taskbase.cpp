@@ -10,6 +10,7 @@
  *    \li 10-21-2012 JRR Original file
  *    \li 08-25-2012 JRR Modified to run with STM32's as well as AVR's
  *    \li 08-26-2014 JRR Changed file names and base task class name to TaskBase
+ *    \li 10-17-2026 ME405 Group 3 A task's stack can be given to it instead of taken from the heap
  *
  *  Credits:
  *      This code uses techniques learned from Amigo software, which is copyright 2012 
@@ -78,20 +79,26 @@ TaskBase* last_created_task_pointer = NULL;
  *                        (default: @c configMINIMAL_STACK_SIZE)
  *  @param   p_ser_dev Pointer to a serial device (port, radio, SD card, etc.) which 
  *                     can be used by this task to communicate (default: NULL)
+ *  @param   p_stack_buffer Pointer to memory, at least @c a_stack_size long, to be
+ *                          used as the task's stack, such as a @c TaskStack; if it's
+ *                          NULL, the stack is taken from the heap (default: NULL)
  */
 
 TaskBase::TaskBase (const char* a_name, unsigned portBASE_TYPE a_priority, 
-					size_t a_stack_size, emstream* p_ser_dev)
+					size_t a_stack_size, emstream* p_ser_dev, 
+					StackType_t* p_stack_buffer)
 {
 	// Create the task with a call to the RTOS task creation function
-	portBASE_TYPE task_status = xTaskCreate
+	portBASE_TYPE task_status = xTaskGenericCreate
 		(
 		 reinterpret_cast<void(*)(void*)>(_call_static_run_method), // The run method
 		 (const char*)a_name,                                       // Task name
 		 a_stack_size,                                              // Task stack size
 		 this,                                      // Pointer to this frt_task object
 		 a_priority,                                // Priority for the new task
-		 &handle                                    // The new task's handle
+		 &handle,                                   // The new task's handle
+		 p_stack_buffer,                            // The stack, or NULL for the heap
+		 NULL                                       // No memory protection regions
 		);
 
 	// Save the serial port pointer and the total stack size
@@ -111,6 +118,9 @@ TaskBase::TaskBase (const char* a_name, unsigned portBASE_TYPE a_priority,
 
 	// Initialize the run counter
 	runs = 0;
+	#if (configGENERATE_RUN_TIME_STATS == 1)
+		previous_run_time = 0;
+	#endif
 
 	// If the serial port is being used, let the user know if the task was created
 	// successfully
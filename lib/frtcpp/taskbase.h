@@ -11,6 +11,9 @@
  *    \li 08-25-2012 JRR Modified to run with STM32's as well as AVR's
  *    \li 08-26-2014 JRR Changed file names and base task class name to TaskBase
  *    \li 09-03-2014 JRR Minor upgrades; renamed method to @c delay_from_for()
+ *    \li 10-17-2026 ME405 Group 3 Added loop execution times and CPU use to the task list
+ *    \li 10-17-2026 ME405 Group 3 Periodic delays count missed deadlines and wake up jitter
+ *    \li 10-17-2026 ME405 Group 3 A task's stack can be given to it instead of taken from the heap
  *
  *  Credits:
  *      Much of this code uses techniques learned from Amigo software, which is 
@@ -48,6 +51,8 @@
 
 #include "mechutil.h"                       // Utility functions for the ME405 code
 #include "emstream.h"                       // Pull in the base class header file
+#include "exectime.h"                       // Header for loop execution time statistics
+#include "periodtiming.h"                   // Header for deadline and jitter statistics
 
 
 /* The forward declaration is needed so we can make last_created_task_pointer usable
@@ -270,6 +275,27 @@ class TaskBase
 		 */
 		uint32_t runs;
 
+		/** This keeps the shortest, average and longest times taken by one pass
+		 *  through the task's loop. In order for it to work, the task must call
+		 *  @c exec_time.begin() when it wakes up and @c exec_time.end() before it
+		 *  waits again; the times are shown by @c print_task_list().
+		 */
+		ExecTime exec_time;
+
+		/** This keeps a count of missed deadlines and a histogram of how late the
+		 *  task woke up in each period. It's kept by @c delay_from_for() and
+		 *  @c delay_from_for_ms(), so tasks which use them needn't do anything.
+		 */
+		PeriodTiming period_timing;
+
+		#if (configGENERATE_RUN_TIME_STATS == 1)
+			/** This is the task's total run time, in microseconds, when the task list
+			 *  was last printed, so that the next list can show the share of the CPU
+			 *  used by the task since then.
+			 */
+			uint32_t previous_run_time;
+		#endif
+
 		/** This method allows descendent classes to find out how many times the
 		 *  @c loop() method has run.
 		 *  @return The number of times the loop has been run
@@ -283,11 +309,12 @@ class TaskBase
 	// pointer or reference to an object of this class
 	public:
 		// This constructor creates a FreeRTOS task with the given task run function, 
-		// name, priority, and stack size
+		// name, priority, and stack size, and optionally the memory for the stack
 		explicit TaskBase (const char* a_name, 
 						   unsigned portBASE_TYPE a_priority = 0, 
 						   size_t a_stack_size = configMINIMAL_STACK_SIZE,
-						   emstream* p_ser_dev = NULL);
+						   emstream* p_ser_dev = NULL,
+						   StackType_t* p_stack_buffer = NULL);
 
 		// Method called by the task's static run method which is, in turn,
 		// called by the FreeRTOS run function
@@ -397,7 +424,10 @@ class TaskBase
 		 *           implement a task that regularly wakes up and performs some 
 		 *           action, like a clown waking up to terrify children. Because the
 		 *           time at which each awakening takes place is recorded, this method
-		 *           won't accumulate errors as it is repeatedly invoked. 
+		 *           won't accumulate errors as it is repeatedly invoked. If the next
+		 *           period should already have begun when this method is called, a
+		 *           missed deadline is counted; when the task wakes, how late it woke
+		 *           is recorded in @c period_timing.
 		 *  @param   from_ticks The beginning time of the duration to delay. It is
 		 *                      usually set equal to the time at which the previous
 		 *                      delay began so as to get precise, regular timing
@@ -405,7 +435,9 @@ class TaskBase
 		 */
 		void delay_from_for (TickType_t& from_ticks, TickType_t for_how_long)
 		{
+			period_timing.check_deadline (from_ticks, for_how_long);
 			vTaskDelayUntil (&from_ticks, for_how_long);
+			period_timing.woke (from_ticks);
 		}
 
 		/** @brief   Stop the task from running for a precise number of milliseconds.
@@ -442,7 +474,7 @@ class TaskBase
         void delay_from_for_ms (TickType_t& from_ticks, TickType_t millisec)
         {
             TickType_t ticks = ((uint32_t)millisec * configTICK_RATE_HZ) / 1000UL;
-            vTaskDelayUntil (&from_ticks, ticks);
+            delay_from_for (from_ticks, ticks);
         }
 
 		/** @brief   Find out how many RTOS ticks since the scheduler was started.
@@ -585,6 +617,10 @@ class TaskBase
 		// list to do so
 		void print_status_in_list (emstream*);
 
+		// This method prints the task's wake up histogram, then asks the next task in
+		// the list to do so
+		void print_timing_in_list (emstream*);
+
 		/** @brief   Return a pointer to the most recently created task.
 		 *  @details This method returns a pointer to the most recently created task.
 		 *           This pointer is the head of a linked list of tasks; the list is 
@@ -628,6 +664,9 @@ emstream& operator << (emstream&, TaskBase&);
 // This function prints information about how all the tasks are doing
 void print_task_list (emstream* ser_dev);
 
+// This function prints the missed deadlines and wake up histograms of all the tasks
+void print_task_timing (emstream* ser_dev);
+
 // This function has all the tasks print their stacks
 void print_task_stacks (emstream* ser_dev);
 
@@ -8,6 +8,8 @@
  *    \li 12-02-2012 JRR Split off from time_stamp.cpp to save memory in machine file
  *    \li 08-26-2014 JRR Changed file names and base task class name to TaskBase
  *    \li 01-04-2015 JRR Moved items around for more efficient use of screen space
+ *    \li 10-17-2026 ME405 Group 3 Added CPU use and loop execution time columns
+ *    \li 10-17-2026 ME405 Group 3 Added missed deadlines and wake up histograms
  *
  *  License:
  *    This file is copyright 2012 by JR Ridgely and released under the Lesser GNU 
@@ -29,6 +31,76 @@
 #include "taskbase.h"                       // Pull in the base class header file
 
 
+#if (configGENERATE_RUN_TIME_STATS == 1)
+	/** This points to the states of all the tasks, which @c print_task_list() reads
+	 *  from FreeRTOS once so that each task can find its own run time in it. It's
+	 *  @c NULL except while the task list is being printed.
+	 */
+	static TaskStatus_t* p_task_states = NULL;
+
+	/// The number of task states in the array at @c p_task_states
+	static UBaseType_t num_task_states = 0;
+
+	/// One thousandth of the total run time since the task list was last printed
+	static uint32_t run_time_per_mille = 0;
+
+	/// The total run time, in microseconds, when the task list was last printed
+	static uint32_t previous_total_run_time = 0;
+
+	/// The idle task's run time when the task list was last printed
+	static uint32_t previous_idle_run_time = 0;
+
+
+	//---------------------------------------------------------------------------------
+	/** This function finds the total run time of a task in the task states which were
+	 *  read by @c print_task_list().
+	 *  @param a_handle The handle of the task whose run time is wanted
+	 *  @param p_run_time A pointer to a variable in which to put the run time
+	 *  @return True if the task's run time was found, false if not
+	 */
+
+	static bool find_run_time (TaskHandle_t a_handle, uint32_t* p_run_time)
+	{
+		for (UBaseType_t index = 0; index < num_task_states; index++)
+		{
+			if (p_task_states[index].xHandle == a_handle)
+			{
+				*p_run_time = p_task_states[index].ulRunTimeCounter;
+				return (true);
+			}
+		}
+		return (false);
+	}
+
+
+	//---------------------------------------------------------------------------------
+	/** This function prints a task's share of the CPU since the task list was last
+	 *  printed, as a percentage with one decimal place, and saves the task's run time
+	 *  for next time. If the run time isn't known, a dash is printed.
+	 *  @param ser_dev The serial device on which to print the share
+	 *  @param a_handle The handle of the task whose share is printed
+	 *  @param previous_time The task's run time when the task list was last printed,
+	 *                       which is updated here
+	 */
+
+	static void print_cpu_share (emstream& ser_dev, TaskHandle_t a_handle,
+								 uint32_t& previous_time)
+	{
+		uint32_t run_time;
+
+		if (!find_run_time (a_handle, &run_time) || run_time_per_mille == 0)
+		{
+			ser_dev << '-';
+			return;
+		}
+
+		uint16_t tenths = (run_time - previous_time) / run_time_per_mille;
+		previous_time = run_time;
+		ser_dev << (uint16_t)(tenths / 10) << '.' << (uint8_t)(tenths % 10) << '%';
+	}
+#endif // configGENERATE_RUN_TIME_STATS
+
+
 //-------------------------------------------------------------------------------------
 /** This method prints task status information, then asks the next task in the list of
  *  tasks to do so. The list is kept by the tasks, each having a pointer to another.
@@ -46,11 +118,36 @@ void TaskBase::print_status_in_list (emstream* ser_device)
 }
 
 
+//-------------------------------------------------------------------------------------
+/** This method prints the task's name and a histogram of how late it woke up for each
+ *  period, then asks the next task in the list of tasks to do so. Tasks which haven't
+ *  used @c delay_from_for() have nothing in their histograms.
+ *  @param ser_device The serial device to which each task prints its histogram
+ */
+
+void TaskBase::print_timing_in_list (emstream* ser_device)
+{
+	ser_device->puts (pcTaskGetTaskName (handle));
+	ser_device->putchar ('\t');
+	period_timing.print (*ser_device);
+	*ser_device << endl;
+
+	if (prev_task_pointer != NULL)
+	{
+		prev_task_pointer->print_timing_in_list (ser_device);
+	}
+}
+
+
 //-------------------------------------------------------------------------------------
 /** This method prints information about the task. It is called by the overloaded "<<"
  *  operator which is used by the task to print itself when asked to. This function is
  *  declared virtual so that descendents can override it to print additional 
- *  information. 
+ *  information. When the FreeRTOS run time statistics are enabled, the share of the 
+ *  CPU used by the task since the task list was last printed is shown; so are the 
+ *  shortest, average and longest times taken by a pass through the task's loop, if
+ *  the task times its loop with @c exec_time. The number of deadlines the task has
+ *  missed is shown after the number of runs.
  *  @param ser_dev A reference to the serial device to which to print the task status
  */
 
@@ -68,7 +165,15 @@ void TaskBase::print_status (emstream& ser_dev)
 			<< PMS ("\t") << uxTaskGetStackHighWaterMark(handle) << PMS ("/") 
 			<< (size_t)(get_total_stack ()) << PMS ("\t")
 		#endif
-			<< PMS ("\t") << runs;
+			<< PMS ("\t") << runs << PMS ("\t") << period_timing.get_misses ();
+
+	#if (configGENERATE_RUN_TIME_STATS == 1)
+		ser_dev << PMS ("\t");
+		print_cpu_share (ser_dev, handle, previous_run_time);
+	#endif
+
+	ser_dev << PMS ("\t");
+	exec_time.print (ser_dev);
 }
 
 
@@ -99,11 +204,31 @@ emstream& operator << (emstream& ser_dev, TaskBase& a_task)
  *  WARNING: The display of memory remaining in the task stacks, which is found by
  *  calls to FreeRTOS function uxTaskGetStackHighWaterMark(), seems to be suspicious.
  *  The author isn't sure if it can always be trusted. 
+ *  When the run time statistics are enabled, the states of all tasks are read from 
+ *  FreeRTOS into a temporary array first, so that each task can show its share of
+ *  the CPU since the previous list; the idle task's share is the CPU time left over.
  *  @param ser_dev Pointer to a serial device on which the information will be printed
  */
 
 void print_task_list (emstream* ser_dev)
 {
+	#if (configGENERATE_RUN_TIME_STATS == 1)
+		uint32_t total_run_time = 0;
+		num_task_states = uxTaskGetNumberOfTasks ();
+		p_task_states = new TaskStatus_t[num_task_states];
+		if (p_task_states != NULL)
+		{
+			num_task_states = uxTaskGetSystemState (p_task_states, num_task_states,
+													&total_run_time);
+		}
+		else
+		{
+			num_task_states = 0;
+		}
+		run_time_per_mille = (total_run_time - previous_total_run_time) / 1000;
+		previous_total_run_time = total_run_time;
+	#endif
+
 	// Print the first line with the top of the headings
 	*ser_dev << PMS ("Task\t\t  \t ")
 		#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
@@ -116,14 +241,22 @@ void print_task_list (emstream* ser_dev)
 		#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
 			<< PMS ("\tFree/Total")
 		#endif
-			<< PMS ("\tRuns") << endl;
+			<< PMS ("\tRuns\tLate")
+		#if (configGENERATE_RUN_TIME_STATS == 1)
+			<< PMS ("\tCPU")
+		#endif
+			<< PMS ("\tLoop us min/avg/max") << endl;
 
 	// Print the third line which shows separators between headers and data
 	*ser_dev << PMS ("----\t\t----\t-----")
 		#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
 			<< PMS ("\t----------")
 		#endif
-			<< PMS ("\t----") << endl;
+			<< PMS ("\t----\t----")
+		#if (configGENERATE_RUN_TIME_STATS == 1)
+			<< PMS ("\t---")
+		#endif
+			<< PMS ("\t-------------------") << endl;
 
 	// Now have the tasks each print out their status. Tasks form a linked list, so
 	// we only need to get the last task started and it will call the next, etc.
@@ -138,6 +271,35 @@ void print_task_list (emstream* ser_dev)
 			<< uxTaskGetStackHighWaterMark (xTaskGetIdleTaskHandle ())
 			<< PMS ("/") << configMINIMAL_STACK_SIZE << PMS ("\t\t-")
 		#endif
-			<< endl;
+			<< PMS ("\t-");
+	#if (configGENERATE_RUN_TIME_STATS == 1)
+		*ser_dev << PMS ("\t");
+		print_cpu_share (*ser_dev, xTaskGetIdleTaskHandle (), previous_idle_run_time);
+
+		delete [] p_task_states;
+		p_task_states = NULL;
+		num_task_states = 0;
+	#endif
+	*ser_dev << PMS ("\t-") << endl;
 }
 
+
+
+//-------------------------------------------------------------------------------------
+/** This function prints, for each task, a histogram of how many microseconds after
+ *  the start of each period the task actually began to run, the latest it has begun,
+ *  and the number of deadlines it has missed. A deadline is missed when a task's work
+ *  for one period isn't done by the time the next period should begin. 
+ *  @param ser_dev Pointer to a serial device on which the histograms will be printed
+ */
+
+void print_task_timing (emstream* ser_dev)
+{
+	*ser_dev << PMS ("Task\t\tWake up times after the start of each period (us)")
+			 << endl;
+
+	if (last_created_task_pointer != NULL)
+	{
+		last_created_task_pointer->print_timing_in_list (ser_dev);
+	}
+}
@@ -11,6 +11,10 @@
  *    \li 08-26-2014 JRR Changed file names, class name to @c TaskShare, removed unused
  *                       version that uses semaphores, renamed @c put() and @c get()
  *    \li 10-18-2014 JRR Added linked list of all shares for tracking and debugging
+ *    \li 10-17-2026 ME405 Group 3 One-byte shares are read and written without
+ *                       critical sections
+ *    \li 10-17-2026 ME405 Group 3 Const and volatile one-byte types are also
+ *                       written without critical sections
  *
  *  License:
  *		This file is copyright 2014 by JR Ridgely and released under the Lesser GNU 
@@ -37,6 +41,139 @@
 #include "baseshare.h"                      // Base class for shared data items
 
 
+//-------------------------------------------------------------------------------------
+/** @brief   Trait which tells whether a type can be read or written atomically.
+ *  @details A share holding a type for which @c value is @c true is read and written
+ *           with one plain (volatile) load or store instead of inside a critical 
+ *           section. On an 8-bit AVR this is true only of one-byte types, which are
+ *           moved by a single instruction that an interrupt can't split; anything 
+ *           wider is moved a byte at a time and must keep its critical section. The
+ *           one-byte integer types are marked below; other types can be marked by 
+ *           adding a specialization, but only if a single instruction moves them.
+ */
+
+template <class DataType> struct share_is_atomic
+{
+	static const bool value = false;        ///< Most types need a critical section
+};
+
+/// A @c char is moved by a single instruction, so it needs no critical section
+template <> struct share_is_atomic<char> { static const bool value = true; };
+
+/// A @c signed @c char (or @c int8_t ) needs no critical section
+template <> struct share_is_atomic<signed char> { static const bool value = true; };
+
+/// An @c unsigned @c char (or @c uint8_t ) needs no critical section
+template <> struct share_is_atomic<unsigned char> { static const bool value = true; };
+
+/// A @c bool needs no critical section
+template <> struct share_is_atomic<bool> { static const bool value = true; };
+
+
+/** @brief   Trait which gives a type without its @c const and @c volatile qualifiers.
+ *  @details @c share_is_atomic is marked for plain types only, so a share of a
+ *           @c volatile @c uint8_t is looked up as a share of a @c uint8_t. This does
+ *           what @c std::remove_cv does; the AVR compiler has no standard library.
+ */
+
+template <class DataType> struct share_remove_cv
+{
+	typedef DataType type;                  ///< A type with no qualifiers is kept
+};
+
+/// A @c const type is looked up without its @c const
+template <class DataType> struct share_remove_cv<const DataType>
+{
+	typedef DataType type;                  ///< The type without @c const
+};
+
+/// A @c volatile type is looked up without its @c volatile
+template <class DataType> struct share_remove_cv<volatile DataType>
+{
+	typedef DataType type;                  ///< The type without @c volatile
+};
+
+/// A @c const @c volatile type is looked up without either qualifier
+template <class DataType> struct share_remove_cv<const volatile DataType>
+{
+	typedef DataType type;                  ///< The type without @c const or @c volatile
+};
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Functions which copy data into and out of a share from a task.
+ *  @details This general version copies the data inside a critical section so that
+ *           no interrupt or task switch can come while it is partly copied. The 
+ *           version for types marked by @c share_is_atomic, below, is chosen by the
+ *           compiler instead when it applies, whatever the type's qualifiers. 
+ */
+
+template <class DataType,
+		  bool ATOMIC = share_is_atomic<typename share_remove_cv<DataType>::type>::value>
+struct share_access
+{
+	/** @brief   Copy new data into a share's data item.
+	 *  @param   the_data A reference to the share's data item
+	 *  @param   new_data The data which is to be written
+	 */
+	static void store (DataType& the_data, DataType new_data)
+	{
+		portENTER_CRITICAL ();
+		the_data = new_data;
+		portEXIT_CRITICAL ();
+	}
+
+	/** @brief   Copy the data out of a share's data item.
+	 *  @details It's necessary to make an extra, temporary copy of the data so that 
+	 *           the temporary copy can be returned. We can't call return() from 
+	 *           within the critical section for reasons that are obvious if you think
+	 *           about it.
+	 *  @param   the_data A reference to the share's data item
+	 *  @return  A copy of the data
+	 */
+	static DataType load (DataType& the_data)
+	{
+		DataType temporary_copy;
+
+		portENTER_CRITICAL ();
+		temporary_copy = the_data;
+		portEXIT_CRITICAL ();
+
+		return (temporary_copy);
+	}
+};
+
+
+/** @brief   Functions which copy data into and out of a share without a critical 
+ *           section, for types which are moved by a single instruction.
+ *  @details The accesses are made through a @c volatile pointer so that the compiler
+ *           does exactly one load or store each time and can't keep a copy of the 
+ *           data in a register between calls. 
+ */
+
+template <class DataType>
+struct share_access<DataType, true>
+{
+	/** @brief   Write new data into a share's data item with one store.
+	 *  @param   the_data A reference to the share's data item
+	 *  @param   new_data The data which is to be written
+	 */
+	static void store (DataType& the_data, DataType new_data)
+	{
+		*(volatile DataType*)&the_data = new_data;
+	}
+
+	/** @brief   Read a share's data item with one load.
+	 *  @param   the_data A reference to the share's data item
+	 *  @return  A copy of the data
+	 */
+	static DataType load (DataType& the_data)
+	{
+		return (*(volatile DataType*)&the_data);
+	}
+};
+
+
 //-------------------------------------------------------------------------------------
 /** @brief   Class for data to be shared in a thread-safe manner between tasks.
  *  @details This class implements an item of data which can be shared between tasks
@@ -49,12 +186,19 @@
  *           The data is protected by using critical code sections (see the FreeRTOS 
  *           documentation of @c portENTER_CRITICAL() ) so that tasks can't interrupt 
  *           each other when reading or writing the data is taking place. This prevents
- *           data corruption due to thread switching. The C++ template mechanism is 
- *           used to ensure that only data of the correct type is put into or taken 
- *           from a shared data item. A @c TaskShare<DataType> object keeps its own 
- *           separate copy of the data. This uses some memory, but it is necessary to 
- *           reliably prevent data corruption; it prevents possible side effects from 
- *           causing the sender's copy of the data from being inadvertently changed. 
+ *           data corruption due to thread switching. Types for which the trait 
+ *           @c share_is_atomic is @c true, such as @c uint8_t and @c int8_t flags,
+ *           can't be half written when an interrupt comes, so they are read and 
+ *           written with a plain volatile access instead; @c share_access is 
+ *           specialized for them at compile time, so no test is done while the 
+ *           program runs. Increments and decrements always use a critical 
+ *           section, as even for one byte they take a separate load and store. 
+ *           The C++ template mechanism is used to ensure that only data of the 
+ *           correct type is put into or taken from a shared data item. A 
+ *           @c TaskShare<DataType> object keeps its own separate copy of the data. 
+ *           This uses some memory, but it is necessary to reliably prevent data 
+ *           corruption; it prevents possible side effects from causing the sender's 
+ *           copy of the data from being inadvertently changed. 
  * 
  *           TODO: Provide a usage example. For now, see examples of usage in example
  *                 code. 
@@ -157,16 +301,16 @@ template <class DataType> class TaskShare : public BaseShare
  *           function. This is faster than doing a regular function call, which
  *           involves pushing the program counter on the stack, pushing parameters, 
  *           jumping, making space for local variables, jumping back and popping the 
- *           program counter, yawn, zzz...
+ *           program counter, yawn, zzz... Types which can be written by a single
+ *           instruction (see @c share_is_atomic ) are written without a critical
+ *           section. 
  *  @param   new_data The data which is to be written
  */
 
 template <class DataType>
 inline void TaskShare<DataType>::put (DataType new_data)
 {
-	portENTER_CRITICAL ();
-	the_data = new_data;
-	portEXIT_CRITICAL ();
+	share_access<DataType>::store (the_data, new_data);
 }
 
 
@@ -191,23 +335,15 @@ void TaskShare<DataType>::ISR_put (DataType new_data)
 /** @brief   Read data from the shared data item.
  *  @details This method is used to read data from the shared data item with critical
  *           section protection to ensure that the data cannot be corrupted by a task
- *           switch. 
+ *           switch. Types which can be read by a single instruction (see 
+ *           @c share_is_atomic ) are read without a critical section. 
  *  @return  The current value of the shared data item
  */
 
 template <class DataType>
 DataType TaskShare<DataType>::get (void)
 {
-	// It's necessary to make an extra, temporary copy of the data so that the
-	// temporary copy can be returned. We can't call return() from within the
-	// critical section for reasons that are obvious if you think about it
-	DataType temporary_copy;
-
-	portENTER_CRITICAL ();
-	temporary_copy = the_data;
-	portEXIT_CRITICAL ();
-
-	return (temporary_copy);
+	return (share_access<DataType>::load (the_data));
 }
 
 
@@ -0,0 +1,221 @@
+//*************************************************************************************
+/** @file    telemetry.cpp
+ *  @brief   Source code for a task which sends the values of task shares as compact
+ *           binary records through a second serial port.
+ *  @details This file contains the methods of class @c Telemetry; see
+ *           @c telemetry.h for the format of the records and how they're framed.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *    \li 10-17-2026 ME405 Group 3 Sends entries from the log queue of @c logid.h
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+#include "telemetry.h"                      // Pull in the header for this class
+
+
+/** @brief   The longest record, including its CRC, which is built on the stack.
+ *  @details It must be less than 254 bytes, so that a COBS frame needs no more than
+ *           one code byte for each zero in the record.
+ */
+const uint8_t TELEMETRY_MAX_RECORD = 64;
+
+/// The number of bytes before the values in a data record
+const uint8_t TELEMETRY_DATA_HEADER = 6;
+
+/// The number of bytes before the name in a name record
+const uint8_t TELEMETRY_NAME_HEADER = 4;
+
+/// The number of bytes before the values in a log record
+const uint8_t TELEMETRY_LOG_HEADER = 6;
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Create a telemetry task with no channels yet.
+ *  @param   a_name A character string which will be the name of this task
+ *  @param   a_priority The priority at which this task will run; it's usually below
+ *                      that of the tasks whose data it sends
+ *  @param   a_stack_size The size of this task's stack in bytes
+ *  @param   p_ser_dev Pointer to a serial device on which error messages are printed,
+ *                     or @c NULL
+ *  @param   p_telemetry_dev Pointer to the serial device through which the records
+ *                           are sent
+ *  @param   a_period_ms The time from one data record to the next, in milliseconds
+ *  @param   p_stack_buffer Memory for the task's stack, or NULL to take the stack
+ *                          from the heap (default: NULL)
+ */
+
+Telemetry::Telemetry (const char* a_name, unsigned portBASE_TYPE a_priority,
+					  size_t a_stack_size, emstream* p_ser_dev,
+					  emstream* p_telemetry_dev, uint16_t a_period_ms,
+					  StackType_t* p_stack_buffer)
+	: TaskBase (a_name, a_priority, a_stack_size, p_ser_dev, p_stack_buffer),
+	  num_channels (0), data_size (TELEMETRY_DATA_HEADER),
+	  p_telemetry (p_telemetry_dev), period (configMS_TO_TICKS (a_period_ms)),
+	  sequence (0)
+{
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Add a channel to the end of the list.
+ *  @details This is called by @c add(), which knows the share's type.
+ *  @param   p_share The share whose value is sent
+ *  @param   a_name The name of the channel
+ *  @param   p_sample The function which reads the share into a record
+ *  @param   a_type The type code of the share's value
+ *  @param   a_size The number of bytes in the share's value
+ *  @return  @c true if the channel was added, or @c false if the list or the record
+ *           was full
+ */
+
+bool Telemetry::add_channel (void* p_share, const char* a_name,
+							 uint8_t (*p_sample) (void*, uint8_t*), char a_type,
+							 uint8_t a_size)
+{
+	if (num_channels >= TELEMETRY_MAX_CHANNELS
+		|| data_size + a_size + 2 > TELEMETRY_MAX_RECORD)
+	{
+		if (p_serial != NULL)
+		{
+			*p_serial << PMS ("ERROR adding telemetry channel \"") << a_name << '"'
+					  << endl;
+		}
+		return (false);
+	}
+
+	channels[num_channels].p_share = p_share;
+	channels[num_channels].name = a_name;
+	channels[num_channels].sample = p_sample;
+	channels[num_channels].type = a_type;
+	num_channels++;
+	data_size += a_size;
+
+	return (true);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Send one record with its CRC, in a COBS frame followed by a zero.
+ *  @details Each zero in the record is left out, and the bytes up to it are sent
+ *           after a code byte which is one more than their number; the end of the
+ *           record counts as a zero, so a decoder drops the last one it finds. The
+ *           record is never long enough to need the code 0xFF, which would mean 254
+ *           bytes with no zero after them.
+ *  @param   p_record The record, with room for two more bytes after it for the CRC
+ *  @param   length The number of bytes in the record, not counting the CRC
+ */
+
+void Telemetry::send_record (uint8_t* p_record, uint8_t length)
+{
+	uint16_t crc = 0xFFFF;
+	for (uint8_t index = 0; index < length; index++)
+	{
+		crc = crc16 (crc, p_record[index]);
+	}
+	p_record[length++] = (uint8_t)crc;
+	p_record[length++] = (uint8_t)(crc >> 8);
+
+	uint8_t start = 0;
+	while (start <= length)
+	{
+		uint8_t end = start;
+		while (end < length && p_record[end] != 0)
+		{
+			end++;
+		}
+		p_telemetry->putchar (end - start + 1);
+		for (uint8_t index = start; index < end; index++)
+		{
+			p_telemetry->putchar (p_record[index]);
+		}
+		start = end + 1;
+	}
+	p_telemetry->putchar (0);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Send a data record each period, and now and then the name of a channel or
+ *           an entry from the log queue.
+ *  @details No more than one name or log record is sent with each data record, so the
+ *           records sent each period fit in the port's transmit buffer; log entries
+ *           which come faster than that wait in the log queue, or are lost if it fills.
+ */
+
+void Telemetry::run (void)
+{
+	uint8_t record[TELEMETRY_MAX_RECORD];	// The record being built
+	uint8_t name_countdown = 0;				// Data records until the next name
+	uint8_t name_channel = 0;				// The channel whose name is sent next
+	time_stamp now;							// Time at which the shares are read
+
+	TickType_t previous_ticks = xTaskGetTickCount ();
+
+	for (;;)
+	{
+		exec_time.begin ();
+
+		// The data record: its sequence number, the time and the value of each share
+		uint32_t time_us = now.set_to_now ().to_run_time_us ();
+		record[0] = TELEMETRY_DATA;
+		record[1] = sequence++;
+		memcpy (record + 2, &time_us, sizeof (time_us));
+		uint8_t length = TELEMETRY_DATA_HEADER;
+		for (uint8_t index = 0; index < num_channels; index++)
+		{
+			length += channels[index].sample (channels[index].p_share, record + length);
+		}
+		send_record (record, length);
+
+		// Now and then, the name and type of the next channel in turn
+		if (name_countdown == 0 && num_channels > 0)
+		{
+			record[0] = TELEMETRY_NAME;
+			record[1] = name_channel;
+			record[2] = num_channels;
+			record[3] = channels[name_channel].type;
+			length = strlen (channels[name_channel].name);
+			if (length > TELEMETRY_MAX_RECORD - TELEMETRY_NAME_HEADER - 2)
+			{
+				length = TELEMETRY_MAX_RECORD - TELEMETRY_NAME_HEADER - 2;
+			}
+			memcpy (record + TELEMETRY_NAME_HEADER, channels[name_channel].name, length);
+			send_record (record, TELEMETRY_NAME_HEADER + length);
+
+			name_countdown = TELEMETRY_NAME_EVERY;
+			if (++name_channel >= num_channels)
+			{
+				name_channel = 0;
+			}
+		}
+		else if (p_log_queue != NULL && p_log_queue->not_empty ())
+		{
+			log_entry_t entry = p_log_queue->get ();
+			record[0] = TELEMETRY_LOG;
+			record[1] = entry.id;
+			memcpy (record + 2, &entry.time_us, sizeof (entry.time_us));
+			memcpy (record + TELEMETRY_LOG_HEADER, entry.args, entry.length);
+			send_record (record, TELEMETRY_LOG_HEADER + entry.length);
+		}
+		name_countdown--;
+
+		exec_time.end ();
+		runs++;
+		delay_from_for (previous_ticks, period);
+	}
+}
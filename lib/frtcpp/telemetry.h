@@ -0,0 +1,252 @@
+//*************************************************************************************
+/** @file    telemetry.h
+ *  @brief   Headers for a task which sends the values of task shares as compact
+ *           binary records through a second serial port.
+ *  @details This file contains a task class which samples a list of task shares at a
+ *           fixed rate and sends each sample as one record, framed with Consistent
+ *           Overhead Byte Stuffing (COBS) and checked with a CRC-16. The records take
+ *           a fraction of the time that printing the same numbers as text would, and
+ *           the PC program @c telem2csv turns them into a CSV file.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *    \li 10-17-2026 ME405 Group 3 Sends entries from the log queue of @c logid.h
+ *    \li 10-17-2026 ME405 Group 3 Added @c add() for a @c NotifyShare
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <string.h>                         // For memcpy()
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS tasks
+#include "taskbase.h"                       // Header for the ME405 base task class
+#include "taskshare.h"                      // Header for thread-safe shared data
+#include "emstream.h"                       // Header for serial ports and devices
+#include "logid.h"                          // Header for log messages sent as numbers
+
+// A NotifyShare can't be passed as a TaskShare, so it has its own add()
+template <class DataType> class NotifyShare;
+
+
+/** @brief   The largest number of shares which one telemetry task can send.
+ *  @details The list of shares is kept inside the task object, so each entry costs a
+ *           few bytes of RAM whether it's used or not.
+ */
+#ifndef TELEMETRY_MAX_CHANNELS
+	#define TELEMETRY_MAX_CHANNELS	12
+#endif
+
+/** @brief   One channel's name is sent after this many data records.
+ *  @details The names go round one at a time, so that a decoder started at any time
+ *           soon learns all of them, without a burst of names filling the port's
+ *           transmit buffer.
+ */
+#ifndef TELEMETRY_NAME_EVERY
+	#define TELEMETRY_NAME_EVERY	10
+#endif
+
+/// The first byte of a record which holds one sample of every channel
+#define TELEMETRY_DATA			'D'
+
+/// The first byte of a record which holds the name and type of one channel
+#define TELEMETRY_NAME			'N'
+
+/// The first byte of a record which holds one entry from the log queue
+#define TELEMETRY_LOG			'L'
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Trait which gives the one letter code by which the decoder knows each type
+ *           of share value.
+ *  @details The letters are those of Python's @c struct module. Only the integer
+ *           types have codes, so adding a share of any other type to a telemetry task
+ *           is caught by the compiler.
+ */
+
+template <class DataType> struct telemetry_type;
+
+/// Code for a signed 8-bit value
+template <> struct telemetry_type<int8_t> { static const char code = 'b'; };
+
+/// Code for an unsigned 8-bit value
+template <> struct telemetry_type<uint8_t> { static const char code = 'B'; };
+
+/// Code for a signed 16-bit value
+template <> struct telemetry_type<int16_t> { static const char code = 'h'; };
+
+/// Code for an unsigned 16-bit value
+template <> struct telemetry_type<uint16_t> { static const char code = 'H'; };
+
+/// Code for a signed 32-bit value
+template <> struct telemetry_type<int32_t> { static const char code = 'i'; };
+
+/// Code for an unsigned 32-bit value
+template <> struct telemetry_type<uint32_t> { static const char code = 'I'; };
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Task class which sends samples of task shares through a serial port as
+ *           binary records.
+ *  @details Shares are added, each with a name, before the scheduler is started. Once
+ *           each period the task reads every share and sends a data record holding a
+ *           sequence number, the time in microseconds and the values, each in the
+ *           processor's own little-endian byte order:
+ *           @code
+ *           'D'  sequence  time_us (4 bytes)  value 0  value 1 ...  CRC (2 bytes)
+ *           @endcode
+ *           Every @c TELEMETRY_NAME_EVERY periods it also sends the name of the next
+ *           channel in turn, so a decoder can tell what the values are:
+ *           @code
+ *           'N'  channel  number of channels  type code  name...  CRC (2 bytes)
+ *           @endcode
+ *           In a period in which no name is sent, one entry from the log queue of
+ *           @c logid.h is sent, if there is one, with the values as they were logged:
+ *           @code
+ *           'L'  message  time_us (4 bytes)  type code  value  type code ...  CRC
+ *           @endcode
+ *           The CRC is CRC-16/CCITT-FALSE of the rest of the record, low byte first.
+ *           Each record is then sent with COBS, which takes the zeros out of it at a
+ *           cost of one byte per record, followed by a zero which marks its end. A
+ *           decoder can therefore start listening at any time, and a record with a
+ *           character lost is caught by its CRC and skipped rather than upsetting
+ *           those which follow. This suits a port whose transmit buffer drops
+ *           characters when it's full, so that the telemetry never holds up the task.
+ *           Example:
+ *           @code
+ *           rs232* p_telem_port = new rs232 (57600, 1);
+ *           p_telem_port->set_tx_full_policy (RSINT_TX_DROP);
+ *           Telemetry* p_telem = new Telemetry ("Telemetry", task_priority (1), 200,
+ *                                               p_ser_port, p_telem_port, 10);
+ *           p_telem->add (sh_encoder_position_1, "position_1");
+ *           p_telem->add (sh_servo_setpoint, "servo");
+ *           @endcode
+ */
+
+class Telemetry : public TaskBase
+{
+	protected:
+		/// An entry in the list of channels
+		struct channel_t
+		{
+			void* p_share;					///< The share, whose type sample knows
+			const char* name;				///< The name which the decoder shows
+			uint8_t (*sample) (void* p_share, uint8_t* p_dest);	///< Reads the share
+			char type;						///< The type code from telemetry_type
+		};
+
+		/// The list of channels, in the order in which their values are sent
+		channel_t channels[TELEMETRY_MAX_CHANNELS];
+
+		/// The number of channels in the list
+		uint8_t num_channels;
+
+		/// The number of bytes in a data record, not counting the CRC
+		uint8_t data_size;
+
+		/// The serial device through which the records are sent
+		emstream* p_telemetry;
+
+		/// The time from one data record to the next, in RTOS ticks
+		TickType_t period;
+
+		/// The sequence number of the next data record, which lets gaps be seen
+		uint8_t sequence;
+
+		/** @brief   Read a share of one type and copy its value into a record.
+		 *  @param   p_share A pointer to the share, which must be a @c ShareType
+		 *  @param   p_dest The place in the record where the value goes
+		 *  @return  The number of bytes copied
+		 */
+		template <class DataType, class ShareType = TaskShare<DataType> >
+		static uint8_t sample_share (void* p_share, uint8_t* p_dest)
+		{
+			DataType value = ((ShareType*)p_share)->get ();
+			memcpy (p_dest, &value, sizeof (DataType));
+			return (sizeof (DataType));
+		}
+
+		// Add a channel to the list, once its type is known
+		bool add_channel (void* p_share, const char* a_name,
+						  uint8_t (*p_sample) (void*, uint8_t*), char a_type,
+						  uint8_t a_size);
+
+		// Send one record, with its CRC, in a COBS frame
+		void send_record (uint8_t* p_record, uint8_t length);
+
+	public:
+		// This constructor creates a telemetry task with no channels yet
+		Telemetry (const char* a_name, unsigned portBASE_TYPE a_priority,
+				   size_t a_stack_size, emstream* p_ser_dev,
+				   emstream* p_telemetry_dev, uint16_t a_period_ms,
+				   StackType_t* p_stack_buffer = NULL);
+
+		/** @brief   Add a share to the end of the list of channels.
+		 *  @details This method must be called before the scheduler is started. The
+		 *           share must hold an integer of 8, 16 or 32 bits.
+		 *  @param   p_share The share whose value is sent
+		 *  @param   a_name The name of the channel, which is sent to the decoder; it's
+		 *                  given here because share names are cut to 12 characters
+		 *  @return  @c true if the channel was added, or @c false if the list or the
+		 *           record was full
+		 */
+		template <class DataType> bool add (TaskShare<DataType>* p_share,
+											const char* a_name)
+		{
+			return (add_channel (p_share, a_name, &sample_share<DataType>,
+								 telemetry_type<DataType>::code, sizeof (DataType)));
+		}
+
+		/** @brief   Add a share which sets event bits when written to the end of the
+		 *           list of channels.
+		 *  @details This is the same as @c add() for a @c TaskShare; the share is only
+		 *           read, so no event bits are set.
+		 *  @param   p_share The share whose value is sent
+		 *  @param   a_name The name of the channel, which is sent to the decoder
+		 *  @return  @c true if the channel was added, or @c false if the list or the
+		 *           record was full
+		 */
+		template <class DataType> bool add (NotifyShare<DataType>* p_share,
+											const char* a_name)
+		{
+			return (add_channel (p_share, a_name,
+								 &sample_share<DataType, NotifyShare<DataType> >,
+								 telemetry_type<DataType>::code, sizeof (DataType)));
+		}
+
+		// This method is called by the RTOS to send records indefinitely
+		void run (void);
+
+		/** @brief   Work out the CRC-16/CCITT-FALSE of some bytes, one byte at a time.
+		 *  @param   crc The CRC so far, which is 0xFFFF before the first byte
+		 *  @param   data The next byte
+		 *  @return  The CRC including the new byte
+		 */
+		static uint16_t crc16 (uint16_t crc, uint8_t data)
+		{
+			crc ^= (uint16_t)data << 8;
+			for (uint8_t bit = 0; bit < 8; bit++)
+			{
+				crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+			}
+			return (crc);
+		}
+}; // class Telemetry
+
+#endif  // _TELEMETRY_H_
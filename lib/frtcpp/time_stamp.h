@@ -21,6 +21,8 @@
  *    \li 10-10-2012 JRR Made time_stamp::set_to_now() return a reference to the stamp
  *    \li 12-02-2012 JRR Split many methods and operators into their own \c .cpp files
  *                       in order to save memory in the compiled machine code
+ *    \li 10-17-2026 ME405 Group 3 Added get_hardware_count()
+ *    \li 10-17-2026 ME405 Group 3 Added to_run_time_us() for the run time statistics
  *
  *  License:
  *    This file is copyright 2012 by JR Ridgely and released under the Lesser GNU 
@@ -113,6 +115,15 @@ class time_stamp
 			return tick_count;
 		}
 
+		/** This method returns the hardware timer count in the time stamp, which is
+		 *  the fraction of an RTOS tick in units of 1 / HW_TICK_RATE_HZ seconds.
+		 *  @return The hardware timer count, from 0 to TMR_MAX_CT - 1
+		 */
+		HW_CTR_TYPE get_hardware_count (void)
+		{
+			return hardware_count;
+		}
+
 		/** This method returns the number of seconds in the time stamp. It is assumed
 		 *  that the hardware counter is ticking at an integer number of ticks per 
 		 *  second so that the hardware timer count does not need to be used in 
@@ -130,6 +141,9 @@ class time_stamp
 		// This method returns the time in the time stamp as a float
 		float to_float (void);
 
+		// This method returns the whole time in microseconds, wrapping around at 2^32
+		uint32_t to_run_time_us (void);
+
 		// This function gets the time from the RTOS scheduler into this time stamp
 		time_stamp& set_to_now (void);
 
@@ -0,0 +1,66 @@
+//**************************************************************************************
+/** \file time_stamp_run_time.cpp
+ *    This file contains a method belonging to class \c time_stamp which returns the 
+ *    whole time in the time stamp in microseconds, and the function through which the
+ *    FreeRTOS run time statistics read the time.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *    This file is released under the Lesser GNU Public License, version 2, as is the
+ *    rest of this library. It is intended for educational use only, but its use is
+ *    not limited thereto. */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *    TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+ *    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ *    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ *    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ *    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//**************************************************************************************
+
+#include "FreeRTOS.h"                       // Main header for FreeRTOS 
+#include "task.h"                           // The FreeRTOS task functions header
+#include "time_stamp.h"                     // Header for this file
+
+
+//-------------------------------------------------------------------------------------
+/** This method returns the whole time in the time stamp in microseconds. Unlike 
+ *  \c get_microsec(), the seconds are not taken out, so the count wraps around about 
+ *  every 71 minutes; it's meant for finding the time between two nearby stamps with 
+ *  one subtraction. The hardware count is scaled with a constant shift or multiply
+ *  rather than a division at run time.
+ *  @return The time in the time stamp, in microseconds modulo 2^32
+ */
+
+uint32_t time_stamp::to_run_time_us (void)
+{
+	uint32_t fraction = (HW_TICK_RATE_HZ >= 1000000UL)
+		? (uint32_t)hardware_count / (HW_TICK_RATE_HZ / 1000000UL)
+		: (uint32_t)hardware_count * (1000000UL / HW_TICK_RATE_HZ);
+
+	return ((uint32_t)tick_count * (1000000UL / configTICK_RATE_HZ) + fraction);
+}
+
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+//-------------------------------------------------------------------------------------
+/** This function returns the time in microseconds to the FreeRTOS run time statistics
+ *  code, through the macro \c portGET_RUN_TIME_COUNTER_VALUE() in 
+ *  \c FreeRTOSConfig.h. FreeRTOS calls it at each task switch, with interrupts off, so
+ *  the interrupt version of \c set_to_now() is used.
+ *  @return The time since the scheduler started, in microseconds modulo 2^32
+ */
+
+extern "C" uint32_t func_get_run_time_counter (void)
+{
+	time_stamp now;
+	now.set_to_now_in_ISR ();
+
+	return (now.to_run_time_us ());
+}
+#endif
@@ -0,0 +1,173 @@
+//*************************************************************************************
+/** @file    tracebuf.cpp
+ *  @brief   Source code for a RAM buffer which records task switches, interrupts and
+ *           queue traffic with microsecond time stamps.
+ *  @details The records are written by the FreeRTOS trace macros which are defined in
+ *           @c FreeRTOSConfig.h when @c configUSE_TRACE_BUFFER is 1, and by the
+ *           @c traceISR_ENTER() and @c traceISR_EXIT() macros in interrupt service
+ *           routines. @c trace_buffer_dump() prints them as text which the host program
+ *           @c trace2json turns into a timeline for Chrome's or Perfetto's trace viewer.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "task.h"                           // Header for FreeRTOS tasks
+#include "time_stamp.h"                     // Header for high resolution time stamps
+#include "emstream.h"                       // Header for serial ports and devices
+#include "tracebuf.h"                       // Header for this file
+
+
+// Nothing here is compiled unless the trace buffer is turned on in FreeRTOSConfig.h
+#if (configUSE_TRACE_BUFFER == 1)
+
+
+/// The records, in a ring; the oldest is overwritten when the buffer is full
+static trace_record_t trace_records[TRACE_BUFFER_RECORDS];
+
+/// The index in @c trace_records at which the next record will be put
+static uint8_t trace_next = 0;
+
+/// The number of records in the buffer
+static uint8_t trace_count = 0;
+
+/// The number of records which were overwritten before they could be printed
+static uint16_t trace_lost = 0;
+
+/// The number of the most recently created queue
+static uint8_t trace_queues = 0;
+
+/// While this is true, as it is while the buffer is being printed, nothing is recorded
+static volatile bool trace_frozen = false;
+
+
+//-------------------------------------------------------------------------------------
+/** This function puts a record with the current time into the trace buffer. It's
+ *  called from inside the FreeRTOS kernel and from interrupt service routines, always
+ *  with interrupts disabled, so it doesn't need to protect the buffer itself.
+ *  @param type What happened, such as @c TRACE_TASK_IN
+ *  @param id The number of the task, queue or interrupt service routine
+ */
+
+void trace_buffer_put (uint8_t type, uint8_t id)
+{
+	if (trace_frozen)
+	{
+		return;
+	}
+
+	time_stamp now;
+	now.set_to_now_in_ISR ();
+
+	trace_record_t& record = trace_records[trace_next];
+	record.time_us = now.to_run_time_us ();
+	record.type = type;
+	record.id = id;
+
+	if (++trace_next >= TRACE_BUFFER_RECORDS)
+	{
+		trace_next = 0;
+	}
+	if (trace_count < TRACE_BUFFER_RECORDS)
+	{
+		trace_count++;
+	}
+	else if (trace_lost < UINT16_MAX)
+	{
+		trace_lost++;
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** This function gives each queue, semaphore and mutex a number as it's created, so
+ *  that the records of different queues can be told apart. The numbers begin at 1 and
+ *  go in the order in which the queues are created.
+ *  @return The number for the new queue
+ */
+
+uint8_t trace_buffer_queue_number (void)
+{
+	return (++trace_queues);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** This function prints the contents of the trace buffer, oldest record first, and
+ *  then empties the buffer. Nothing is recorded while the buffer is printed, so the
+ *  printing itself doesn't show up in the trace. The printout looks like this:
+ *  @code
+ *  TRACE BEGIN 64 12
+ *  TASK 1 Cyclic
+ *  TASK 5 IDLE
+ *  1203311 1 1
+ *  1203340 5 3
+ *  ...
+ *  TRACE END
+ *  @endcode
+ *  The first line gives the number of records and the number of older records which
+ *  were lost. Each task's number and name follow; then each record is shown as its
+ *  time in microseconds, its type and its ID. 
+ *  @param p_ser_dev Pointer to a serial device on which to print the records
+ */
+
+void trace_buffer_dump (emstream* p_ser_dev)
+{
+	portENTER_CRITICAL ();
+	trace_frozen = true;
+	portEXIT_CRITICAL ();
+
+	*p_ser_dev << PMS ("TRACE BEGIN ") << trace_count << ' ' << trace_lost << endl;
+
+	// Print the number and name of each task, so the records can be given names
+	UBaseType_t num_tasks = uxTaskGetNumberOfTasks ();
+	TaskStatus_t* p_states = new TaskStatus_t[num_tasks];
+	if (p_states != NULL)
+	{
+		num_tasks = uxTaskGetSystemState (p_states, num_tasks, NULL);
+		for (UBaseType_t index = 0; index < num_tasks; index++)
+		{
+			*p_ser_dev << PMS ("TASK ") << p_states[index].xTaskNumber << ' '
+					   << p_states[index].pcTaskName << endl;
+		}
+		delete [] p_states;
+	}
+
+	// Print the records, beginning with the oldest
+	uint8_t index = (trace_count < TRACE_BUFFER_RECORDS) ? 0 : trace_next;
+	for (uint8_t count = 0; count < trace_count; count++)
+	{
+		trace_record_t& record = trace_records[index];
+		*p_ser_dev << record.time_us << ' ' << record.type << ' ' << record.id << endl;
+		if (++index >= TRACE_BUFFER_RECORDS)
+		{
+			index = 0;
+		}
+	}
+	*p_ser_dev << PMS ("TRACE END") << endl;
+
+	portENTER_CRITICAL ();
+	trace_next = 0;
+	trace_count = 0;
+	trace_lost = 0;
+	trace_frozen = false;
+	portEXIT_CRITICAL ();
+}
+
+#endif // configUSE_TRACE_BUFFER
@@ -0,0 +1,96 @@
+//*************************************************************************************
+/** @file    tracebuf.h
+ *  @brief   Headers for a RAM buffer which records task switches, interrupts and queue
+ *           traffic with microsecond time stamps.
+ *  @details This file is included by @c FreeRTOSConfig.h when @c configUSE_TRACE_BUFFER
+ *           is 1, so that the FreeRTOS trace macros can put records into the buffer;
+ *           since the FreeRTOS kernel is written in C, everything here but the dump
+ *           function can be used from C. The buffer is printed on request, so tracing
+ *           costs only a few microseconds per record and no serial port time until
+ *           then.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _TRACEBUF_H_
+#define _TRACEBUF_H_
+
+#include <stdint.h>                         // Standard integer types
+
+
+/** @brief   The number of records kept in the trace buffer.
+ *  @details Each record takes 6 bytes of RAM. When the buffer is full, each new record
+ *           replaces the oldest, so the buffer always holds the most recent events.
+ *           It can't be more than 255.
+ */
+#ifndef TRACE_BUFFER_RECORDS
+	#define TRACE_BUFFER_RECORDS	64
+#endif
+
+/// A task has begun to run; the ID is its FreeRTOS task number
+#define TRACE_TASK_IN			1
+/// A task has stopped running; the ID is its FreeRTOS task number
+#define TRACE_TASK_OUT			2
+/// An interrupt service routine has begun; the ID is chosen by whoever wrote it
+#define TRACE_ISR_ENTER			3
+/// An interrupt service routine has finished
+#define TRACE_ISR_EXIT			4
+/// An item was put into a queue; the ID is the queue's number, in order of creation
+#define TRACE_QUEUE_SEND		5
+/// An item was taken from a queue
+#define TRACE_QUEUE_RECEIVE		6
+
+
+/** @brief   One record in the trace buffer.
+ *  @details The time is the same microsecond count which the FreeRTOS run time
+ *           statistics use, so it wraps around about every 71 minutes.
+ */
+typedef struct
+{
+	uint32_t time_us;						///< Time of the event in microseconds
+	uint8_t type;							///< What happened, such as @c TRACE_TASK_IN
+	uint8_t id;								///< Which task, queue or interrupt it was
+} trace_record_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Put a record into the trace buffer; interrupts must be disabled
+void trace_buffer_put (uint8_t type, uint8_t id);
+
+// Get a number for a new queue, so that its records can be told apart
+uint8_t trace_buffer_queue_number (void);
+
+#ifdef __cplusplus
+}
+
+// The dump function is C++ even when this file is included inside an extern "C" block
+extern "C++"
+{
+	class emstream;
+
+	// Print the records in the buffer, oldest first, then empty it
+	void trace_buffer_dump (emstream* p_ser_dev);
+}
+#endif
+
+#endif  // _TRACEBUF_H_
@@ -0,0 +1,255 @@
+//*************************************************************************************
+/** @file    triplebuffer.h
+ *  @brief   A share for large records which are passed from one writer to one
+ *           reader without copying them inside critical sections.
+ *  @details This file contains a template class which keeps three copies of a
+ *           record. The writer fills one of them while the reader uses another, and
+ *           the third holds the newest complete record. Only the one-byte indices of
+ *           the copies are changed with interrupts off, so the time for which
+ *           interrupts are held off doesn't depend on the size of the record.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *		This file is released under the Lesser GNU Public License, version 2, as
+ *		is the rest of this library. It is intended for educational use only, but
+ *		its use is not limited thereto. */
+/*		THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *		AND	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *		IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *		ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *		LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *		TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *		OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *		CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *		OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *		OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _TRIPLEBUFFER_H_
+#define _TRIPLEBUFFER_H_
+
+#include <string.h>                         // C language string handling functions
+#include "FreeRTOS.h"                       // Main header for FreeRTOS
+#include "baseshare.h"                      // Base class for shared data items
+#include "sharedblock.h"                    // For the compiler memory barrier
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Class for records passed from one writer to one reader through three
+ *           buffers.
+ *  @details A @c TaskShare copies its data inside a critical section, so sharing a
+ *           record of 12 to 30 bytes, such as a full frame of IMU data, holds off
+ *           interrupts (and so delays the encoder interrupts) for as long as the
+ *           copy takes. This class keeps three buffers instead, which at any time
+ *           have three roles:
+ *           \li The @e back buffer belongs to the writer, which fills it in place.
+ *           \li The @e front buffer belongs to the reader, which uses it in place.
+ *           \li The @e middle buffer holds the newest record which has been written
+ *               completely, and which the reader hasn't yet taken.
+ *
+ *           When the writer has filled the back buffer it calls @c publish(), which
+ *           swaps the back and middle buffers. When the reader calls @c get(), it
+ *           swaps the front and middle buffers if a newer record has been published,
+ *           then returns a reference to the front buffer. Neither swap copies any
+ *           data; each exchanges two one-byte indices in a critical section only a
+ *           few instructions long, whatever the size of the record. As the writer
+ *           never touches the front buffer and the reader never touches the back
+ *           buffer, the reader can never see a record which is partly written. If
+ *           the writer publishes several records before the reader looks, the older
+ *           ones are dropped and the reader gets only the newest.
+ *
+ *           There must be only one writer and one reader; a record which several
+ *           tasks read should be kept in a @c SharedBlock instead. The record got by
+ *           the reader stays valid until its next call to @c get(). Example:
+ *           @code
+ *           TripleBuffer<imu_frame_t>* p_frames
+ *                                   = new TripleBuffer<imu_frame_t> ("imu_frames");
+ *           ...
+ *           // In the sensor task, which is the writer
+ *           imu_frame_t& frame = p_frames->back ();
+ *           read_whole_frame (frame);
+ *           p_frames->publish ();
+ *           ...
+ *           // In the task which uses the frames, which is the reader
+ *           const imu_frame_t& frame = p_frames->get ();
+ *           @endcode
+ */
+
+template <class DataType> class TripleBuffer : public BaseShare
+{
+	protected:
+		DataType buffers[3];				///< The three copies of the record
+
+		uint8_t back_index;					///< Index of the buffer being written
+		uint8_t middle_index;				///< Index of the newest complete record
+		uint8_t front_index;				///< Index of the buffer being read
+
+		/** @brief   True when the middle buffer holds a record the reader hasn't got.
+		 */
+		volatile bool fresh;
+
+		/** @brief   Swap the middle buffer with the back buffer and mark it fresh.
+		 *  @details This must be called with interrupts off or from within an ISR.
+		 */
+		void swap_back (void)
+		{
+			SHARED_BLOCK_BARRIER ();
+			uint8_t index = middle_index;
+			middle_index = back_index;
+			back_index = index;
+			fresh = true;
+		}
+
+	public:
+		/** @brief   Construct a triple buffer share.
+		 *  @details All three buffers are set to zeros, so until a record has been
+		 *           published the reader gets a record of zeros.
+		 *  @param   p_name A name to be shown in the list of task shares
+		 */
+		TripleBuffer<DataType> (const char* p_name) : BaseShare (p_name),
+			back_index (0), middle_index (1), front_index (2), fresh (false)
+		{
+			memset (buffers, 0, sizeof (buffers));
+		}
+
+		/** @brief   Get the buffer which the writer fills.
+		 *  @details The writer may fill the buffer a field at a time, taking as long
+		 *           as it needs; nothing is shown to the reader until @c publish()
+		 *           is called. The buffer still holds an older record, so fields
+		 *           which aren't written keep old values.
+		 *  @return  A reference to the back buffer
+		 */
+		DataType& back (void)
+		{
+			return (buffers[back_index]);
+		}
+
+		// Make the record in the back buffer the newest complete record
+		void publish (void);
+
+		// Make the record in the back buffer the newest one, from within an ISR only
+		void ISR_publish (void);
+
+		// Copy a record into the back buffer and publish it
+		void put (const DataType& new_data);
+
+		// Get a reference to the newest complete record
+		const DataType& get (void);
+
+		/** @brief   Tell whether a record has been published since the last @c get().
+		 *  @return  @c true if @c get() would return a newer record
+		 */
+		bool is_fresh (void) const
+		{
+			return (fresh);
+		}
+
+		// Print the buffer's status within a list of all shares' statuses
+		void print_in_list (emstream* p_ser_dev);
+}; // class TripleBuffer<DataType>
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Make the record in the back buffer the newest complete record.
+ *  @details The back and middle buffers are swapped in a critical section which only
+ *           exchanges their indices, and the writer is given the old middle buffer
+ *           to fill next. This method must not be called from within an ISR.
+ */
+
+template <class DataType>
+void TripleBuffer<DataType>::publish (void)
+{
+	portENTER_CRITICAL ();
+	swap_back ();
+	portEXIT_CRITICAL ();
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Make the record in the back buffer the newest complete record, from
+ *           within an ISR.
+ *  @details This method must only be called from within a hardware interrupt, where
+ *           the reader can't run until the swap is finished.
+ */
+
+template <class DataType>
+void TripleBuffer<DataType>::ISR_publish (void)
+{
+	swap_back ();
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Copy a record into the back buffer and publish it.
+ *  @details The copy is made outside of any critical section.
+ *  @param   new_data The record which is to be written
+ */
+
+template <class DataType>
+void TripleBuffer<DataType>::put (const DataType& new_data)
+{
+	buffers[back_index] = new_data;
+	publish ();
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Get a reference to the newest complete record.
+ *  @details If a record has been published since the last call, the front and middle
+ *           buffers are swapped in a critical section which only exchanges their
+ *           indices. The record is not copied; it may be used through the reference
+ *           until the next call to this method, and the writer won't change it.
+ *  @return  A reference to the front buffer
+ */
+
+template <class DataType>
+const DataType& TripleBuffer<DataType>::get (void)
+{
+	if (fresh)
+	{
+		portENTER_CRITICAL ();
+		uint8_t index = middle_index;
+		middle_index = front_index;
+		front_index = index;
+		fresh = false;
+		portEXIT_CRITICAL ();
+		SHARED_BLOCK_BARRIER ();
+	}
+
+	return (buffers[front_index]);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Print the buffer's name and type within a list of all shares.
+ *  @details This method prints one line for this buffer and then asks the next item
+ *           in the list of shares to print itself.
+ *  @param   p_ser_dev Pointer to a serial device on which to print the status
+ */
+
+template <class DataType>
+void TripleBuffer<DataType>::print_in_list (emstream* p_ser_dev)
+{
+	// Print this buffer's name and pad it to 16 characters
+	*p_ser_dev << name;
+	for (uint8_t cols = strlen (name); cols < 16; cols++)
+	{
+		p_ser_dev->putchar (' ');
+	}
+
+	p_ser_dev->puts ("triple\t");
+
+	// End the line
+	*p_ser_dev << endl;
+
+	// Call the next item
+	if (p_next != NULL)
+	{
+		p_next->print_in_list (p_ser_dev);
+	}
+}
+
+#endif  // _TRIPLEBUFFER_H_
@@ -0,0 +1,78 @@
+//*************************************************************************************
+/** \file avr/interrupt.h
+ *    This file stands in for avr-libc's <avr/interrupt.h> when the ME405 code is
+ *    compiled for a Linux PC. An interrupt service routine becomes an ordinary
+ *    function named after its vector, such as \c __vector_5 for \c INT4_vect, so
+ *    that host test code can call it to simulate the interrupt. Vectors set up with
+ *    \c ISR_ALIAS() get a body which calls the routine they are aliased to; vectors
+ *    declared with \c ISR_ALIASOF() are only declared, so simulation code should
+ *    call the routine which really handles the interrupt.
+ *
+ *    The global interrupt enable and disable macros do nothing here. Code which
+ *    needs to be protected from the (simulated) interrupts must use the FreeRTOS
+ *    critical section macros, which the POSIX port implements with a mutex.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _AVR_HOST_INTERRUPT_H_
+#define _AVR_HOST_INTERRUPT_H_
+
+#include <avr/io.h>
+
+
+#ifdef __cplusplus
+	#define _AVR_HOST_EXTERN_C extern "C"
+#else
+	#define _AVR_HOST_EXTERN_C
+#endif
+
+/// An interrupt service routine is a plain function on the host; attributes such as
+/// @c ISR_NOBLOCK are accepted and ignored
+#define ISR(vector, ...) \
+	_AVR_HOST_EXTERN_C void vector (void); \
+	_AVR_HOST_EXTERN_C void vector (void)
+
+/// An aliased interrupt vector just calls the routine which handles the other vector
+#define ISR_ALIAS(vector, target_vector) \
+	_AVR_HOST_EXTERN_C void target_vector (void); \
+	_AVR_HOST_EXTERN_C void vector (void); \
+	_AVR_HOST_EXTERN_C void vector (void) { target_vector (); }
+
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+#define ISR_NAKED
+#define ISR_ALIASOF(target_vector)
+#define EMPTY_INTERRUPT(vector)     ISR (vector) { }
+
+#define sei()
+#define cli()
+
+// Interrupt vector numbers of the ATmega1281
+#define INT0_vect                   __vector_1
+#define INT1_vect                   __vector_2
+#define INT2_vect                   __vector_3
+#define INT3_vect                   __vector_4
+#define INT4_vect                   __vector_5
+#define INT5_vect                   __vector_6
+#define INT6_vect                   __vector_7
+#define INT7_vect                   __vector_8
+#define TIMER1_COMPA_vect           __vector_17
+#define TIMER1_OVF_vect             __vector_20
+#define USART0_RX_vect              __vector_25
+#define USART0_UDRE_vect            __vector_26
+#define USART0_TX_vect              __vector_27
+#define ADC_vect                    __vector_29
+#define TIMER3_COMPA_vect           __vector_32
+#define TIMER3_OVF_vect             __vector_35
+#define USART1_RX_vect              __vector_36
+#define USART1_UDRE_vect            __vector_37
+#define USART1_TX_vect              __vector_38
+#define TWI_vect                    __vector_39
+#define TIMER5_COMPA_vect           __vector_47
+#define TIMER5_OVF_vect             __vector_50
+
+#endif // _AVR_HOST_INTERRUPT_H_
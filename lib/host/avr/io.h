@@ -0,0 +1,285 @@
+//*************************************************************************************
+/** \file avr/io.h
+ *    This file stands in for avr-libc's <avr/io.h> when the ME405 code is compiled
+ *    for a Linux PC. The special function registers of the ATmega1281 are mapped
+ *    onto one array of bytes, \c avr_host_sfr[], at the same data space addresses
+ *    they have on the real chip, so that 16-bit registers such as \c OCR1A overlap
+ *    their \c L and \c H halves just as they do in the hardware. Register and bit
+ *    names are only provided for the peripherals which the ME405 drivers use.
+ *
+ *    Writing to a mock register just stores a number; nothing happens in response.
+ *    Host test code can read the registers to see what a driver has done, or write
+ *    them (for example \c PINE, \c ADC or \c TWDR) to simulate inputs.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _AVR_HOST_IO_H_
+#define _AVR_HOST_IO_H_
+
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// This array holds the contents of all the mock registers, indexed by data address
+extern volatile uint8_t avr_host_sfr[0x200];
+
+#ifdef __cplusplus
+}
+#endif
+
+/// This macro refers to an 8-bit register at the given data space address
+#define _SFR_MEM8(addr)     (avr_host_sfr[(addr)])
+
+/// This macro refers to a 16-bit register whose low byte is at the given address
+#define _SFR_MEM16(addr)    (*(volatile uint16_t*)(&avr_host_sfr[(addr)]))
+
+/// The avr-libc name of the bit value macro
+#define _BV(bit)            (1 << (bit))
+
+
+// Memory size constants for the ATmega1281
+#define RAMSTART            0x200
+#define RAMEND              0x21FF
+#define E2END               0xFFF
+#define FLASHEND            0x1FFFF
+
+
+// General purpose I/O ports A through G
+#define PINA                _SFR_MEM8 (0x20)
+#define DDRA                _SFR_MEM8 (0x21)
+#define PORTA               _SFR_MEM8 (0x22)
+#define PINB                _SFR_MEM8 (0x23)
+#define DDRB                _SFR_MEM8 (0x24)
+#define PORTB               _SFR_MEM8 (0x25)
+#define PINC                _SFR_MEM8 (0x26)
+#define DDRC                _SFR_MEM8 (0x27)
+#define PORTC               _SFR_MEM8 (0x28)
+#define PIND                _SFR_MEM8 (0x29)
+#define DDRD                _SFR_MEM8 (0x2A)
+#define PORTD               _SFR_MEM8 (0x2B)
+#define PINE                _SFR_MEM8 (0x2C)
+#define DDRE                _SFR_MEM8 (0x2D)
+#define PORTE               _SFR_MEM8 (0x2E)
+#define PINF                _SFR_MEM8 (0x2F)
+#define DDRF                _SFR_MEM8 (0x30)
+#define PORTF               _SFR_MEM8 (0x31)
+#define PING                _SFR_MEM8 (0x32)
+#define DDRG                _SFR_MEM8 (0x33)
+#define PORTG               _SFR_MEM8 (0x34)
+
+// The bit numbers are the same for every port, so one set of names per port letter
+// is generated here in the same way as the real header does it
+#define _AVR_HOST_PORT_BITS(x) \
+	x##0 = 0, x##1 = 1, x##2 = 2, x##3 = 3, x##4 = 4, x##5 = 5, x##6 = 6, x##7 = 7
+
+enum
+{
+	_AVR_HOST_PORT_BITS (PINA), _AVR_HOST_PORT_BITS (DDA), _AVR_HOST_PORT_BITS (PORTA),
+	_AVR_HOST_PORT_BITS (PINB), _AVR_HOST_PORT_BITS (DDB), _AVR_HOST_PORT_BITS (PORTB),
+	_AVR_HOST_PORT_BITS (PINC), _AVR_HOST_PORT_BITS (DDC), _AVR_HOST_PORT_BITS (PORTC),
+	_AVR_HOST_PORT_BITS (PIND), _AVR_HOST_PORT_BITS (DDD), _AVR_HOST_PORT_BITS (PORTD),
+	_AVR_HOST_PORT_BITS (PINE), _AVR_HOST_PORT_BITS (DDE), _AVR_HOST_PORT_BITS (PORTE),
+	_AVR_HOST_PORT_BITS (PINF), _AVR_HOST_PORT_BITS (DDF), _AVR_HOST_PORT_BITS (PORTF),
+	_AVR_HOST_PORT_BITS (PING), _AVR_HOST_PORT_BITS (DDG), _AVR_HOST_PORT_BITS (PORTG)
+};
+
+
+// Status register, stack pointer and reset cause
+#define SREG                _SFR_MEM8 (0x5F)
+#define SREG_I              7
+#define SPH                 _SFR_MEM8 (0x5E)
+#define SPL                 _SFR_MEM8 (0x5D)
+#define SP                  _SFR_MEM16 (0x5D)
+#define MCUCR               _SFR_MEM8 (0x55)
+#define MCUSR               _SFR_MEM8 (0x54)
+#define WDTCSR              _SFR_MEM8 (0x60)
+
+#define PORF                0
+#define EXTRF               1
+#define BORF                2
+#define WDRF                3
+#define JTRF                4
+
+
+// External interrupts
+#define EIFR                _SFR_MEM8 (0x3C)
+#define EIMSK               _SFR_MEM8 (0x3D)
+#define EICRA               _SFR_MEM8 (0x69)
+#define EICRB               _SFR_MEM8 (0x6A)
+
+#define INT0                0
+#define INT1                1
+#define INT2                2
+#define INT3                3
+#define INT4                4
+#define INT5                5
+#define INT6                6
+#define INT7                7
+
+#define ISC00               0
+#define ISC01               1
+#define ISC10               2
+#define ISC11               3
+#define ISC20               4
+#define ISC21               5
+#define ISC30               6
+#define ISC31               7
+#define ISC40               0
+#define ISC41               1
+#define ISC50               2
+#define ISC51               3
+#define ISC60               4
+#define ISC61               5
+#define ISC70               6
+#define ISC71               7
+
+
+// Timer interrupt flag and mask registers
+#define TIFR0               _SFR_MEM8 (0x35)
+#define TIFR1               _SFR_MEM8 (0x36)
+#define TIFR2               _SFR_MEM8 (0x37)
+#define TIFR3               _SFR_MEM8 (0x38)
+#define TIFR4               _SFR_MEM8 (0x39)
+#define TIFR5               _SFR_MEM8 (0x3A)
+#define TIMSK0              _SFR_MEM8 (0x6E)
+#define TIMSK1              _SFR_MEM8 (0x6F)
+#define TIMSK2              _SFR_MEM8 (0x70)
+#define TIMSK3              _SFR_MEM8 (0x71)
+#define TIMSK4              _SFR_MEM8 (0x72)
+#define TIMSK5              _SFR_MEM8 (0x73)
+
+
+// The 16-bit timers all have the same register layout, starting at a base address
+#define TCCR1A              _SFR_MEM8 (0x80)
+#define TCCR1B              _SFR_MEM8 (0x81)
+#define TCCR1C              _SFR_MEM8 (0x82)
+#define TCNT1               _SFR_MEM16 (0x84)
+#define ICR1                _SFR_MEM16 (0x86)
+#define OCR1A               _SFR_MEM16 (0x88)
+#define OCR1B               _SFR_MEM16 (0x8A)
+#define OCR1C               _SFR_MEM16 (0x8C)
+
+#define TCCR3A              _SFR_MEM8 (0x90)
+#define TCCR3B              _SFR_MEM8 (0x91)
+#define TCCR3C              _SFR_MEM8 (0x92)
+#define TCNT3               _SFR_MEM16 (0x94)
+#define ICR3                _SFR_MEM16 (0x96)
+#define OCR3A               _SFR_MEM16 (0x98)
+#define OCR3B               _SFR_MEM16 (0x9A)
+#define OCR3C               _SFR_MEM16 (0x9C)
+
+#define TCCR4A              _SFR_MEM8 (0xA0)
+#define TCCR4B              _SFR_MEM8 (0xA1)
+#define TCCR4C              _SFR_MEM8 (0xA2)
+#define TCNT4               _SFR_MEM16 (0xA4)
+#define ICR4                _SFR_MEM16 (0xA6)
+#define OCR4A               _SFR_MEM16 (0xA8)
+#define OCR4B               _SFR_MEM16 (0xAA)
+#define OCR4C               _SFR_MEM16 (0xAC)
+
+#define TCCR5A              _SFR_MEM8 (0x120)
+#define TCCR5B              _SFR_MEM8 (0x121)
+#define TCCR5C              _SFR_MEM8 (0x122)
+#define TCNT5               _SFR_MEM16 (0x124)
+#define ICR5                _SFR_MEM16 (0x126)
+#define OCR5A               _SFR_MEM16 (0x128)
+#define OCR5B               _SFR_MEM16 (0x12A)
+#define OCR5C               _SFR_MEM16 (0x12C)
+
+// Bits in TCCRnA, TCCRnB and TIMSKn, which are the same for timers 1, 3, 4 and 5
+#define _AVR_HOST_TIMER_BITS(n) \
+	WGM##n##0 = 0, WGM##n##1 = 1, COM##n##C0 = 2, COM##n##C1 = 3, COM##n##B0 = 4, \
+	COM##n##B1 = 5, COM##n##A0 = 6, COM##n##A1 = 7, CS##n##0 = 0, CS##n##1 = 1, \
+	CS##n##2 = 2, WGM##n##2 = 3, WGM##n##3 = 4, ICES##n = 6, ICNC##n = 7, \
+	TOIE##n = 0, OCIE##n##A = 1, OCIE##n##B = 2, OCIE##n##C = 3, ICIE##n = 5
+
+enum
+{
+	_AVR_HOST_TIMER_BITS (1), _AVR_HOST_TIMER_BITS (3),
+	_AVR_HOST_TIMER_BITS (4), _AVR_HOST_TIMER_BITS (5)
+};
+
+
+// A/D converter
+#define ADCW                _SFR_MEM16 (0x78)
+#define ADC                 _SFR_MEM16 (0x78)
+#define ADCL                _SFR_MEM8 (0x78)
+#define ADCH                _SFR_MEM8 (0x79)
+#define ADCSRA              _SFR_MEM8 (0x7A)
+#define ADCSRB              _SFR_MEM8 (0x7B)
+#define ADMUX               _SFR_MEM8 (0x7C)
+#define DIDR0               _SFR_MEM8 (0x7E)
+
+#define MUX0                0
+#define MUX1                1
+#define MUX2                2
+#define MUX3                3
+#define MUX4                4
+#define ADLAR               5
+#define REFS0               6
+#define REFS1               7
+
+#define ADPS0               0
+#define ADPS1               1
+#define ADPS2               2
+#define ADIE                3
+#define ADIF                4
+#define ADATE               5
+#define ADSC                6
+#define ADEN                7
+
+
+// Two-wire (I2C) interface
+#define TWBR                _SFR_MEM8 (0xB8)
+#define TWSR                _SFR_MEM8 (0xB9)
+#define TWAR                _SFR_MEM8 (0xBA)
+#define TWDR                _SFR_MEM8 (0xBB)
+#define TWCR                _SFR_MEM8 (0xBC)
+
+#define TWIE                0
+#define TWEN                2
+#define TWWC                3
+#define TWSTO               4
+#define TWSTA               5
+#define TWEA                6
+#define TWINT               7
+#define TWPS0               0
+#define TWPS1               1
+
+
+// USART's 0 and 1
+#define UCSR0A              _SFR_MEM8 (0xC0)
+#define UCSR0B              _SFR_MEM8 (0xC1)
+#define UCSR0C              _SFR_MEM8 (0xC2)
+#define UBRR0               _SFR_MEM16 (0xC4)
+#define UBRR0L              _SFR_MEM8 (0xC4)
+#define UBRR0H              _SFR_MEM8 (0xC5)
+#define UDR0                _SFR_MEM8 (0xC6)
+
+#define UCSR1A              _SFR_MEM8 (0xC8)
+#define UCSR1B              _SFR_MEM8 (0xC9)
+#define UCSR1C              _SFR_MEM8 (0xCA)
+#define UBRR1               _SFR_MEM16 (0xCC)
+#define UBRR1L              _SFR_MEM8 (0xCC)
+#define UBRR1H              _SFR_MEM8 (0xCD)
+#define UDR1                _SFR_MEM8 (0xCE)
+
+#define _AVR_HOST_USART_BITS(n) \
+	MPCM##n = 0, U2X##n = 1, UPE##n = 2, DOR##n = 3, FE##n = 4, UDRE##n = 5, \
+	TXC##n = 6, RXC##n = 7, TXB8##n = 0, RXB8##n = 1, UCSZ##n##2 = 2, TXEN##n = 3, \
+	RXEN##n = 4, UDRIE##n = 5, TXCIE##n = 6, RXCIE##n = 7, UCPOL##n = 0, \
+	UCSZ##n##0 = 1, UCSZ##n##1 = 2, USBS##n = 3, UPM##n##0 = 4, UPM##n##1 = 5
+
+enum
+{
+	_AVR_HOST_USART_BITS (0), _AVR_HOST_USART_BITS (1)
+};
+
+#endif // _AVR_HOST_IO_H_
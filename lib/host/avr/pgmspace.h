@@ -0,0 +1,38 @@
+//*************************************************************************************
+/** \file avr/pgmspace.h
+ *    This file stands in for avr-libc's <avr/pgmspace.h> when the ME405 code is
+ *    compiled for a Linux PC. A PC has one address space for code and data, so
+ *    program memory strings are just ordinary constant strings and the functions
+ *    which read program memory become plain memory reads.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _AVR_HOST_PGMSPACE_H_
+#define _AVR_HOST_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+
+#define PROGMEM
+#define PGM_P                       const char*
+#define PSTR(s)                     (s)
+
+#define pgm_read_byte_near(addr)    (*(const uint8_t*)(addr))
+#define pgm_read_byte_far(addr)     (*(const uint8_t*)(addr))
+#define pgm_read_byte(addr)         (*(const uint8_t*)(addr))
+#define pgm_read_word_near(addr)    (*(const uint16_t*)(addr))
+#define pgm_read_word(addr)         (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr)        (*(const uint32_t*)(addr))
+
+#define memcpy_P                    memcpy
+#define strcpy_P                    strcpy
+#define strncpy_P                   strncpy
+#define strlen_P                    strlen
+#define strcmp_P                    strcmp
+
+#endif // _AVR_HOST_PGMSPACE_H_
@@ -0,0 +1,29 @@
+//*************************************************************************************
+/** \file avr/wdt.h
+ *    This file stands in for avr-libc's <avr/wdt.h> when the ME405 code is compiled
+ *    for a Linux PC. There is no watchdog on the host, so the watchdog functions do
+ *    nothing.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _AVR_HOST_WDT_H_
+#define _AVR_HOST_WDT_H_
+
+#define WDTO_15MS           0
+#define WDTO_30MS           1
+#define WDTO_60MS           2
+#define WDTO_120MS          3
+#define WDTO_250MS          4
+#define WDTO_500MS          5
+#define WDTO_1S             6
+#define WDTO_2S             7
+
+#define wdt_enable(timeout) ((void)(timeout))
+#define wdt_disable()
+#define wdt_reset()
+
+#endif // _AVR_HOST_WDT_H_
@@ -0,0 +1,15 @@
+//*************************************************************************************
+/** \file avr_io.c
+ *    This file holds the storage for the mock special function registers which are
+ *    declared in the host version of <avr/io.h>.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//*************************************************************************************
+
+#include <avr/io.h>
+
+
+/// The mock registers, which take up the I/O part of the ATmega1281's data space
+volatile uint8_t avr_host_sfr[0x200];
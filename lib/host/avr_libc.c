@@ -0,0 +1,176 @@
+//*************************************************************************************
+/** \file avr_libc.c
+ *    This file contains host versions of the few avr-libc functions which the ME405
+ *    library uses but which the GNU C library doesn't have: the integer to string
+ *    conversions @c itoa() and friends and the floating point conversion engine
+ *    @c __ftoa_engine() which @c emstream uses to print floats. Their results match
+ *    what avr-libc produces for the arguments @c emstream gives them.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//*************************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+
+
+/// These codes go into the first byte of the buffer filled by __ftoa_engine()
+#define FTOA_MINUS      1
+#define FTOA_ZERO       2
+#define FTOA_INF        4
+#define FTOA_NAN        8
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Convert an unsigned long integer to a string in the given radix.
+ *  @details Digits above 9 are written as lower case letters, as avr-libc does.
+ *  @param   value The number to be converted
+ *  @param   p_string The buffer into which the string is written
+ *  @param   radix The number base, 2 through 36
+ *  @return  A pointer to the string, which is the same as @c p_string
+ */
+
+char* ultoa (unsigned long value, char* p_string, int radix)
+{
+	char digits[8 * sizeof (unsigned long) + 1];
+	uint8_t count = 0;
+	char* p_out = p_string;
+
+	do
+	{
+		uint8_t digit = value % radix;
+		digits[count++] = (digit < 10) ? ('0' + digit) : ('a' + digit - 10);
+		value /= radix;
+	}
+	while (value);
+
+	while (count)
+	{
+		*p_out++ = digits[--count];
+	}
+	*p_out = '\0';
+
+	return (p_string);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Convert a long integer to a string in the given radix.
+ *  @details As in avr-libc, a minus sign is only printed for negative numbers in
+ *           base 10; in other bases the number's bits are shown as unsigned.
+ *  @param   value The number to be converted
+ *  @param   p_string The buffer into which the string is written
+ *  @param   radix The number base, 2 through 36
+ *  @return  A pointer to the string, which is the same as @c p_string
+ */
+
+char* ltoa (long value, char* p_string, int radix)
+{
+	if (radix == 10 && value < 0)
+	{
+		*p_string = '-';
+		ultoa (-(unsigned long)value, p_string + 1, radix);
+		return (p_string);
+	}
+	return (ultoa ((unsigned long)value, p_string, radix));
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Convert an integer to a string in the given radix.
+ *  @param   value The number to be converted
+ *  @param   p_string The buffer into which the string is written
+ *  @param   radix The number base, 2 through 36
+ *  @return  A pointer to the string, which is the same as @c p_string
+ */
+
+char* itoa (int value, char* p_string, int radix)
+{
+	if (radix == 10)
+	{
+		return (ltoa ((long)value, p_string, radix));
+	}
+	return (ultoa ((unsigned int)value, p_string, radix));
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Convert an unsigned integer to a string in the given radix.
+ *  @param   value The number to be converted
+ *  @param   p_string The buffer into which the string is written
+ *  @param   radix The number base, 2 through 36
+ *  @return  A pointer to the string, which is the same as @c p_string
+ */
+
+char* utoa (unsigned int value, char* p_string, int radix)
+{
+	return (ultoa ((unsigned long)value, p_string, radix));
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Convert a floating point number into a string of decimal digits.
+ *  @details The first byte of the buffer holds flags which show whether the number
+ *           is negative, zero, infinite or not a number. It is followed by the
+ *           rounded digits of the mantissa, one before the decimal point and
+ *           @c prec after it, then a null character.
+ *  @param   val The number to be converted
+ *  @param   buf A buffer into which the flags and digits are written
+ *  @param   prec The number of digits to put after the first one
+ *  @param   maxdgs The largest number of digits which may be produced
+ *  @return  The power of ten by which the mantissa must be multiplied
+ */
+
+int __ftoa_engine (double val, char* buf, uint8_t prec, uint8_t maxdgs)
+{
+	char text[40];
+	char* p_text = text;
+	int exponent = 0;
+	uint8_t n_digits = prec + 1;
+
+	buf[0] = signbit (val) ? FTOA_MINUS : 0;
+	if (isnan (val))
+	{
+		buf[0] |= FTOA_NAN;
+		strcpy (buf + 1, "nan");
+		return (0);
+	}
+	if (isinf (val))
+	{
+		buf[0] |= FTOA_INF;
+		strcpy (buf + 1, "inf");
+		return (0);
+	}
+	if (val == 0.0)
+	{
+		buf[0] |= FTOA_ZERO;
+	}
+
+	if (n_digits > maxdgs)
+	{
+		n_digits = maxdgs;
+	}
+
+	// Let the C library round the mantissa, then copy its digits without the point
+	snprintf (text, sizeof (text), "%.*e", n_digits - 1, fabs (val));
+	char* p_out = buf + 1;
+	while (*p_text && *p_text != 'e')
+	{
+		if (*p_text != '.')
+		{
+			*p_out++ = *p_text;
+		}
+		p_text++;
+	}
+	*p_out = '\0';
+	if (*p_text == 'e')
+	{
+		exponent = atoi (p_text + 1);
+	}
+
+	return (exponent);
+}
@@ -0,0 +1,91 @@
+//*************************************************************************************
+/** \file host_serial.cpp
+ *    This file contains the serial device class which the host (Linux PC) build of
+ *    the ME405 code uses in place of class \c rs232.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ *    \li 10-17-2026 ME405 Group 3 Blocks of characters go out in one write()
+ */
+//*************************************************************************************
+
+#include <unistd.h>                         // For read() and write()
+#include <poll.h>                           // For checking if input is available
+#include "host_serial.h"                    // Header for this class
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Create a serial device which uses the program's standard input and output.
+ */
+
+host_serial::host_serial (void)
+	: emstream ()
+{
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Write one character to the program's standard output.
+ *  @param   a_char The character to be written
+ */
+
+void host_serial::putchar (char a_char)
+{
+	ssize_t written = ::write (STDOUT_FILENO, &a_char, 1);
+	(void)written;
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Write a block of characters to the program's standard output at once.
+ *  @param   p_data A pointer to the characters to be written
+ *  @param   length The number of characters to write
+ */
+
+void host_serial::write (const char* p_data, size_t length)
+{
+	ssize_t written = ::write (STDOUT_FILENO, p_data, length);
+	(void)written;
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Check if a character is waiting to be read from standard input.
+ *  @return  True if a character is ready to be read, false if not
+ */
+
+bool host_serial::check_for_char (void)
+{
+	struct pollfd in_poll = { STDIN_FILENO, POLLIN, 0 };
+
+	return (poll (&in_poll, 1, 0) > 0 && (in_poll.revents & POLLIN));
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Read a character from standard input.
+ *  @details This method waits until a character can be read. If standard input has
+ *           been closed, a null character is returned.
+ *  @return  The character which was read
+ */
+
+char host_serial::getchar (void)
+{
+	char a_char;
+
+	if (::read (STDIN_FILENO, &a_char, 1) != 1)
+	{
+		return ('\0');
+	}
+	return (a_char);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Clear the terminal screen using the same code which \c rs232 sends.
+ */
+
+void host_serial::clear_screen (void)
+{
+	putchar (CLRSCR_STYLE);
+}
@@ -0,0 +1,47 @@
+//*************************************************************************************
+/** \file host_serial.h
+ *    This file contains a serial device class for the host (Linux PC) build of the
+ *    ME405 code. It takes the place of class \c rs232, sending characters to the
+ *    standard output of the program and reading them from its standard input, so
+ *    that task code which prints with \c << can run unchanged on a PC.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ *    \li 10-17-2026 ME405 Group 3 Blocks of characters go out in one write()
+ */
+//*************************************************************************************
+
+// This define prevents this .h file from being included more than once in a .cpp file
+#ifndef _HOST_SERIAL_H_
+#define _HOST_SERIAL_H_
+
+#include "emstream.h"                       // Pull in the base class header file
+
+
+//-------------------------------------------------------------------------------------
+/** \brief This class is a serial device which talks to the terminal in which a host
+ *  build of the ME405 program is running.
+ *  \details Characters are written with the \c write() system call rather than the
+ *  C library's buffered output. The C library's stream locks can't be used safely
+ *  by FreeRTOS tasks in the POSIX port, because a task can be switched out while it
+ *  holds one. Received characters are read one at a time with \c read(); because a
+ *  read blocks the whole simulated processor, tasks should call \c check_for_char()
+ *  before calling \c getchar(), as the ME405 user interface tasks already do.
+ */
+
+class host_serial : public emstream
+{
+	// Public methods can be called from anywhere in the program where there is a
+	// pointer or reference to an object of this class
+	public:
+		// The constructor just sets up the base class
+		host_serial (void);
+
+		void putchar (char);                // Write one character to standard output
+		void write (const char*, size_t);   // Write a block of characters at once
+		bool check_for_char (void);         // Check if a character can be read
+		char getchar (void);                // Read a character from standard input
+		void clear_screen (void);           // Send the 'clear display screen' code
+};
+
+#endif  // _HOST_SERIAL_H_
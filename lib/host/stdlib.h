@@ -0,0 +1,32 @@
+//*************************************************************************************
+/** \file stdlib.h
+ *    This file wraps the C library's <stdlib.h> when the ME405 code is compiled for a
+ *    Linux PC. It adds the integer to string conversion functions which avr-libc
+ *    provides but the GNU C library doesn't, so that the \c emstream printing code
+ *    can be compiled unchanged. The functions are in \c avr_libc.c.
+ *
+ *  Revisions:
+ *    \li 10-17-2026 ME405 Group 3 original file
+ */
+//*************************************************************************************
+
+#include_next <stdlib.h>
+
+// This define prevents the extra declarations from being made more than once
+#ifndef _AVR_HOST_STDLIB_H_
+#define _AVR_HOST_STDLIB_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+char* itoa (int value, char* p_string, int radix);
+char* ltoa (long value, char* p_string, int radix);
+char* utoa (unsigned int value, char* p_string, int radix);
+char* ultoa (unsigned long value, char* p_string, int radix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _AVR_HOST_STDLIB_H_
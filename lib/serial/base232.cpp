@@ -20,6 +20,8 @@
  *    \li 12-22-2008 JRR Split off stuff in base232.h for efficiency
  *    \li 01-30-2009 JRR Added class with port setup in constructor
  *    \li 06-02-2009 JRR Changed baud rate divisor formula to work better
+ *    \li 10-17-2026 ME405 Group 3 The double speed bit is really set, and the high
+ *        byte of the baud rate divisor is used for slow baud rates
  *
  *  License:
  *    This file is released under the Lesser GNU Public License, version 2. This 
@@ -64,10 +66,10 @@ base232::base232 (unsigned int baud_rate, unsigned char port_number)
 			p_UCR = &UCSR0B;
 			UCSR0B = (1 << RXEN0) | (1 << TXEN0);
 			UCSR0C = (1 << UCSZ01) | (1 << UCSZ00); // | (1 << USBS0);
-			UBRR0H = 0x00;
-			UBRR0L = calc_baud_div (baud_rate);
+			UBRR0H = (uint8_t)(calc_baud_div (baud_rate) >> 8);
+			UBRR0L = (uint8_t)calc_baud_div (baud_rate);
 			#ifdef UART_DOUBLE_SPEED					// Activate double speed mode
-				UCSR0A |= U2X0;							// if required
+				UCSR0A |= (1 << U2X0);					// if required
 			#endif
 			mask_UDRE = (1 << UDRE0);
 			mask_RXC = (1 << RXC0);
@@ -81,10 +83,10 @@ base232::base232 (unsigned int baud_rate, unsigned char port_number)
 			p_UCR = &UCSR1B;
 			UCSR1B = (1 << RXEN1) | (1 << TXEN1);
 			UCSR1C = (1 << UCSZ11) | (1 << UCSZ10); // | (1 << USBS1);
-			UBRR1H = 0x00;
-			UBRR1L = calc_baud_div (baud_rate);
+			UBRR1H = (uint8_t)(calc_baud_div (baud_rate) >> 8);
+			UBRR1L = (uint8_t)calc_baud_div (baud_rate);
 			#ifdef UART_DOUBLE_SPEED		// If double-speed macro has been defined,
-				UCSR1A |= U2X1;				// turn on double-speed operation
+				UCSR1A |= (1 << U2X1);		// turn on double-speed operation
 			#endif
 			mask_UDRE = (1 << UDRE1);
 			mask_RXC = (1 << RXC1);
@@ -102,10 +104,10 @@ base232::base232 (unsigned int baud_rate, unsigned char port_number)
 			p_UCR = &UCSRB;
 			UCSRB = (1 << RXEN) | (1 << TXEN);
 			UCSRC = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0);		// | (1 << USBS0);
-			UBRRH = 0x00;
-			UBRRL = calc_baud_div (baud_rate);
+			UBRRH = (uint8_t)(calc_baud_div (baud_rate) >> 8);
+			UBRRL = (uint8_t)calc_baud_div (baud_rate);
 			#ifdef UART_DOUBLE_SPEED				// Activate double speed mode
-				UCSRA |= U2X;						// if required
+				UCSRA |= (1 << U2X);				// if required
 			#endif
 			mask_UDRE = (1 << UDRE);
 			mask_RXC = (1 << RXC);
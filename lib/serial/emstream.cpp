@@ -27,6 +27,8 @@
  *    \li 11-12-2012 JRR Made puts() non-virtual; made ENDL_STYLE() a function macro
  *    \li 12-21-2013 JRR Ported to ChibiOS
  *    \li 10-17-2014 JRR Made compatible with FreeRTOS for Cal Poly class use
+ *    \li 10-17-2026 ME405 Group 3 Added virtual write(); puts() sends strings through it
+ *    \li 10-17-2026 ME405 Group 3 Added setw() and setfill(); print_ascii is set false
  *
  *  License:
  *    This file released under the Lesser GNU Public License, version 2. This program
@@ -71,6 +73,23 @@ uint8_t bts_new_prec = 3;
 uint8_t bts_new_base = 10;
 
 
+//-------------------------------------------------------------------------------------
+/** @brief   Temporary holder for the @c setw() format function.
+ *  @details This variable carries the width given to @c setw() to the serial device
+ *           in whose @c << line the manipulator is used, as @c bts_new_base does for
+ *           @c setbase().
+ */
+uint8_t bts_new_width = 0;
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Temporary holder for the @c setfill() format function.
+ *  @details This variable carries the character given to @c setfill() to the serial
+ *           device in whose @c << line the manipulator is used.
+ */
+char bts_new_fill = ' ';
+
+
 //-------------------------------------------------------------------------------------
 /** @brief   Create a base text stream object.
  *  @details This constructor sets up the base serial port object. It sets the default
@@ -82,6 +101,9 @@ emstream::emstream (void)
 {
 	base = 10;                              // Numbers are shown as decimal by default
 	precision = 3;                          // Print 3 digits after a decimal point
+	print_ascii = false;                    // 8-bit numbers are printed as numbers
+	width = 0;                              // Numbers aren't padded unless asked
+	fill = ' ';                             // Padding is made of spaces by default
 	#ifdef __AVR
 		pgm_string = false;                 // Print strings from SRAM by default
 	#endif
@@ -165,26 +187,35 @@ void emstream::clear_screen (void)
 
 //-------------------------------------------------------------------------------------
 /** @brief   Write a character string to a serial device.
- *  @details This method writes a string to the serial device. It goes through the 
- *           character buffer to which its parameter points, calling \c putchar() to 
- *           print each character until and end of string character (the null 
- *           character, \c '\0') is reached.
+ *  @details This method writes a string to the serial device. It finds the end of
+ *           string character (the null character, \c '\0') and then calls 
+ *           \c write() to print the characters before it.
  *  @param   p_string A pointer to the string which is to be printed
  */
 
 void emstream::puts (const char* p_string)
 {
 #ifdef __AVR
-	char ch;                                // Temporary storage for a character
-
 	// If the program-string variable is set, this string is to be found in program
-	// memory rather than data memory
+	// memory rather than data memory. It's copied into RAM a few characters at a time
+	// so that it can be written in blocks
 	if (pgm_string)
 	{
+		char block[16];                     // Characters copied from program memory
+		uint8_t length = 0;                 // Number of characters in the block
+
 		pgm_string = false;
-		while ((ch = pgm_read_byte_near (p_string++)))
+		while ((block[length] = pgm_read_byte_near (p_string++)))
+		{
+			if (++length >= sizeof (block))
+			{
+				write (block, length);
+				length = 0;
+			}
+		}
+		if (length > 0)
 		{
-			putchar (ch);
+			write (block, length);
 		}
 	}
 	// If the program-string variable is not set, the string is in RAM and printed
@@ -192,10 +223,27 @@ void emstream::puts (const char* p_string)
 	else
 #endif
 	{
-		while (*p_string)
-		{
-			putchar (*p_string++);
-		}
+		write (p_string, strlen (p_string));
+	}
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Write a block of characters to a serial device.
+ *  @details This method writes the given number of characters, calling @c putchar()
+ *           for each one. Devices which can take a block of characters at once more
+ *           quickly than one at a time, such as queues which must lock themselves for
+ *           each write, should override it; @c puts() and everything printed with
+ *           @c << as a string goes through here.
+ *  @param   p_data A pointer to the characters to be written
+ *  @param   length The number of characters to write
+ */
+
+void emstream::write (const char* p_data, size_t length)
+{
+	while (length--)
+	{
+		putchar (*p_data++);
 	}
 }
 
@@ -248,6 +296,52 @@ ser_manipulator setbase (uint8_t new_base)
 }
 
 
+//-------------------------------------------------------------------------------------
+/** @brief   Set the width to which the next decimal number is padded.
+ *  @details This function, not a member of class emstream, returns a manipulator which
+ *           causes a serial object to pad the next number it prints in decimal with
+ *           the fill character, on the left, until it's at least the given number of
+ *           characters wide. As with @c std::setw(), the width only applies to that
+ *           one number, so each column of a table is given its own width:
+ *           @code
+ *           *p_serial << setw (6) << position << setw (6) << speed << endl;
+ *           @endcode
+ *           Numbers which are already as wide as this are printed in full.
+ *  @param   new_width The number of characters, up to @c EMSTREAM_MAX_WIDTH
+ *  @return  The serial manipulator called @c manip_set_width
+ */
+
+ser_manipulator setw (uint8_t new_width)
+{
+	if (new_width > EMSTREAM_MAX_WIDTH)
+	{
+		new_width = EMSTREAM_MAX_WIDTH;
+	}
+	bts_new_width = new_width;
+
+	return (manip_set_width);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** @brief   Set the character with which decimal numbers are padded.
+ *  @details This function, not a member of class emstream, returns a manipulator which
+ *           sets the character used to pad numbers to the width given by @c setw().
+ *           The fill character is "sticky" and stays until it's changed again. When
+ *           it's @c '0', a minus sign goes before the zeros, as with @c printf()'s
+ *           @c %05d, rather than after them.
+ *  @param   new_fill The character with which to pad numbers
+ *  @return  The serial manipulator called @c manip_set_fill
+ */
+
+ser_manipulator setfill (char new_fill)
+{
+	bts_new_fill = new_fill;
+
+	return (manip_set_fill);
+}
+
+
 //-------------------------------------------------------------------------------------
 /** @brief   Overloaded operator used to print things to a serial device.
  *  @details This overload allows manipulators to be used to change the base of 
@@ -295,6 +389,12 @@ emstream& emstream::operator<< (ser_manipulator new_manip)
 		case (manip_set_base):              // Set numeric base to a number 2 to 16
 			base = bts_new_base;
 			break;
+		case (manip_set_width):             // Pad the next decimal number
+			width = bts_new_width;
+			break;
+		case (manip_set_fill):              // Set the character used for padding
+			fill = bts_new_fill;
+			break;
 		default:                            // Not recognized?  Do nothing then
 			break;
 	};
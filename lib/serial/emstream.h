@@ -23,6 +23,8 @@
  *    \li 10-22-2012 JRR Fixed (OK, hacked around) bug which caused spurious warning 
  *                       for all Program Memory Strings
  *    \li 11-12-2012 JRR Made puts() non-virtual; made ENDL_STYLE() a function macro
+ *    \li 10-17-2026 ME405 Group 3 Added virtual write(); puts() sends strings through it
+ *    \li 10-17-2026 ME405 Group 3 Decimal numbers made without division; added setw(), setfill()
  *
  *  License:
  *    This file released under the Lesser GNU Public License, version 2. This program
@@ -195,6 +197,10 @@ typedef enum
 	manip_set_precision,
 	/// Set the base for numerical printouts, from 2 (binary) to 16 (hexadecimal)
 	manip_set_base,
+	/// Set the width to which the next decimal number is padded
+	manip_set_width,
+	/// Set the character with which decimal numbers are padded to the width
+	manip_set_fill,
 	/** \cond NO_DOXY Specifies that the following string is in program (flash)
 	 *  memory.  This modifier is not used directly by user-written programs
 	 */
@@ -212,6 +218,21 @@ ser_manipulator setprecision (uint8_t);
 // Function to set the base for subsequent conversions of numbers to strings by "<<"
 ser_manipulator setbase (uint8_t new_base);
 
+// Function to set the width to which the next decimal number is padded
+ser_manipulator setw (uint8_t new_width);
+
+// Function to set the character with which decimal numbers are padded
+ser_manipulator setfill (char new_fill);
+
+/** @brief   The widest field to which @c setw() can pad a number.
+ *  @details A number and its padding are put together in a buffer on the stack, so
+ *           that they can be written in one block; the buffer is this size plus one.
+ */
+#define EMSTREAM_MAX_WIDTH		20
+
+// Convert an unsigned number to decimal digits without dividing
+uint8_t utoa_dec (uint32_t num, char* p_buffer);
+
 
 //-------------------------------------------------------------------------------------
 /** \brief This is a base class for serial devices which use an overloaded left shift 
@@ -288,6 +309,17 @@ class emstream
 		 *  floating point number is being converted to text. */
 		char precision;
 
+		/** This is the number of characters to which the next decimal number is
+		 *  padded; it's set by @c setw() and goes back to zero once it's used. */
+		uint8_t width;
+
+		/** This is the character with which decimal numbers are padded to the width
+		 *  set by @c setw(); it's a space unless @c setfill() changes it. */
+		char fill;
+
+		// Print a number in decimal, with its sign and padding, in one block
+		void put_decimal (uint32_t magnitude, bool negative);
+
 	// Public methods can be called from anywhere in the program where there is a 
 	// pointer or reference to an object of this class
 	public:
@@ -307,6 +339,9 @@ class emstream
 
 		void puts (const char*);            // Write a string to the serial device
 
+		// Write a block of characters, which need not end with a null character
+		virtual void write (const char* p_data, size_t length);
+
 		virtual bool check_for_char (void); // Check if a character is in the buffer
 		virtual char getchar (void);        // Get a character; wait if none is ready
 		virtual void transmit_now (void);   // Immediately transmit any buffered data
@@ -0,0 +1,162 @@
+//*************************************************************************************
+/** \file emstream_decimal.cpp
+ *    This file contains the function which converts integers to decimal text for the
+ *    @c emstream class without dividing, and the method which prints them with their
+ *    signs and padding.
+ *
+ *    The C library's @c ltoa() and @c ultoa() find each digit by dividing by ten, and
+ *    an AVR has no divide instruction, so each 32-bit division is a loop of hundreds
+ *    of cycles. Here each digit is found instead by subtracting its power of ten for
+ *    as long as the number is no smaller than it, which takes at most nine compares
+ *    and subtractions per digit. Once the number is below 10000, the rest is done
+ *    with 16-bit arithmetic. Every power of ten is a constant in the code rather than
+ *    an entry in a table, so no RAM is used for them.
+ *
+ *  Revised:
+ *    \li 10-17-2026 ME405 Group 3 Original file
+ *
+ *  License:
+ *    This file released under the Lesser GNU Public License, version 2. This program
+ *    is intended for educational use only, but it is not limited thereto. This code
+ *    incorporates elements from Xmelkov's ftoa_engine.h, part of the avr-libc source,
+ *    and users must accept and comply with the license of ftoa_engine.h as well. See
+ *    emstream.h for a copy of the relevant license terms. */
+/*    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUEN-
+ *    TIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ *    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+//*************************************************************************************
+
+#include "emstream.h"
+
+
+//-------------------------------------------------------------------------------------
+/** This function finds one decimal digit of a 32-bit number by subtracting a power of
+ *  ten from it until it's smaller than that power.
+ *  @param num The number, from which the digit's worth is taken away
+ *  @param power The power of ten whose digit is found
+ *  @return The digit, as an ASCII character
+ */
+
+static inline char dec_digit_32 (uint32_t& num, uint32_t power)
+{
+	char digit = '0';
+	while (num >= power)
+	{
+		num -= power;
+		digit++;
+	}
+	return (digit);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** This function finds one decimal digit of a number below 10000 in the same way as
+ *  \c dec_digit_32(), using 16-bit arithmetic.
+ *  @param num The number, from which the digit's worth is taken away
+ *  @param power The power of ten whose digit is found
+ *  @return The digit, as an ASCII character
+ */
+
+static inline char dec_digit_16 (uint16_t& num, uint16_t power)
+{
+	char digit = '0';
+	while (num >= power)
+	{
+		num -= power;
+		digit++;
+	}
+	return (digit);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** This function converts an unsigned number to decimal digits, without leading
+ *  zeros, using subtraction rather than division. The digits are followed by a null
+ *  character, so the buffer must have room for 11 characters.
+ *  @param num The number to be converted
+ *  @param p_buffer A pointer to the buffer into which the digits are written
+ *  @return The number of digits, not counting the null character
+ */
+
+uint8_t utoa_dec (uint32_t num, char* p_buffer)
+{
+	char* p_char = p_buffer;
+
+	// Digits above the thousands need 32-bit arithmetic. A leading zero is written
+	// over by the next digit, as p_char only moves on once a digit isn't zero
+	if (num >= 10000UL)
+	{
+		*p_char = dec_digit_32 (num, 1000000000UL);
+		p_char += (*p_char != '0');
+		*p_char = dec_digit_32 (num, 100000000UL);
+		p_char += (p_char != p_buffer || *p_char != '0');
+		*p_char = dec_digit_32 (num, 10000000UL);
+		p_char += (p_char != p_buffer || *p_char != '0');
+		*p_char = dec_digit_32 (num, 1000000UL);
+		p_char += (p_char != p_buffer || *p_char != '0');
+		*p_char = dec_digit_32 (num, 100000UL);
+		p_char += (p_char != p_buffer || *p_char != '0');
+		*p_char++ = dec_digit_32 (num, 10000UL);
+	}
+
+	// The rest is below 10000, so 16-bit arithmetic will do
+	uint16_t small = (uint16_t)num;
+	*p_char = dec_digit_16 (small, 1000);
+	p_char += (p_char != p_buffer || *p_char != '0');
+	*p_char = dec_digit_16 (small, 100);
+	p_char += (p_char != p_buffer || *p_char != '0');
+	*p_char = dec_digit_16 (small, 10);
+	p_char += (p_char != p_buffer || *p_char != '0');
+	*p_char++ = '0' + (char)small;
+	*p_char = '\0';
+
+	return (p_char - p_buffer);
+}
+
+
+//-------------------------------------------------------------------------------------
+/** This method prints a number in decimal, with a minus sign if it's negative, padded
+ *  on the left to the width set by \c setw(), then sets the width back to zero. The
+ *  whole field is put together on the stack and sent with one call to \c write().
+ *  @param magnitude The size of the number, without its sign
+ *  @param negative True if a minus sign is to be printed
+ */
+
+void emstream::put_decimal (uint32_t magnitude, bool negative)
+{
+	char digits[11];                        // The digits, from utoa_dec()
+	char out_str[EMSTREAM_MAX_WIDTH + 1];   // The sign, padding and digits
+	uint8_t length = utoa_dec (magnitude, digits);
+	uint8_t size = length + negative;
+	uint8_t pad = (width > size) ? width - size : 0;
+	char* p_char = out_str;
+
+	width = 0;
+
+	// Zeros go between the sign and the digits; anything else goes before the sign
+	if (negative && fill == '0')
+	{
+		*p_char++ = '-';
+	}
+	for ( ; pad > 0; pad--)
+	{
+		*p_char++ = fill;
+	}
+	if (negative && fill != '0')
+	{
+		*p_char++ = '-';
+	}
+	for (uint8_t index = 0; index < length; index++)
+	{
+		*p_char++ = digits[index];
+	}
+
+	write (out_str, p_char - out_str);
+}
@@ -6,6 +6,7 @@
  *  Revised:
  *    \li 12-02-2012 JRR Split this file off from the main \c emstream.cpp to
  *                       allow smaller machine code if stuff in this file isn't used
+ *    \li 10-17-2026 ME405 Group 3 Decimal numbers go through put_decimal(), without dividing
  *
  *  License:
  *    This file released under the Lesser GNU Public License, version 2. This program
@@ -45,10 +46,7 @@ emstream& emstream::operator<< (int16_t num)
 	}
 	else
 	{
-		char out_str[17];
-
-		itoa (num, out_str, base);
-		puts (out_str);
+		put_decimal ((num < 0) ? -(int32_t)num : num, num < 0);
 	}
 
 	return (*this);
@@ -6,6 +6,7 @@
  *  Revised:
  *    \li 12-02-2012 JRR Split this file off from the main \c emstream.cpp to
  *                       allow smaller machine code if stuff in this file isn't used
+ *    \li 10-17-2026 ME405 Group 3 Decimal numbers go through put_decimal(), without dividing
  *
  *  License:
  *    This file released under the Lesser GNU Public License, version 2. This program
@@ -41,8 +42,6 @@
 
 emstream& emstream::operator<< (int8_t num)
 {
-	char out_str[5];
-
 	if (print_ascii)
 	{
 		putchar (num);
@@ -51,8 +50,7 @@ emstream& emstream::operator<< (int8_t num)
 	{
 		if (base == 10)
 		{
-			itoa ((int)num, out_str, 10);
-			puts (out_str);
+			put_decimal ((num < 0) ? -(int16_t)num : num, num < 0);
 		}
 		else
 		{
@@ -6,6 +6,7 @@
  *  Revised:
  *    \li 12-02-2012 JRR Split this file off from the main \c emstream.cpp to
  *                       allow smaller machine code if stuff in this file isn't used
+ *    \li 10-17-2026 ME405 Group 3 Decimal numbers go through put_decimal(), without dividing
  *
  *  License:
  *    This file released under the Lesser GNU Public License, version 2. This program
@@ -49,6 +50,10 @@ emstream& emstream::operator<< (uint16_t num)
 		parts.whole = num;
 		*this << parts.bits[1] << parts.bits[0];
 	}
+	else if (base == 10)
+	{
+		put_decimal (num, false);
+	}
 	else
 	{
 		char out_str[17];
@@ -23,6 +23,10 @@
  *    \li 07-05-2008 JRR Changed from 1 to 2 stop bits to placate finicky receivers
  *    \li 12-22-2008 JRR Split off stuff in base232.h for efficiency
  *    \li 06-30-2009 JRR Received data interrupt and buffer added
+ *    \li 10-17-2026 ME405 Group 3 Transmit buffer emptied by the data register empty
+ *        interrupt, so putchar() doesn't wait for the port
+ *    \li 10-17-2026 ME405 Group 3 Buffer slots claimed with interrupts off; a full
+ *        buffer is waited for with vTaskDelay(); added transmit_now()
  *
  *  License:
  *		This file is copyright 2012 by JR Ridgely and released under the Lesser GNU 
@@ -43,6 +47,9 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include "FreeRTOS.h"
+#include "task.h"
 #include "rs232int.h"
 
 
@@ -68,6 +75,26 @@ uint16_t rcv0_write_index;
 	uint16_t rcv1_write_index;
 #endif
 
+/// This buffer holds characters waiting to be sent through serial port 0 by the ISR.
+uint8_t* tx0_buffer = NULL;
+
+/// This index is used by the ISR to read from serial transmitter buffer 0.
+volatile uint8_t tx0_read_index;
+
+/// This index is used to write into serial transmitter buffer 0.
+volatile uint8_t tx0_write_index;
+
+#ifdef UCSR1A
+	/// This buffer holds characters waiting to be sent through serial port 1 by the ISR.
+	uint8_t* tx1_buffer = NULL;
+
+	/// This index is used by the ISR to read from serial transmitter buffer 1.
+	volatile uint8_t tx1_read_index;
+
+	/// This index is used to write into serial transmitter buffer 1.
+	volatile uint8_t tx1_write_index;
+#endif
+
 
 //-------------------------------------------------------------------------------------
 /** This method sets up the AVR UART for communications.  It calls the emstream
@@ -87,6 +114,8 @@ rs232::rs232 (uint16_t baud_rate, uint8_t port_number)
 {
 	// Save the number of the serial port, 0 or 1
 	port_num = port_number;
+	tx_full_policy = RSINT_TX_FULL_POLICY;
+	tx_lost = 0;
 
 	// If we're compiling for a chip with UCSR0A defined, it has dual serial ports
 	// (examples are ATmega324P and ATmega128). Set up Port 0 or Port 1
@@ -99,6 +128,16 @@ rs232::rs232 (uint16_t baud_rate, uint8_t port_number)
 			rcv0_buffer = new uint8_t[RSINT_BUF_SIZE];
 			rcv0_read_index = 0;
 			rcv0_write_index = 0;
+
+			// The transmitter buffer is emptied by an interrupt which is only enabled
+			// while there are characters in the buffer
+			tx0_buffer = new uint8_t[RSINT_TX_BUF_SIZE];
+			tx0_read_index = 0;
+			tx0_write_index = 0;
+			p_tx_buffer = tx0_buffer;
+			p_tx_read_index = &tx0_read_index;
+			p_tx_write_index = &tx0_write_index;
+			mask_UDRIE = (1 << UDRIE0);
 		}
 		else  // Serial port number 1
 		{
@@ -109,6 +148,14 @@ rs232::rs232 (uint16_t baud_rate, uint8_t port_number)
 			rcv1_buffer = new uint8_t[RSINT_BUF_SIZE];
 			rcv1_read_index = 0;
 			rcv1_write_index = 0;
+
+			tx1_buffer = new uint8_t[RSINT_TX_BUF_SIZE];
+			tx1_read_index = 0;
+			tx1_write_index = 0;
+			p_tx_buffer = tx1_buffer;
+			p_tx_read_index = &tx1_read_index;
+			p_tx_write_index = &tx1_write_index;
+			mask_UDRIE = (1 << UDRIE1);
 		#endif // UCSR1A
 		}
 	// We're compiling for a chip which doesn't define UCSR0A; assume it has only one
@@ -120,6 +167,14 @@ rs232::rs232 (uint16_t baud_rate, uint8_t port_number)
 		rcv0_buffer = new uint8_t[RSINT_BUF_SIZE];
 		rcv0_read_index = 0;
 		rcv0_write_index = 0;
+
+		tx0_buffer = new uint8_t[RSINT_TX_BUF_SIZE];
+		tx0_read_index = 0;
+		tx0_write_index = 0;
+		p_tx_buffer = tx0_buffer;
+		p_tx_read_index = &tx0_read_index;
+		p_tx_write_index = &tx0_write_index;
+		mask_UDRIE = (1 << UDRIE);
 	#endif
 
 	// The Xiphos 1.0 board may need the pullup activated on the RXD1 line in order to
@@ -132,36 +187,138 @@ rs232::rs232 (uint16_t baud_rate, uint8_t port_number)
 
 
 //-------------------------------------------------------------------------------------
-/** This method sends one character to the serial port.  It waits until the port is
- *  ready, so it can hold up the system for a while.  It times out if it waits too 
- *  long to send the character; you can check the return value to see if the character
- *  was successfully sent, or just cross your fingers and ignore the return value.
- *  Note 1:  It's possible that at slower baud rates and/or higher processor speeds, 
- *  this routine might time out even when the port is working fine.  A solution would
- *  be to change the count variable to an integer and use a larger starting number. 
- *  Note 2:  Fixed!  The count is now an integer and it works at lower baud rates.
+/** This method puts one character into the transmitter buffer, from which the data
+ *  register empty interrupt sends it. Unless the buffer is full it returns at once. 
+ *  The slot for the character is claimed with interrupts turned off, so two tasks 
+ *  printing to the same port can't both put a character into the same slot. 
+ *  When the buffer is full, what happens depends on the port's policy, which is set
+ *  with \c set_tx_full_policy(): the character is dropped, the oldest character in 
+ *  the buffer is overwritten, or this method waits for the interrupt to make room. 
+ *  While it waits it calls \c vTaskDelay() if the scheduler is running, so that tasks
+ *  of lower priority aren't starved. If interrupts are turned off, the interrupt 
+ *  can't make room, so the oldest character is sent from here instead, in the way 
+ *  characters were sent before there was a buffer; it times out if the port doesn't 
+ *  become ready. 
  *  @param chout The character to be sent out
- *  @return True if everything was OK and false if there was a timeout
  */
 
 void rs232::putchar (char chout)
 {
-	// Now wait for the serial port transmitter buffer to be empty	 
-	for (uint16_t count = 0; ((*p_USR & mask_UDRE) == 0); count++)
+	for (;;)
 	{
-		if (count > UART_TX_TOUT)
+		uint8_t sreg = SREG;
+		cli ();
+
+		// The buffer is full when putting in another character would make the indices
+		// equal, as that's how an empty buffer looks
+		uint8_t write_index = *p_tx_write_index;
+		uint8_t next_index = write_index + 1;
+		if (next_index >= RSINT_TX_BUF_SIZE)
+			next_index = 0;
+
+		// If there's room, put the character in the buffer and make sure the interrupt
+		// is on to send it
+		if (next_index != *p_tx_read_index)
+		{
+			p_tx_buffer[write_index] = chout;
+			*p_tx_write_index = next_index;
+			*p_UCR |= mask_UDRIE;
+			SREG = sreg;
+			return;
+		}
+
+		if (tx_full_policy == RSINT_TX_DROP)
 		{
+			tx_lost++;
+			SREG = sreg;
 			return;
 		}
+		else if (tx_full_policy == RSINT_TX_OVERWRITE)
+		{
+			// Interrupts are off, so the ISR can't move the read index meanwhile
+			uint8_t read_index = *p_tx_read_index + 1;
+			*p_tx_read_index = (read_index >= RSINT_TX_BUF_SIZE) ? 0 : read_index;
+			tx_lost++;
+			SREG = sreg;
+		}
+		else if ((sreg & (1 << SREG_I)) == 0)
+		{
+			// Nothing will empty the buffer while interrupts are off, so send the oldest
+			// character here once the transmitter is ready
+			if (!send_oldest ())
+			{
+				tx_lost++;
+				return;
+			}
+		}
+		else
+		{
+			// Let the interrupt make room; other tasks run in the meantime if they can
+			SREG = sreg;
+			if (xTaskGetSchedulerState () == taskSCHEDULER_RUNNING)
+			{
+				vTaskDelay (1);
+			}
+		}
 	}
+}
 
-	// Clear the TXCn bit so it can be used to check if the serial port is busy.  This
-	// check needs to be done prior to putting the processor into sleep mode.  Oddly,
-	// the TXCn bit is cleared by writing a one to its bit location
+
+//-------------------------------------------------------------------------------------
+/** This method sends the oldest character in the transmitter buffer by polling the
+ *  port, once the transmitter is ready for it. It must only be called with interrupts
+ *  turned off and with at least one character in the buffer. 
+ *  @return True if the character was sent, false if the port didn't become ready
+ */
+
+bool rs232::send_oldest (void)
+{
+	for (uint16_t count = 0; ((*p_USR & mask_UDRE) == 0); count++)
+	{
+		if (count > UART_TX_TOUT)
+		{
+			return (false);
+		}
+	}
 	*p_USR |= mask_TXC;
+	*p_UDR = p_tx_buffer[*p_tx_read_index];
+	uint8_t read_index = *p_tx_read_index + 1;
+	*p_tx_read_index = (read_index >= RSINT_TX_BUF_SIZE) ? 0 : read_index;
+
+	return (true);
+}
+
 
-	// The CTS line is 0 and the transmitter buffer is empty, so send the character
-	*p_UDR = chout;
+//-------------------------------------------------------------------------------------
+/** This method sends everything in the transmitter buffer before it returns. If
+ *  interrupts are on, it waits for the interrupt to empty the buffer; if they're off,
+ *  as in a program which prints before it goes to sleep with interrupts off, it sends 
+ *  the characters itself by polling the port. Either way it then waits until the last
+ *  character has left the transmitter, so the processor can be put to sleep. It's 
+ *  called when \c send_now is inserted in a line of "<<" stuff. 
+ */
+
+void rs232::transmit_now (void)
+{
+	while (*p_tx_read_index != *p_tx_write_index)
+	{
+		if (SREG & (1 << SREG_I))
+		{
+			if (xTaskGetSchedulerState () == taskSCHEDULER_RUNNING)
+			{
+				vTaskDelay (1);
+			}
+		}
+		else if (!send_oldest ())
+		{
+			// The port isn't working, so the characters are thrown away
+			tx_lost += (uint8_t)(*p_tx_write_index - *p_tx_read_index) % RSINT_TX_BUF_SIZE;
+			*p_tx_read_index = *p_tx_write_index;
+			return;
+		}
+	}
+
+	for (uint16_t count = 0; is_sending () && count <= UART_TX_TOUT; count++);
 }
 
 
@@ -267,6 +424,39 @@ ISR (RSI_CHAR_RECV_INT_0)
 }
 
 
+//-------------------------------------------------------------------------------------
+/** This interrupt service routine runs whenever serial port 0 is ready for another
+ *  character to be sent and its data register empty interrupt is enabled. It sends
+ *  the oldest character in the transmitter buffer, and turns the interrupt off when
+ *  the buffer is empty. The TXC bit is cleared, as \c putchar() used to clear it, so
+ *  that \c is_sending() still works.
+ */
+
+ISR (RSI_DATA_EMPTY_INT_0)
+{
+	#if defined UCSR0A
+		if (tx0_read_index == tx0_write_index)
+		{
+			UCSR0B &= ~(1 << UDRIE0);
+			return;
+		}
+		UCSR0A |= (1 << TXC0);
+		UDR0 = tx0_buffer[tx0_read_index];
+	#else
+		if (tx0_read_index == tx0_write_index)
+		{
+			UCSRB &= ~(1 << UDRIE);
+			return;
+		}
+		UCSRA |= (1 << TXC);
+		UDR = tx0_buffer[tx0_read_index];
+	#endif
+
+	uint8_t read_index = tx0_read_index + 1;
+	tx0_read_index = (read_index >= RSINT_TX_BUF_SIZE) ? 0 : read_index;
+}
+
+
 #ifdef UCSR1A // The second ISR is only compiled for processors with dual serial ports
 	//-------------------------------------------------------------------------------------
 	/** This interrupt service routine runs whenever a character has been received by the
@@ -289,5 +479,25 @@ ISR (RSI_CHAR_RECV_INT_0)
 			if (++rcv1_read_index >= RSINT_BUF_SIZE)
 				rcv1_read_index = 0;
 	}
+
+
+	//-------------------------------------------------------------------------------------
+	/** This interrupt service routine sends the oldest character in the transmitter 
+	*  buffer of serial port 1, and turns itself off when the buffer is empty.
+	*/
+
+	ISR (RSI_DATA_EMPTY_INT_1)
+	{
+		if (tx1_read_index == tx1_write_index)
+		{
+			UCSR1B &= ~(1 << UDRIE1);
+			return;
+		}
+		UCSR1A |= (1 << TXC1);
+		UDR1 = tx1_buffer[tx1_read_index];
+
+		uint8_t read_index = tx1_read_index + 1;
+		tx1_read_index = (read_index >= RSINT_TX_BUF_SIZE) ? 0 : read_index;
+	}
 #endif // Dual serial ports
 /** \endcond  (End of section which is not to be documented by Doxygen) */
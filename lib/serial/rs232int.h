@@ -23,6 +23,9 @@
  *    \li 07-05-2008 JRR Changed from 1 to 2 stop bits to placate finicky receivers
  *    \li 12-22-2008 JRR Split off stuff in base232.h for efficiency
  *    \li 06-30-2009 JRR Received data interrupt and buffer added
+ *    \li 10-17-2026 ME405 Group 3 Transmit buffer emptied by the data register empty
+ *        interrupt, so putchar() doesn't wait for the port
+ *    \li 10-17-2026 ME405 Group 3 Added transmit_now(), which empties the buffer
  *
  *  License:
  *		This file is copyright 2012 by JR Ridgely and released under the Lesser GNU 
@@ -73,6 +76,21 @@
 	#endif
 #endif
 
+// In the same way, define the transmitter data register empty interrupts
+#if defined USART_UDRE_vect
+	#define RSI_DATA_EMPTY_INT_0 USART_UDRE_vect
+#elif defined USART0_UDRE_vect
+	#define RSI_DATA_EMPTY_INT_0 USART0_UDRE_vect
+#else
+	#error Unable to determine data register empty interrupt vector for this chip
+#endif
+
+#if defined UCSR1A
+	#if defined USART1_UDRE_vect
+		#define RSI_DATA_EMPTY_INT_1 USART1_UDRE_vect
+	#endif
+#endif
+
 /** This is the size of the buffer which holds characters received by the serial port.
  *  It is usually set to something fairly large (~100 bytes) so that we don't miss
  *  incoming characters. However, when run on an AVR with very little RAM such as an
@@ -81,6 +99,30 @@
  */
 #define RSINT_BUF_SIZE		32
 
+/** This is the size of the buffer which holds characters waiting to be sent by the 
+ *  serial port. Characters written with \c putchar() go into this buffer and are sent 
+ *  by an interrupt as fast as the port can take them, so a task which prints a line 
+ *  that fits in the buffer doesn't wait for the port at all. It must be no bigger than
+ *  256, as the buffer's indices are bytes, so the interrupt can read them in one go. 
+ */
+#define RSINT_TX_BUF_SIZE	64
+
+/// When the transmit buffer is full, a new character is thrown away
+#define RSINT_TX_DROP		0
+
+/// When the transmit buffer is full, \c putchar() waits until there's room
+#define RSINT_TX_BLOCK		1
+
+/// When the transmit buffer is full, the oldest unsent character is thrown away
+#define RSINT_TX_OVERWRITE	2
+
+/** This is what \c putchar() does when the transmit buffer is full, unless a port is 
+ *  given another policy with \c set_tx_full_policy(). Waiting keeps every character, 
+ *  as the port did when it had no buffer; dropping or overwriting never holds up the
+ *  task which prints, which suits a port used for data logging by a busy task. 
+ */
+#define RSINT_TX_FULL_POLICY	RSINT_TX_BLOCK
+
 
 //-------------------------------------------------------------------------------------
 /** \brief This class controls a UART (Universal Asynchronous Receiver Transmitter), 
@@ -97,8 +139,18 @@
  *  are placed in a buffer whose size is configurable with the macro \c RSINT_BUF_SIZE.
  *  Calls to \c getchar() will check the buffer for received characters. This method,
  *  as opposed to polling the receiver without using interrupts, allows much higher
- *  data rates to be reliably supported in a multitasking program. Sending of 
- *  characters is currently not interrupt based. 
+ *  data rates to be reliably supported in a multitasking program. 
+ * 
+ *  Characters to be sent are put by \c putchar() into a buffer whose size is set by
+ *  \c RSINT_TX_BUF_SIZE, and the transmitter's data register empty interrupt sends
+ *  them one at a time. What happens when the buffer is full is set for each port by
+ *  \c set_tx_full_policy(): the new character can be dropped, the oldest one can be
+ *  overwritten, or \c putchar() can wait for room. If interrupts are turned off, as 
+ *  they are in a critical section or before the RTOS scheduler starts, a waiting
+ *  \c putchar() sends the oldest characters itself so that it can't wait for ever. 
+ *  A program which stops with interrupts off, such as the benchmark, must call 
+ *  \c transmit_now() (or insert \c send_now) first, or the last characters in the
+ *  buffer are never sent. 
  * 
  *  \section Usage
  *  To create and use a serial port driver object requires only code such as the
@@ -121,6 +173,27 @@ class rs232 : public emstream, public base232
 	protected:
 		uint8_t port_num;					///< The USART number, 0 or 1
 
+		/// The buffer of characters waiting to be sent, shared with the interrupt
+		uint8_t* p_tx_buffer;
+
+		/// The index of the next character which the interrupt will send
+		volatile uint8_t* p_tx_read_index;
+
+		/// The index at which the next character to be sent will be put
+		volatile uint8_t* p_tx_write_index;
+
+		/// The bit which enables the data register empty interrupt
+		uint8_t mask_UDRIE;
+
+		/// What \c putchar() does when the buffer is full, such as \c RSINT_TX_DROP
+		uint8_t tx_full_policy;
+
+		/// The number of characters dropped or overwritten because the buffer was full
+		uint16_t tx_lost;
+
+		// Send the oldest character in the transmitter buffer by polling the port
+		bool send_oldest (void);
+
 	// Public methods can be called from anywhere in the program where there is a 
 	// pointer or reference to an object of this class
 	public:
@@ -130,6 +203,26 @@ class rs232 : public emstream, public base232
 		// This method writes one character to the serial port.
 		void putchar (char);
 
+		// Send everything in the transmitter buffer before returning
+		void transmit_now (void);
+
+		/** This method sets what \c putchar() does when the transmit buffer is full.
+		 *  @param policy \c RSINT_TX_DROP, \c RSINT_TX_BLOCK or \c RSINT_TX_OVERWRITE
+		 */
+		void set_tx_full_policy (uint8_t policy)
+		{
+			tx_full_policy = policy;
+		}
+
+		/** This method gets the number of characters which have been dropped or 
+		 *  overwritten because the transmit buffer was full.
+		 *  @return The number of characters lost
+		 */
+		uint16_t get_tx_lost (void)
+		{
+			return (tx_lost);
+		}
+
 		bool check_for_char (void);         // Check if a character is in the buffer
 		char getchar (void);                // Get a character; wait if none is ready
 		void clear_screen (void);           // Send the 'clear display screen' code